@@ -0,0 +1,468 @@
+/** ****************************************************************
+ *  Implementation of the AdjacencyIndex class                     *
+ *  @author Brandon Dale                                           *
+ *                                                                 *
+ *  Builds the compressed sparse row (CSR) index of the follow     *
+ *  relationships, and answers "does A follow B" queries with a    *
+ *  binary search on A's sorted row.                               *
+ *                                                                 *
+ *  @file AdjacencyIndex.cpp                                       *
+ *  @date October 14th, 2026                                       *
+ ******************************************************************/
+
+
+#include "AdjacencyIndex.h"
+#include <cassert>
+#include <algorithm>
+
+using namespace std;
+
+
+// -------------------------------------------------- CONSTRUCTORS -------------------------------------------------- //
+
+AdjacencyIndex::AdjacencyIndex() {
+    /*
+     *  The default constructor of an AdjacencyIndex object. Creates an index with no vertices.
+     *  The offsets array always holds numVertices + 1 entries, so it holds a single 0 here.
+     *
+     *  Parameters:
+     *      Takes no parameters
+     *
+     *  Returns:
+     *      No return value, creates an AdjacencyIndex object
+     */
+
+    numVertices = 0;
+    adoptArrays(vector<size_t>(1, 0), vector<unsigned int>());
+}
+
+AdjacencyIndex::AdjacencyIndex(const vector<User>& users) {
+    /*
+     *  Creates the forward (follows) index of a social network from the follows list of every user.
+     *
+     *  Row i of the index holds the 0-based indices of every user that the user with ID (i + 1) follows. Each row is
+     *  sorted and de-duplicated, which allows hasEdge to use a binary search. Rows are built one at a time directly
+     *  into the single targets array, so no per-user temporary vectors are created.
+     *
+     *  Makes the following assumptions:
+     *      1) The users vector is sorted by ID, and the IDs are exactly 1 -> users.size()
+     *      2) Every followed ID is a valid ID (between 1 and users.size())
+     *
+     *  Parameters:
+     *      const vector<User>& users:
+     *          The users of the social network, sorted by ID
+     *
+     *  Returns:
+     *      No return value, creates an AdjacencyIndex object
+     */
+
+    numVertices = users.size();
+
+    // Reserve both arrays so that resizing does not occur during their creation
+    size_t totalFollows = 0;
+    for (const User& user : users) totalFollows += user.getFollowsSize();
+    vector<size_t> rowOffsets;
+    vector<unsigned int> rowTargets;
+    rowTargets.reserve(totalFollows);
+    rowOffsets.reserve(numVertices + 1);
+    rowOffsets.push_back(0);
+
+    for (unsigned int i = 0; i < numVertices; i++) {
+        const User& curUser = users[i];
+        size_t rowStart = rowTargets.size();
+
+        // Add the 0-based index of each followed user to the end of the targets array
+        for (unsigned int followedID : curUser.getFollows()) {
+            assert(followedID > 0 && followedID <= numVertices);
+            rowTargets.push_back(followedID - 1);
+        }
+
+        // Sort the new row and remove any duplicate follows
+        sort(rowTargets.begin() + rowStart, rowTargets.end());
+        rowTargets.erase(unique(rowTargets.begin() + rowStart, rowTargets.end()), rowTargets.end());
+
+        rowOffsets.push_back(rowTargets.size());
+    }
+
+    adoptArrays(move(rowOffsets), move(rowTargets));
+}
+
+AdjacencyIndex::AdjacencyIndex(unsigned int numVertices, vector<size_t> offsets, vector<unsigned int> targets) {
+    /*
+     *  Creates an index from existing CSR arrays, such as ones that were saved to a file.
+     *
+     *  Parameters:
+     *      unsigned int numVertices:
+     *          The number of vertices (rows) in the index
+     *
+     *      vector<size_t> offsets:
+     *          The numVertices + 1 row offsets. The first offset must be 0 and the last must be targets.size().
+     *
+     *      vector<unsigned int> targets:
+     *          The neighbors of every row, stored back to back. Each row must be sorted and de-duplicated.
+     *
+     *  Returns:
+     *      No return value, creates an AdjacencyIndex object
+     */
+
+    assert(offsets.size() == static_cast<size_t>(numVertices) + 1);
+    assert(offsets.front() == 0 && offsets.back() == targets.size());
+
+    this->numVertices = numVertices;
+    adoptArrays(move(offsets), move(targets));
+}
+
+AdjacencyIndex::AdjacencyIndex(unsigned int numVertices, size_t numEdges, const size_t* offsets,
+                               const unsigned int* targets, shared_ptr<const void> storage) {
+    /*
+     *  Creates an index that views CSR arrays owned by something else, such as a memory mapped snapshot file. Nothing
+     *  is copied, so creating the index is O(1).
+     *
+     *  Parameters:
+     *      unsigned int numVertices:
+     *          The number of vertices (rows) in the index
+     *
+     *      size_t numEdges:
+     *          The number of edges (targets) in the index
+     *
+     *      const size_t* offsets:
+     *          The numVertices + 1 row offsets. The first offset must be 0 and the last must be numEdges.
+     *
+     *      const unsigned int* targets:
+     *          The neighbors of every row, stored back to back. Each row must be sorted and de-duplicated.
+     *
+     *      shared_ptr<const void> storage:
+     *          The owner of the memory that offsets and targets point into. It is kept alive by every copy of the index.
+     *
+     *  Returns:
+     *      No return value, creates an AdjacencyIndex object
+     */
+
+    assert(offsets[0] == 0 && offsets[numVertices] == numEdges);
+
+    this->numVertices = numVertices;
+    this->numEdges = numEdges;
+    this->offsets = offsets;
+    this->targets = targets;
+    this->storage = move(storage);
+}
+
+
+// ------------------------------------------------ PUBLIC METHODS -------------------------------------------------- //
+
+AdjacencyIndex AdjacencyIndex::transposed() const {
+    /*
+     *  Returns the reverse index, where row v holds every vertex that has an edge to v.
+     *
+     *  Uses a counting sort: the first pass counts the in-degree of every vertex, which gives the row offsets, and the
+     *  second pass scatters every edge into its row. Since the source rows are visited in increasing order, every row of
+     *  the reverse index is already sorted and de-duplicated.
+     *
+     *  Parameters:
+     *      Takes no parameters.
+     *
+     *  Returns:
+     *      AdjacencyIndex:
+     *          The transpose of the current index
+     */
+
+    vector<size_t> reverseOffsets(numVertices + 1, 0);
+    vector<unsigned int> reverseTargets(numEdges);
+
+    // Count the number of edges going into each vertex
+    for (size_t e = 0; e < numEdges; e++) {
+        reverseOffsets[targets[e] + 1]++;
+    }
+    for (unsigned int v = 0; v < numVertices; v++) {
+        reverseOffsets[v + 1] += reverseOffsets[v];
+    }
+
+    // Place each edge in the row of its target, using a moving insert position for each row
+    vector<size_t> insertPos(reverseOffsets.begin(), reverseOffsets.end() - 1);
+    for (unsigned int from = 0; from < numVertices; from++) {
+        for (size_t e = offsets[from]; e < offsets[from + 1]; e++) {
+            reverseTargets[insertPos[targets[e]]++] = from;
+        }
+    }
+
+    return AdjacencyIndex(numVertices, move(reverseOffsets), move(reverseTargets));
+}
+
+AdjacencyIndex AdjacencyIndex::relabeled(const vector<unsigned int>& newIndices) const {
+    /*
+     *  Returns a copy of the index where every vertex is renumbered, so row newIndices[v] holds the renumbered
+     *  neighbors of vertex v (sorted again, as the new numbers are in a different order)
+     *  ASSERTS that there is a new number for every vertex
+     *
+     *  Parameters:
+     *      const vector<unsigned int>& newIndices:
+     *          The new number of every vertex, which must be a permutation of 0 to numVertices - 1
+     *
+     *  Returns:
+     *      AdjacencyIndex:
+     *          The renumbered index
+     */
+
+    assert(newIndices.size() == numVertices);
+    vector<size_t> newOffsets(numVertices + 1, 0);
+    for (unsigned int v = 0; v < numVertices; v++) {
+        newOffsets[newIndices[v] + 1] = offsets[v + 1] - offsets[v];
+    }
+    for (unsigned int v = 0; v < numVertices; v++) {
+        newOffsets[v + 1] += newOffsets[v];
+    }
+
+    vector<unsigned int> newTargets(numEdges);
+    for (unsigned int v = 0; v < numVertices; v++) {
+        unsigned int* row = newTargets.data() + newOffsets[newIndices[v]];
+        unsigned int* rowEnd = row;
+        for (size_t e = offsets[v]; e < offsets[v + 1]; e++) *rowEnd++ = newIndices[targets[e]];
+        sort(row, rowEnd);
+    }
+
+    return AdjacencyIndex(numVertices, move(newOffsets), move(newTargets));
+}
+
+AdjacencyIndex AdjacencyIndex::withEdgeChanges(unsigned int newNumVertices,
+                                               const vector<pair<unsigned int, unsigned int>>& added,
+                                               const vector<pair<unsigned int, unsigned int>>& removed) const {
+    /*
+     *  Returns a copy of the index with a batch of edges inserted and deleted (and, optionally, more vertices, whose
+     *  rows start out empty).
+     *
+     *  The new offsets are found with one pass over the rows. Then every run of rows without changes is copied with a
+     *  single copy, and each changed row is merged with its added edges (skipping its removed ones), so every row stays
+     *  sorted. So a batch of k changes costs O(numVertices + k) plus one copy of the edges, rather than rebuilding the
+     *  index from the follows lists of every user.
+     *  ASSERTS that the index does not shrink, and that the changes are sorted and valid (see below)
+     *
+     *  Parameters:
+     *      unsigned int newNumVertices:
+     *          The number of vertices in the new index, no fewer than in this index
+     *
+     *      const vector<pair<unsigned int, unsigned int>>& added:
+     *          The (from, to) edges to insert, sorted, none of which are in this index
+     *
+     *      const vector<pair<unsigned int, unsigned int>>& removed:
+     *          The (from, to) edges to delete, sorted, all of which are in this index
+     *
+     *  Returns:
+     *      AdjacencyIndex:
+     *          The index with the changes applied
+     */
+
+    assert(newNumVertices >= numVertices);
+    assert(is_sorted(added.begin(), added.end()) && is_sorted(removed.begin(), removed.end()));
+    assert(added.empty() || added.back().first < newNumVertices);
+    assert(removed.empty() || removed.back().first < numVertices);
+
+    // Find the new degree of each row
+    vector<size_t> newOffsets(newNumVertices + 1, 0);
+    size_t nextAdded = 0;
+    size_t nextRemoved = 0;
+    for (unsigned int v = 0; v < newNumVertices; v++) {
+        size_t degree = v < numVertices ? offsets[v + 1] - offsets[v] : 0;
+        for (; nextAdded < added.size() && added[nextAdded].first == v; nextAdded++) degree++;
+        for (; nextRemoved < removed.size() && removed[nextRemoved].first == v; nextRemoved++) degree--;
+        newOffsets[v + 1] = newOffsets[v] + degree;
+    }
+    vector<unsigned int> newTargets(newOffsets[newNumVertices]);
+
+    // Copies the rows [first, last) that have no changes (the rows of the new vertices are empty)
+    auto copyRows = [&](unsigned int first, unsigned int last) {
+        last = min(last, numVertices);
+        if (first >= last) return;
+        copy(targets + offsets[first], targets + offsets[last], newTargets.begin() + newOffsets[first]);
+    };
+
+    nextAdded = 0;
+    nextRemoved = 0;
+    unsigned int nextRow = 0;   // every row before this has been copied
+    while (nextAdded < added.size() || nextRemoved < removed.size()) {
+        const unsigned int v = min(nextAdded < added.size() ? added[nextAdded].first : newNumVertices,
+                                   nextRemoved < removed.size() ? removed[nextRemoved].first : newNumVertices);
+        copyRows(nextRow, v);
+
+        // Merge the row with its added edges, skipping its removed edges
+        const unsigned int* rowIt = v < numVertices ? targets + offsets[v] : nullptr;
+        const unsigned int* rowEndIt = v < numVertices ? targets + offsets[v + 1] : nullptr;
+        unsigned int* out = newTargets.data() + newOffsets[v];
+        while (rowIt != rowEndIt || (nextAdded < added.size() && added[nextAdded].first == v)) {
+            if (nextAdded < added.size() && added[nextAdded].first == v &&
+                (rowIt == rowEndIt || added[nextAdded].second < *rowIt)) {
+                assert(rowIt == rowEndIt || added[nextAdded].second != *rowIt);
+                *out++ = added[nextAdded++].second;
+            }
+            else if (nextRemoved < removed.size() && removed[nextRemoved] == make_pair(v, *rowIt)) {
+                nextRemoved++;
+                rowIt++;
+            }
+            else {
+                *out++ = *rowIt++;
+            }
+        }
+        assert(out == newTargets.data() + newOffsets[v + 1]);
+        assert(nextRemoved == removed.size() || removed[nextRemoved].first != v);
+        nextRow = v + 1;
+    }
+    copyRows(nextRow, newNumVertices);
+
+    return AdjacencyIndex(newNumVertices, move(newOffsets), move(newTargets));
+}
+
+unsigned int AdjacencyIndex::getNumVertices() const {
+    /*
+     *  Returns the number of vertices (rows) in the index
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      unsigned int:
+     *          The number of vertices
+     */
+
+    return numVertices;
+}
+
+size_t AdjacencyIndex::getNumEdges() const {
+    /*
+     *  Returns the total number of edges stored in the index
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      size_t:
+     *          The number of edges (duplicate follows are only counted once)
+     */
+
+    return numEdges;
+}
+
+unsigned int AdjacencyIndex::getDegree(unsigned int v) const {
+    /*
+     *  Returns the number of neighbors in the row of vertex v
+     *
+     *  Parameters:
+     *      unsigned int v:
+     *          A 0-based vertex index. ASSERTS that it is a valid index.
+     *
+     *  Returns:
+     *      unsigned int:
+     *          The number of neighbors of vertex v
+     */
+
+    assert(v < numVertices);
+    return offsets[v + 1] - offsets[v];
+}
+
+const unsigned int* AdjacencyIndex::rowBegin(unsigned int v) const {
+    /*
+     *  Returns a pointer to the first neighbor of vertex v. The neighbors are sorted in increasing order.
+     *
+     *  Parameters:
+     *      unsigned int v:
+     *          A 0-based vertex index. ASSERTS that it is a valid index.
+     *
+     *  Returns:
+     *      const unsigned int*:
+     *          A pointer to the start of the row of vertex v
+     */
+
+    assert(v < numVertices);
+    return targets + offsets[v];
+}
+
+const unsigned int* AdjacencyIndex::rowEnd(unsigned int v) const {
+    /*
+     *  Returns a pointer one past the last neighbor of vertex v.
+     *
+     *  Parameters:
+     *      unsigned int v:
+     *          A 0-based vertex index. ASSERTS that it is a valid index.
+     *
+     *  Returns:
+     *      const unsigned int*:
+     *          A pointer to the end of the row of vertex v
+     */
+
+    assert(v < numVertices);
+    return targets + offsets[v + 1];
+}
+
+bool AdjacencyIndex::hasEdge(unsigned int from, unsigned int to) const {
+    /*
+     *  Checks if there is an edge from vertex "from" to vertex "to".
+     *  Since every row is sorted, this is a binary search on the row of "from" -- O(log(degree)).
+     *
+     *  Parameters:
+     *      unsigned int from:
+     *          The 0-based index of the vertex the edge starts at
+     *
+     *      unsigned int to:
+     *          The 0-based index of the vertex the edge ends at
+     *
+     *  Returns:
+     *      A boolean representing whether the edge (from -> to) is in the index
+     */
+
+    assert(from < numVertices && to < numVertices);
+    return binary_search(rowBegin(from), rowEnd(from), to);
+}
+
+const size_t* AdjacencyIndex::getOffsets() const {
+    /*
+     *  Returns the numVertices + 1 row offsets of the index, row v is [offsets[v], offsets[v + 1]) of the targets
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      const size_t*:
+     *          The offsets array
+     */
+
+    return offsets;
+}
+
+const unsigned int* AdjacencyIndex::getTargets() const {
+    /*
+     *  Returns the numEdges neighbors of every row, stored back to back
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      const unsigned int*:
+     *          The targets array
+     */
+
+    return targets;
+}
+
+
+// -------------------------------------------- PRIVATE HELPER METHODS ---------------------------------------------- //
+
+void AdjacencyIndex::adoptArrays(vector<size_t> ownedOffsets, vector<unsigned int> ownedTargets) {
+    /*
+     *  Takes ownership of a pair of CSR arrays. They are moved into shared storage, so that copies of this index share
+     *  them instead of copying them, and offsets and targets are pointed at them.
+     *
+     *  Parameters:
+     *      vector<size_t> ownedOffsets:
+     *          The numVertices + 1 row offsets
+     *
+     *      vector<unsigned int> ownedTargets:
+     *          The neighbors of every row, stored back to back
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    auto arrays = make_shared<pair<vector<size_t>, vector<unsigned int>>>(move(ownedOffsets), move(ownedTargets));
+    numEdges = arrays->second.size();
+    offsets = arrays->first.data();
+    targets = arrays->second.data();
+    storage = move(arrays);
+}
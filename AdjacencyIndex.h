@@ -0,0 +1,99 @@
+/** *************************************************************
+ *  Declaration of the AdjacencyIndex class                     *
+ *  @author Brandon Dale                                        *
+ *                                                              *
+ *  Stores the follow relationships of a social network as a    *
+ *  compressed sparse row (CSR) index. Each row holds the       *
+ *  sorted, de-duplicated neighbors of a single user, so the    *
+ *  memory used is O(N + E) rather than O(N^2).                 *
+ *                                                              *
+ *  The arrays are shared between copies of an index, and can   *
+ *  either be owned by the index or point into a memory mapped  *
+ *  snapshot file, so copying an index is cheap.                *
+ *                                                              *
+ *  NOTE: All vertices are 0-based indices (user ID - 1).       *
+ *                                                              *
+ *  @file AdjacencyIndex.h                                      *
+ *  @date October 14th, 2026                                    *
+ ***************************************************************/
+
+
+#ifndef CS315_PROJECT01_ADJACENCYINDEX_H
+#define CS315_PROJECT01_ADJACENCYINDEX_H
+
+#include <vector>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include "User.h"
+
+
+class AdjacencyIndex {
+public:
+    // ------------------------------------------------ Constructors ------------------------------------------------ //
+    // Default Constructor - Creates an index with 0 vertices and 0 edges
+    AdjacencyIndex();
+
+    // Creates the forward (follows) index from the follows list of every user. Users must be sorted by ID.
+    explicit AdjacencyIndex(const std::vector<User>& users);
+
+    // Creates an index from existing CSR arrays (such as ones saved to a file). Each row must already be sorted.
+    AdjacencyIndex(unsigned int numVertices, std::vector<std::size_t> offsets, std::vector<unsigned int> targets);
+
+    // Creates an index that views CSR arrays owned by something else (such as a mapped file), which storage keeps alive
+    AdjacencyIndex(unsigned int numVertices, std::size_t numEdges, const std::size_t* offsets,
+                   const unsigned int* targets, std::shared_ptr<const void> storage);
+
+
+    // ----------------------------------------------- Public Methods ----------------------------------------------- //
+    // Returns the reverse index, where row v holds every vertex that has an edge to v
+    AdjacencyIndex transposed() const;
+
+    // Returns a copy of the index where vertex v is renumbered to newIndices[v] (a permutation of the vertices), both
+    // as a row and as a neighbor, such as to put connected vertices near each other (see UserOrdering)
+    AdjacencyIndex relabeled(const std::vector<unsigned int>& newIndices) const;
+
+    // Returns a copy of the index with numVertices rows (no fewer than now), with the edges in added inserted and the
+    // edges in removed deleted. Both are sorted (from, to) pairs, every added edge must be new, and every removed edge
+    // must be in the index. The rows without changes are copied in large blocks.
+    AdjacencyIndex withEdgeChanges(unsigned int newNumVertices,
+                                   const std::vector<std::pair<unsigned int, unsigned int>>& added,
+                                   const std::vector<std::pair<unsigned int, unsigned int>>& removed) const;
+
+    // Returns the number of vertices (rows) in the index
+    unsigned int getNumVertices() const;
+
+    // Returns the total number of edges stored in the index
+    std::size_t getNumEdges() const;
+
+    // Returns the number of neighbors in the row of vertex v
+    unsigned int getDegree(unsigned int v) const;
+
+    // Returns a pointer to the first neighbor of vertex v
+    const unsigned int* rowBegin(unsigned int v) const;
+
+    // Returns a pointer one past the last neighbor of vertex v
+    const unsigned int* rowEnd(unsigned int v) const;
+
+    // Checks if there is an edge from vertex "from" to vertex "to" (binary search on the sorted row)
+    bool hasEdge(unsigned int from, unsigned int to) const;
+
+    // Returns the raw CSR arrays of the index (numVertices + 1 offsets, and numEdges targets)
+    const std::size_t* getOffsets() const;
+    const unsigned int* getTargets() const;
+
+private:
+    // -------------------------------------------- Private Data Members -------------------------------------------- //
+    unsigned int numVertices;
+    std::size_t numEdges;
+    const std::size_t* offsets;             // numVertices + 1 entries, row v is [offsets[v], offsets[v + 1])
+    const unsigned int* targets;            // all rows stored back to back
+    std::shared_ptr<const void> storage;    // keeps the memory that offsets and targets point into alive
+
+    // -----------------------------------------  Private Helper Functions ------------------------------------------ //
+    // Takes ownership of the CSR arrays, and points offsets and targets at them
+    void adoptArrays(std::vector<std::size_t> ownedOffsets, std::vector<unsigned int> ownedTargets);
+};
+
+
+#endif //CS315_PROJECT01_ADJACENCYINDEX_H
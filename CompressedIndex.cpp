@@ -0,0 +1,600 @@
+/** ****************************************************************
+ *  Implementation of the CompressedIndex class                    *
+ *  @author Brandon Dale                                           *
+ *                                                                 *
+ *  Each row is stored as:                                         *
+ *      varint degree                                              *
+ *      if the row has one block (degree <= BLOCK_SIZE):           *
+ *          varint first neighbor                                  *
+ *      otherwise (numBlocks = ceil(degree / BLOCK_SIZE)):         *
+ *          uint32 first neighbor of each block [numBlocks]        *
+ *          uint32 byte offset of the gaps of each block           *
+ *              (from the end of this table) [numBlocks]           *
+ *      varint gaps between the neighbors of each block (every     *
+ *          neighbor but the first of its block), block by block   *
+ *                                                                 *
+ *  The varints are LEB128 (7 bits in each byte, with the high     *
+ *  bit set on every byte but the last), and the uint32s are       *
+ *  unaligned and little endian. Since each block starts from its  *
+ *  own first neighbor, any block can be decoded on its own.       *
+ *                                                                 *
+ *  @file CompressedIndex.cpp                                      *
+ *  @date October 14th, 2026                                       *
+ ******************************************************************/
+
+
+#include "CompressedIndex.h"
+#include "ThreadPool.h"
+#include <cassert>
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+using namespace std;
+
+
+// ------------------------------------------------- FILE HELPERS --------------------------------------------------- //
+
+static size_t writeVarint(uint32_t value, unsigned char* out) {
+    /*
+     *  Writes a value as a LEB128 varint (the low 7 bits first)
+     *
+     *  Parameters:
+     *      uint32_t value:
+     *          The value to write
+     *
+     *      unsigned char* out:
+     *          Where to write the value, or nullptr to only count its bytes
+     *
+     *  Returns:
+     *      size_t:
+     *          The number of bytes of the varint (1 to 5)
+     */
+
+    size_t numBytes = 1;
+    while (value >= 0x80) {
+        if (out) *out++ = static_cast<unsigned char>(value | 0x80);
+        value >>= 7;
+        numBytes++;
+    }
+    if (out) *out = static_cast<unsigned char>(value);
+    return numBytes;
+}
+
+static uint32_t readVarint(const unsigned char*& in) {
+    /*
+     *  Reads a LEB128 varint, and moves in past it
+     *
+     *  Parameters:
+     *      const unsigned char*& in:
+     *          The first byte of the varint. Set to the byte after it.
+     *
+     *  Returns:
+     *      uint32_t:
+     *          The value of the varint
+     */
+
+    uint32_t value = *in & 0x7F;
+    unsigned int shift = 7;
+    while (*in++ & 0x80) {
+        value |= static_cast<uint32_t>(*in & 0x7F) << shift;
+        shift += 7;
+    }
+    return value;
+}
+
+static void writeUint32(uint32_t value, unsigned char* out) {
+    /*
+     *  Writes a value as 4 little endian bytes
+     *
+     *  Parameters:
+     *      uint32_t value:
+     *          The value to write
+     *
+     *      unsigned char* out:
+     *          Where to write the value (need not be aligned)
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    for (int i = 0; i < 4; i++) out[i] = static_cast<unsigned char>(value >> (8 * i));
+}
+
+static uint32_t readUint32(const unsigned char* in) {
+    /*
+     *  Reads 4 little endian bytes
+     *
+     *  Parameters:
+     *      const unsigned char* in:
+     *          The first byte (need not be aligned)
+     *
+     *  Returns:
+     *      uint32_t:
+     *          The value of the bytes
+     */
+
+    return uint32_t(in[0]) | uint32_t(in[1]) << 8 | uint32_t(in[2]) << 16 | uint32_t(in[3]) << 24;
+}
+
+
+// -------------------------------------------------- CONSTRUCTORS -------------------------------------------------- //
+
+CompressedIndex::CompressedIndex() {
+    /*
+     *  The default constructor of a CompressedIndex object. Creates an index with no vertices.
+     *  The offsets array always holds numVertices + 1 entries, so it holds a single 0 here.
+     *
+     *  Parameters:
+     *      Takes no parameters
+     *
+     *  Returns:
+     *      No return value, creates a CompressedIndex object
+     */
+
+    auto arrays = make_shared<pair<vector<size_t>, vector<unsigned char>>>(vector<size_t>(1, 0),
+                                                                           vector<unsigned char>());
+    this->numVertices = 0;
+    this->numEdges = 0;
+    this->offsets = arrays->first.data();
+    this->data = arrays->second.data();
+    this->storage = move(arrays);
+}
+
+CompressedIndex::CompressedIndex(const AdjacencyIndex& index, unsigned int numJobs) {
+    /*
+     *  Compresses an index. This takes two parallel passes over the rows: the first finds the number of bytes of every
+     *  row (which gives the row offsets), and the second encodes every row into its place.
+     *
+     *  Parameters:
+     *      const AdjacencyIndex& index:
+     *          The index to compress
+     *
+     *      unsigned int numJobs:
+     *          The number of threads to use. 0 uses the hardware concurrency.
+     *
+     *  Returns:
+     *      No return value, creates a CompressedIndex object
+     */
+
+    const unsigned int numRows = index.getNumVertices();
+    const size_t numTasks = (size_t(numRows) + ROWS_PER_TASK - 1) / ROWS_PER_TASK;
+    ThreadPool pool(numJobs);
+
+    vector<size_t> rowOffsets(size_t(numRows) + 1, 0);
+    pool.parallelFor(0, numTasks, 1, [&](unsigned int, size_t task) {
+        const unsigned int last = min<size_t>(numRows, (task + 1) * ROWS_PER_TASK);
+        for (unsigned int v = task * ROWS_PER_TASK; v < last; v++) {
+            rowOffsets[v + 1] = encodeRow(index.rowBegin(v), index.rowEnd(v), nullptr);
+        }
+    });
+    for (unsigned int v = 0; v < numRows; v++) rowOffsets[v + 1] += rowOffsets[v];
+
+    vector<unsigned char> rows(rowOffsets[numRows]);
+    pool.parallelFor(0, numTasks, 1, [&](unsigned int, size_t task) {
+        const unsigned int last = min<size_t>(numRows, (task + 1) * ROWS_PER_TASK);
+        for (unsigned int v = task * ROWS_PER_TASK; v < last; v++) {
+            encodeRow(index.rowBegin(v), index.rowEnd(v), rows.data() + rowOffsets[v]);
+        }
+    });
+
+    auto arrays = make_shared<pair<vector<size_t>, vector<unsigned char>>>(move(rowOffsets), move(rows));
+    this->numVertices = numRows;
+    this->numEdges = index.getNumEdges();
+    this->offsets = arrays->first.data();
+    this->data = arrays->second.data();
+    this->storage = move(arrays);
+}
+
+CompressedIndex::CompressedIndex(unsigned int numVertices, size_t numEdges, const size_t* offsets,
+                                 const unsigned char* data, shared_ptr<const void> storage) {
+    /*
+     *  Creates an index that views compressed arrays owned by something else, such as a memory mapped snapshot file.
+     *  Nothing is copied, so creating the index is O(1).
+     *
+     *  Parameters:
+     *      unsigned int numVertices:
+     *          The number of vertices (rows) in the index
+     *
+     *      size_t numEdges:
+     *          The number of edges in the index
+     *
+     *      const size_t* offsets:
+     *          The numVertices + 1 byte offsets of the rows. The first offset must be 0.
+     *
+     *      const unsigned char* data:
+     *          The compressed rows, stored back to back
+     *
+     *      shared_ptr<const void> storage:
+     *          The owner of the memory that offsets and data point into. It is kept alive by every copy of the index.
+     *
+     *  Returns:
+     *      No return value, creates a CompressedIndex object
+     */
+
+    assert(offsets[0] == 0);
+
+    this->numVertices = numVertices;
+    this->numEdges = numEdges;
+    this->offsets = offsets;
+    this->data = data;
+    this->storage = move(storage);
+}
+
+
+// ------------------------------------------------ PUBLIC METHODS -------------------------------------------------- //
+
+AdjacencyIndex CompressedIndex::decompressed(unsigned int numJobs) const {
+    /*
+     *  Returns the index decompressed back into CSR arrays. The row offsets are found from the degree at the start of
+     *  each row, and then the rows are decoded into their places in parallel.
+     *
+     *  Parameters:
+     *      unsigned int numJobs:
+     *          The number of threads to use. 0 uses the hardware concurrency.
+     *
+     *  Returns:
+     *      AdjacencyIndex:
+     *          The same index, uncompressed
+     */
+
+    vector<size_t> rowOffsets(size_t(numVertices) + 1, 0);
+    for (unsigned int v = 0; v < numVertices; v++) rowOffsets[v + 1] = rowOffsets[v] + getDegree(v);
+    assert(rowOffsets[numVertices] == numEdges);
+
+    vector<unsigned int> targets(numEdges);
+    ThreadPool pool(numJobs);
+    const size_t numTasks = (size_t(numVertices) + ROWS_PER_TASK - 1) / ROWS_PER_TASK;
+    pool.parallelFor(0, numTasks, 1, [&](unsigned int, size_t task) {
+        const unsigned int last = min<size_t>(numVertices, (task + 1) * ROWS_PER_TASK);
+        for (unsigned int v = task * ROWS_PER_TASK; v < last; v++) decodeRowTo(v, targets.data() + rowOffsets[v]);
+    });
+
+    return AdjacencyIndex(numVertices, move(rowOffsets), move(targets));
+}
+
+unsigned int CompressedIndex::getNumVertices() const {
+    /*
+     *  Returns the number of vertices (rows) in the index
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      unsigned int:
+     *          The number of vertices
+     */
+
+    return numVertices;
+}
+
+size_t CompressedIndex::getNumEdges() const {
+    /*
+     *  Returns the total number of edges stored in the index
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      size_t:
+     *          The number of edges
+     */
+
+    return numEdges;
+}
+
+size_t CompressedIndex::getNumBytes() const {
+    /*
+     *  Returns the number of bytes of the compressed rows
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      size_t:
+     *          The number of bytes of the rows (not counting the row offsets)
+     */
+
+    return offsets[numVertices];
+}
+
+unsigned int CompressedIndex::getDegree(unsigned int v) const {
+    /*
+     *  Returns the number of neighbors in the row of vertex v, which is the varint at the start of the row
+     *
+     *  Parameters:
+     *      unsigned int v:
+     *          A 0-based vertex index. ASSERTS that it is a valid index.
+     *
+     *  Returns:
+     *      unsigned int:
+     *          The number of neighbors of vertex v
+     */
+
+    assert(v < numVertices);
+    const unsigned char* in = data + offsets[v];
+    return readVarint(in);
+}
+
+void CompressedIndex::decodeRow(unsigned int v, vector<unsigned int>& row) const {
+    /*
+     *  Adds the neighbors of vertex v to the end of a vector, in increasing order
+     *
+     *  Parameters:
+     *      unsigned int v:
+     *          A 0-based vertex index. ASSERTS that it is a valid index.
+     *
+     *      vector<unsigned int>& row:
+     *          The vector to add the neighbors to
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    const size_t start = row.size();
+    row.resize(start + getDegree(v));
+    decodeRowTo(v, row.data() + start);
+}
+
+bool CompressedIndex::hasEdge(unsigned int from, unsigned int to) const {
+    /*
+     *  Checks if there is an edge from vertex "from" to vertex "to". A long row is binary searched by the first
+     *  neighbor of each block, and then only the block that could hold "to" is decoded, so this is
+     *  O(log(degree) + BLOCK_SIZE).
+     *
+     *  Parameters:
+     *      unsigned int from:
+     *          The 0-based index of the vertex the edge starts at
+     *
+     *      unsigned int to:
+     *          The 0-based index of the vertex the edge ends at
+     *
+     *  Returns:
+     *      A boolean representing whether the edge (from -> to) is in the index
+     */
+
+    assert(from < numVertices && to < numVertices);
+    const unsigned char* in = data + offsets[from];
+    const uint32_t degree = readVarint(in);
+    if (degree == 0) return false;
+
+    uint32_t neighbor;
+    uint32_t blockSize;
+    if (degree <= BLOCK_SIZE) {
+        neighbor = readVarint(in);
+        blockSize = degree;
+    }
+    else {
+        // Find the last block that starts at or before "to"
+        const uint32_t numBlocks = (degree + BLOCK_SIZE - 1) / BLOCK_SIZE;
+        const unsigned char* firsts = in;
+        const unsigned char* blockOffsets = in + 4 * size_t(numBlocks);
+        if (to < readUint32(firsts)) return false;
+        uint32_t low = 0;
+        uint32_t high = numBlocks;  // the block is in [low, high)
+        while (high - low > 1) {
+            const uint32_t middle = low + (high - low) / 2;
+            if (readUint32(firsts + 4 * size_t(middle)) <= to) low = middle;
+            else high = middle;
+        }
+        neighbor = readUint32(firsts + 4 * size_t(low));
+        in = blockOffsets + 4 * size_t(numBlocks) + readUint32(blockOffsets + 4 * size_t(low));
+        blockSize = low + 1 < numBlocks ? BLOCK_SIZE : degree - low * BLOCK_SIZE;
+    }
+
+    // Walk the gaps of the block until reaching or passing "to"
+    for (uint32_t i = 1; neighbor < to && i < blockSize; i++) neighbor += readVarint(in);
+    return neighbor == to;
+}
+
+bool CompressedIndex::isConsistent() const {
+    /*
+     *  Checks that the index can be used without reading past its arrays. Each row is decoded the same way as by
+     *  decodeRowTo and hasEdge, but every byte is bounds checked against the end of the row first, and the block
+     *  offsets of a long row are checked against where its gaps really start. This is O(V + E).
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if the offsets are non-decreasing, and every row decodes to exactly its own bytes, with
+     *          strictly increasing neighbors < numVertices, and numEdges neighbors are stored in all.
+     *          Otherwise, returns false.
+     */
+
+    if (offsets[0] != 0) return false;
+    size_t totalDegree = 0;
+    for (unsigned int v = 0; v < numVertices; v++) {
+        if (offsets[v] > offsets[v + 1]) return false;
+        const unsigned char* in = data + offsets[v];
+        const unsigned char* end = data + offsets[v + 1];
+
+        // Reads a varint of at most 5 bytes that ends before the end of the row, returns false if there is none
+        auto readVarintIn = [&](uint32_t& value) {
+            value = 0;
+            for (unsigned int shift = 0; shift < 35; shift += 7) {
+                if (in == end) return false;
+                const unsigned char byte = *in++;
+                value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+                if (!(byte & 0x80)) return true;
+            }
+            return false;
+        };
+
+        // Reads the gaps of a block of blockSize neighbors starting at neighbor, and sets neighbor to the last one.
+        // Returns false if they are not valid.
+        auto checkGaps = [&](uint64_t& neighbor, uint32_t blockSize) {
+            if (neighbor >= numVertices) return false;
+            for (uint32_t i = 1; i < blockSize; i++) {
+                uint32_t gap;
+                if (!readVarintIn(gap) || gap == 0) return false;
+                neighbor += gap;
+                if (neighbor >= numVertices) return false;
+            }
+            return true;
+        };
+
+        uint32_t degree;
+        if (!readVarintIn(degree)) return false;
+        totalDegree += degree;
+        if (degree == 0) {
+            if (in != end) return false;
+            continue;
+        }
+
+        if (degree <= BLOCK_SIZE) {
+            uint32_t first;
+            if (!readVarintIn(first)) return false;
+            uint64_t neighbor = first;
+            if (!checkGaps(neighbor, degree)) return false;
+        }
+        else {
+            const uint32_t numBlocks = (degree + BLOCK_SIZE - 1) / BLOCK_SIZE;
+            if (size_t(end - in) < 8 * size_t(numBlocks)) return false;
+            const unsigned char* firsts = in;
+            const unsigned char* blockOffsets = in + 4 * size_t(numBlocks);
+            in += 8 * size_t(numBlocks);
+            const unsigned char* gapsStart = in;
+            uint64_t neighbor = 0;    // the last neighbor of the previous block
+            for (uint32_t block = 0; block < numBlocks; block++) {
+                const uint32_t first = readUint32(firsts + 4 * size_t(block));
+                if (readUint32(blockOffsets + 4 * size_t(block)) != size_t(in - gapsStart)) return false;
+                if (block > 0 && first <= neighbor) return false;
+
+                const uint32_t blockSize = block + 1 < numBlocks ? BLOCK_SIZE : degree - block * BLOCK_SIZE;
+                neighbor = first;
+                if (!checkGaps(neighbor, blockSize)) return false;
+            }
+        }
+        if (in != end) return false;
+    }
+
+    return totalDegree == numEdges;
+}
+
+const size_t* CompressedIndex::getOffsets() const {
+    /*
+     *  Returns the numVertices + 1 byte offsets of the rows, row v is [offsets[v], offsets[v + 1]) of the data
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      const size_t*:
+     *          The offsets array
+     */
+
+    return offsets;
+}
+
+const unsigned char* CompressedIndex::getData() const {
+    /*
+     *  Returns the getNumBytes() bytes of compressed rows, stored back to back
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      const unsigned char*:
+     *          The data array
+     */
+
+    return data;
+}
+
+
+// -------------------------------------------- PRIVATE HELPER METHODS ---------------------------------------------- //
+
+size_t CompressedIndex::encodeRow(const unsigned int* begin, const unsigned int* end, unsigned char* out) {
+    /*
+     *  Writes a row in the format at the top of this file
+     *
+     *  Parameters:
+     *      const unsigned int* begin, end:
+     *          The neighbors of the row, sorted and de-duplicated
+     *
+     *      unsigned char* out:
+     *          Where to write the row, or nullptr to only count its bytes
+     *
+     *  Returns:
+     *      size_t:
+     *          The number of bytes of the row
+     */
+
+    const size_t degree = end - begin;
+    assert(degree <= UINT32_MAX);
+    size_t numBytes = writeVarint(degree, out);
+    if (degree == 0) return numBytes;
+
+    // Writes the gaps of the block [first, last), and returns their number of bytes
+    auto writeGaps = [&](const unsigned int* first, const unsigned int* last, size_t at) {
+        size_t gapBytes = 0;
+        for (const unsigned int* it = first + 1; it < last; it++) {
+            assert(*it > *(it - 1));
+            gapBytes += writeVarint(*it - *(it - 1), out ? out + at + gapBytes : nullptr);
+        }
+        return gapBytes;
+    };
+
+    if (degree <= BLOCK_SIZE) {
+        numBytes += writeVarint(*begin, out ? out + numBytes : nullptr);
+        return numBytes + writeGaps(begin, end, numBytes);
+    }
+
+    const size_t numBlocks = (degree + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    const size_t tableStart = numBytes;
+    const size_t gapsStart = tableStart + 8 * numBlocks;
+    size_t gapBytes = 0;
+    for (size_t block = 0; block < numBlocks; block++) {
+        const unsigned int* first = begin + block * BLOCK_SIZE;
+        const unsigned int* last = block + 1 < numBlocks ? first + BLOCK_SIZE : end;
+        if (out) {
+            assert(gapBytes <= UINT32_MAX);
+            writeUint32(*first, out + tableStart + 4 * block);
+            writeUint32(gapBytes, out + tableStart + 4 * (numBlocks + block));
+        }
+        gapBytes += writeGaps(first, last, gapsStart + gapBytes);
+    }
+    return gapsStart + gapBytes;
+}
+
+void CompressedIndex::decodeRowTo(unsigned int v, unsigned int* out) const {
+    /*
+     *  Decodes the row of vertex v. The blocks of a row are stored in order, so the gaps are read straight through and
+     *  the block offsets are not needed.
+     *
+     *  Parameters:
+     *      unsigned int v:
+     *          A 0-based vertex index. ASSERTS that it is a valid index.
+     *
+     *      unsigned int* out:
+     *          Where to write the neighbors, with room for the degree of v
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    assert(v < numVertices);
+    const unsigned char* in = data + offsets[v];
+    const uint32_t degree = readVarint(in);
+    if (degree == 0) return;
+
+    if (degree <= BLOCK_SIZE) {
+        uint32_t neighbor = readVarint(in);
+        out[0] = neighbor;
+        for (uint32_t i = 1; i < degree; i++) out[i] = neighbor += readVarint(in);
+    }
+    else {
+        const uint32_t numBlocks = (degree + BLOCK_SIZE - 1) / BLOCK_SIZE;
+        const unsigned char* firsts = in;
+        in += 8 * size_t(numBlocks);
+        for (uint32_t block = 0; block < numBlocks; block++) {
+            const uint32_t blockSize = block + 1 < numBlocks ? BLOCK_SIZE : degree - block * BLOCK_SIZE;
+            uint32_t neighbor = readUint32(firsts + 4 * size_t(block));
+            *out++ = neighbor;
+            for (uint32_t i = 1; i < blockSize; i++) *out++ = neighbor += readVarint(in);
+        }
+    }
+    assert(in == data + offsets[v + 1]);
+}
@@ -0,0 +1,103 @@
+/** *************************************************************
+ *  Declaration of the CompressedIndex class                    *
+ *  @author Brandon Dale                                        *
+ *                                                              *
+ *  A compressed copy of an AdjacencyIndex. Each sorted row is  *
+ *  stored as the gaps between its neighbors, written as        *
+ *  varints (7 bits per byte), so a row of nearby neighbors     *
+ *  (such as the followers of a popular user) takes about one   *
+ *  byte per edge rather than four. The gaps are split into     *
+ *  blocks of BLOCK_SIZE neighbors, and a long row starts with  *
+ *  the first neighbor and the position of every block, so a    *
+ *  lookup (hasEdge) only decodes a single block.               *
+ *                                                              *
+ *  Like an AdjacencyIndex, the arrays are shared between       *
+ *  copies, and can point into a memory mapped snapshot file.   *
+ *                                                              *
+ *  NOTE: All vertices are 0-based indices (user ID - 1).       *
+ *                                                              *
+ *  @file CompressedIndex.h                                     *
+ *  @date October 14th, 2026                                    *
+ ***************************************************************/
+
+
+#ifndef CS315_PROJECT01_COMPRESSEDINDEX_H
+#define CS315_PROJECT01_COMPRESSEDINDEX_H
+
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include "AdjacencyIndex.h"
+
+
+class CompressedIndex {
+public:
+    // ------------------------------------------------ Constructors ------------------------------------------------ //
+    // Default Constructor - Creates an index with 0 vertices and 0 edges
+    CompressedIndex();
+
+    // Compresses an index, using numJobs threads (0 uses the hardware concurrency)
+    explicit CompressedIndex(const AdjacencyIndex& index, unsigned int numJobs = 0);
+
+    // Creates an index that views compressed arrays owned by something else (such as a mapped file), which storage
+    // keeps alive
+    CompressedIndex(unsigned int numVertices, std::size_t numEdges, const std::size_t* offsets,
+                    const unsigned char* data, std::shared_ptr<const void> storage);
+
+
+    // ----------------------------------------------- Public Methods ----------------------------------------------- //
+    // Returns the index decompressed back into CSR arrays, using numJobs threads (0 uses the hardware concurrency)
+    AdjacencyIndex decompressed(unsigned int numJobs = 0) const;
+
+    // Returns the number of vertices (rows) in the index
+    unsigned int getNumVertices() const;
+
+    // Returns the total number of edges stored in the index
+    std::size_t getNumEdges() const;
+
+    // Returns the number of bytes of compressed rows (not counting the numVertices + 1 row offsets)
+    std::size_t getNumBytes() const;
+
+    // Returns the number of neighbors in the row of vertex v
+    unsigned int getDegree(unsigned int v) const;
+
+    // Adds the neighbors of vertex v (in increasing order) to the end of row
+    void decodeRow(unsigned int v, std::vector<unsigned int>& row) const;
+
+    // Checks if there is an edge from vertex "from" to vertex "to" (only the block that could hold it is decoded)
+    bool hasEdge(unsigned int from, unsigned int to) const;
+
+    // Checks that the rows can be decoded safely: the offsets are in order, and every row decodes within its own bytes
+    // to increasing neighbors that are vertices of the index, with numEdges neighbors in all (for arrays that were
+    // read from a file)
+    bool isConsistent() const;
+
+    // Returns the raw arrays of the index (numVertices + 1 byte offsets of the rows, and getNumBytes() bytes of rows)
+    const std::size_t* getOffsets() const;
+    const unsigned char* getData() const;
+
+    // The number of neighbors in each block of a row
+    static const unsigned int BLOCK_SIZE = 32;
+
+private:
+    // The number of rows in each block of work when the index is built in parallel
+    static const unsigned int ROWS_PER_TASK = 4096;
+
+    // -------------------------------------------- Private Data Members -------------------------------------------- //
+    unsigned int numVertices;
+    std::size_t numEdges;
+    const std::size_t* offsets;             // numVertices + 1 entries, row v is the bytes [offsets[v], offsets[v + 1])
+    const unsigned char* data;              // all compressed rows stored back to back
+    std::shared_ptr<const void> storage;    // keeps the memory that offsets and data point into alive
+
+    // -----------------------------------------  Private Helper Functions ------------------------------------------ //
+    // Writes a sorted row to out, and returns the number of bytes written. If out is nullptr, only the number of bytes
+    // that it would take is returned.
+    static std::size_t encodeRow(const unsigned int* begin, const unsigned int* end, unsigned char* out);
+
+    // Decodes the row of vertex v into out, which must have room for its degree
+    void decodeRowTo(unsigned int v, unsigned int* out) const;
+};
+
+
+#endif //CS315_PROJECT01_COMPRESSEDINDEX_H
@@ -0,0 +1,381 @@
+/** ****************************************************************
+ *  Implementation of the GraphAnalytics class                     *
+ *  @author Brandon Dale                                           *
+ *                                                                 *
+ *  The parallel loops work on blocks of BLOCK_SIZE users, and any *
+ *  sum over the whole network is added up from per block sums in  *
+ *  block order, so the results do not depend on how the blocks    *
+ *  were split between the threads.                                *
+ *                                                                 *
+ *  @file GraphAnalytics.cpp                                       *
+ *  @date October 14th, 2026                                       *
+ ******************************************************************/
+
+
+#include "GraphAnalytics.h"
+#include "Stats.h"
+#include <algorithm>
+#include <numeric>
+#include <atomic>
+#include <cmath>
+#include <cassert>
+
+using namespace std;
+
+
+// -------------------------------------------------- CONSTRUCTORS -------------------------------------------------- //
+
+GraphAnalytics::GraphAnalytics(const AdjacencyIndex& followsIndex, const AdjacencyIndex& followersIndex,
+                               unsigned int numJobs, UserOrdering::Method ordering)
+    : followsIndex(followsIndex), followersIndex(followersIndex), pool(numJobs) {
+    /*
+     *  Creates the analytics of a network, relabeling the copies of its indices if asked to
+     *  ASSERTS that both indices have the same number of users
+     *
+     *  Parameters:
+     *      const AdjacencyIndex& followsIndex:
+     *          The follows index of the network
+     *
+     *      const AdjacencyIndex& followersIndex:
+     *          The followers index of the network (the transpose of followsIndex)
+     *
+     *      unsigned int numJobs:
+     *          The number of threads to run the analytics with. 0 uses the hardware concurrency.
+     *
+     *      UserOrdering::Method ordering:
+     *          The order to relabel the users in before running the analytics, or ID to keep them as they are
+     *
+     *  Returns:
+     *      No return value, creates a GraphAnalytics object
+     */
+
+    assert(followsIndex.getNumVertices() == followersIndex.getNumVertices());
+    if (ordering != UserOrdering::ID) {
+        Stats::ScopedTimer timer(Stats::REORDER);
+        this->newIndices = UserOrdering::findNewIndices(ordering, followsIndex, followersIndex);
+        this->followsIndex = followsIndex.relabeled(this->newIndices);
+        this->followersIndex = this->followsIndex.transposed();
+    }
+}
+
+
+// ------------------------------------------------ PUBLIC METHODS -------------------------------------------------- //
+
+vector<double> GraphAnalytics::pageRank(unsigned int iterations, double damping, double* lastChange) {
+    /*
+     *  Finds the PageRank of every user. Each iteration, every user gives damping times their rank, split evenly, to
+     *  the users that they follow, and the rest of the rank (along with the rank of every user who follows nobody) is
+     *  spread evenly over every user.
+     *
+     *  The rank of each user is pulled from the shares of the users in their followers row, so each thread only writes
+     *  the ranks of its own block, and no atomics are needed. The shares are stored as floats, so the random reads of
+     *  them touch half as much memory. The shares of the next iteration are found along with the ranks, so each
+     *  iteration is a single pass over the followers index.
+     *
+     *  Parameters:
+     *      unsigned int iterations:
+     *          The number of iterations to run
+     *
+     *      double damping:
+     *          The part of the rank of each user which is given to the users they follow, from 0 to 1
+     *
+     *      double* lastChange:
+     *          Set to the sum of how much every rank changed in the last iteration (or 0, if there were none), if it is
+     *          not nullptr
+     *
+     *  Returns:
+     *      vector<double>:
+     *          The rank of every user, which sum to 1
+     */
+
+    const unsigned int numUsers = this->followsIndex.getNumVertices();
+    vector<double> ranks(numUsers, numUsers > 0 ? 1.0 / numUsers : 0.0);
+    if (lastChange != nullptr) *lastChange = 0;
+    if (numUsers == 0) return ranks;
+
+    const size_t numBlocks = (numUsers + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    vector<float> shares(numUsers);       // the rank that each user gives to each user they follow
+    vector<float> nextShares(numUsers);
+    vector<double> blockDangling(numBlocks);    // the rank of the users who follow nobody, in each block
+    vector<double> blockChange(numBlocks);      // how much the ranks of each block changed
+
+    // Find the shares of the first iteration, where every rank is the same
+    this->pool.parallelFor(0, numBlocks, 1, [&](unsigned int, size_t block) {
+        const unsigned int first = block * BLOCK_SIZE;
+        const unsigned int last = min<size_t>(first + BLOCK_SIZE, numUsers);
+        double dangling = 0;
+        for (unsigned int user = first; user < last; user++) {
+            const unsigned int degree = this->followsIndex.getDegree(user);
+            shares[user] = degree > 0 ? ranks[user] / degree : 0.0f;
+            if (degree == 0) dangling += ranks[user];
+        }
+        blockDangling[block] = dangling;
+    });
+
+    for (unsigned int iteration = 0; iteration < iterations; iteration++) {
+        const double dangling = accumulate(blockDangling.begin(), blockDangling.end(), 0.0);
+        const double base = (1.0 - damping + damping * dangling) / numUsers;
+
+        this->pool.parallelFor(0, numBlocks, 1, [&](unsigned int, size_t block) {
+            const unsigned int first = block * BLOCK_SIZE;
+            const unsigned int last = min<size_t>(first + BLOCK_SIZE, numUsers);
+            double nextDangling = 0;
+            double change = 0;
+            for (unsigned int user = first; user < last; user++) {
+                double received = 0;
+                const unsigned int* followersEnd = this->followersIndex.rowEnd(user);
+                for (const unsigned int* it = this->followersIndex.rowBegin(user); it != followersEnd; it++) {
+                    received += shares[*it];
+                }
+
+                const double rank = base + damping * received;
+                change += fabs(rank - ranks[user]);
+                ranks[user] = rank;
+                const unsigned int degree = this->followsIndex.getDegree(user);
+                nextShares[user] = degree > 0 ? rank / degree : 0.0f;
+                if (degree == 0) nextDangling += rank;
+            }
+            blockDangling[block] = nextDangling;
+            blockChange[block] = change;
+        });
+
+        shares.swap(nextShares);
+        if (lastChange != nullptr) *lastChange = accumulate(blockChange.begin(), blockChange.end(), 0.0);
+    }
+
+    if (this->newIndices.empty()) return ranks;
+    vector<double> originalRanks(numUsers);
+    for (unsigned int user = 0; user < numUsers; user++) originalRanks[user] = ranks[this->newIndices[user]];
+    return originalRanks;
+}
+
+vector<unsigned int> GraphAnalytics::weakComponents() {
+    /*
+     *  Finds the weakly connected component of every user with a union find, where the edges of the follows index are
+     *  united in parallel. Each parent is an atomic, and a root is only ever linked (by a compare and swap) under a
+     *  smaller root, so the root of every tree is its smallest user, and the labels are the same on every run. Finds
+     *  halve the paths that they follow, which only ever points a user at another of its ancestors.
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      vector<unsigned int>:
+     *          The smallest user in the component of every user
+     */
+
+    const unsigned int numUsers = this->followsIndex.getNumVertices();
+    const size_t numBlocks = (numUsers + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    vector<atomic<unsigned int>> parents(numUsers);
+    this->pool.parallelFor(0, numBlocks, 1, [&](unsigned int, size_t block) {
+        const unsigned int last = min<size_t>(block * BLOCK_SIZE + BLOCK_SIZE, numUsers);
+        for (unsigned int user = block * BLOCK_SIZE; user < last; user++) {
+            parents[user].store(user, memory_order_relaxed);
+        }
+    });
+
+    auto find = [&parents](unsigned int user) {
+        unsigned int parent = parents[user].load(memory_order_relaxed);
+        while (parent != user) {
+            const unsigned int grandparent = parents[parent].load(memory_order_relaxed);
+            if (grandparent != parent) parents[user].store(grandparent, memory_order_relaxed);
+            user = grandparent;
+            parent = parents[user].load(memory_order_relaxed);
+        }
+        return user;
+    };
+
+    this->pool.parallelFor(0, numBlocks, 1, [&](unsigned int, size_t block) {
+        const unsigned int last = min<size_t>(block * BLOCK_SIZE + BLOCK_SIZE, numUsers);
+        for (unsigned int user = block * BLOCK_SIZE; user < last; user++) {
+            const unsigned int* followsEnd = this->followsIndex.rowEnd(user);
+            for (const unsigned int* it = this->followsIndex.rowBegin(user); it != followsEnd; it++) {
+                // Link the larger of the two roots under the smaller, trying again if it stopped being a root
+                while (true) {
+                    unsigned int root = find(user);
+                    unsigned int otherRoot = find(*it);
+                    if (root == otherRoot) break;
+                    if (root < otherRoot) swap(root, otherRoot);
+                    unsigned int expected = root;
+                    if (parents[root].compare_exchange_weak(expected, otherRoot, memory_order_relaxed)) break;
+                }
+            }
+        }
+    });
+
+    vector<unsigned int> labels(numUsers);
+    this->pool.parallelFor(0, numBlocks, 1, [&](unsigned int, size_t block) {
+        const unsigned int last = min<size_t>(block * BLOCK_SIZE + BLOCK_SIZE, numUsers);
+        for (unsigned int user = block * BLOCK_SIZE; user < last; user++) labels[user] = find(user);
+    });
+    return this->restoreLabels(labels);
+}
+
+vector<unsigned int> GraphAnalytics::strongComponents() const {
+    /*
+     *  Finds the strongly connected component of every user with Tarjan's algorithm, using an explicit stack of the
+     *  users being searched (and how far through their follows row the search is), so a long chain of follows can not
+     *  overflow the call stack. Users who follow nobody, or whom nobody follows, are in a component of their own, so
+     *  they are labelled before the search starts and never searched.
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      vector<unsigned int>:
+     *          The smallest user in the component of every user
+     */
+
+    const unsigned int UNSET = ~0u;
+    const unsigned int numUsers = this->followsIndex.getNumVertices();
+    vector<unsigned int> labels(numUsers, UNSET);
+    for (unsigned int user = 0; user < numUsers; user++) {
+        if (this->followsIndex.getDegree(user) == 0 || this->followersIndex.getDegree(user) == 0) labels[user] = user;
+    }
+
+    vector<unsigned int> order(numUsers, UNSET);        // the order in which each user was found by the search
+    vector<unsigned int> lowest(numUsers);              // the lowest order that each user can reach on the stack
+    vector<unsigned int> stack;                         // the users found, that are not in a component yet
+    vector<pair<unsigned int, const unsigned int*>> path;   // the users being searched, and their next follow
+    unsigned int numFound = 0;
+
+    for (unsigned int start = 0; start < numUsers; start++) {
+        if (labels[start] != UNSET || order[start] != UNSET) continue;
+        order[start] = lowest[start] = numFound++;
+        stack.push_back(start);
+        path.emplace_back(start, this->followsIndex.rowBegin(start));
+
+        while (!path.empty()) {
+            const unsigned int user = path.back().first;
+            if (path.back().second != this->followsIndex.rowEnd(user)) {
+                const unsigned int followed = *path.back().second++;
+                if (labels[followed] != UNSET) continue;
+                if (order[followed] == UNSET) {
+                    order[followed] = lowest[followed] = numFound++;
+                    stack.push_back(followed);
+                    path.emplace_back(followed, this->followsIndex.rowBegin(followed));
+                }
+                else {
+                    // The user is on the stack, as they were found but are not in a component yet
+                    lowest[user] = min(lowest[user], order[followed]);
+                }
+                continue;
+            }
+
+            // Every follow of the user was searched, so if they can not reach an earlier user, they start a component
+            if (lowest[user] == order[user]) {
+                size_t componentBegin = stack.size();
+                unsigned int label = user;
+                do {
+                    componentBegin--;
+                    label = min(label, stack[componentBegin]);
+                } while (stack[componentBegin] != user);
+                for (size_t i = componentBegin; i < stack.size(); i++) labels[stack[i]] = label;
+                stack.resize(componentBegin);
+            }
+            path.pop_back();
+            if (!path.empty()) lowest[path.back().first] = min(lowest[path.back().first], lowest[user]);
+        }
+    }
+
+    return this->restoreLabels(labels);
+}
+
+vector<size_t> GraphAnalytics::degreeHistogram(const AdjacencyIndex& index) {
+    /*
+     *  Counts the rows of an index by their degree, in buckets of powers of 2
+     *
+     *  Parameters:
+     *      const AdjacencyIndex& index:
+     *          The index to count the rows of
+     *
+     *  Returns:
+     *      vector<size_t>:
+     *          The number of rows with no neighbors (in bucket 0), and with a degree from 2^(b - 1) to 2^b - 1 (in
+     *          bucket b), up to the bucket of the largest degree
+     */
+
+    vector<size_t> histogram(1, 0);
+    for (unsigned int v = 0; v < index.getNumVertices(); v++) {
+        unsigned int bucket = 0;
+        for (unsigned int degree = index.getDegree(v); degree > 0; degree >>= 1) bucket++;
+        if (bucket >= histogram.size()) histogram.resize(bucket + 1, 0);
+        histogram[bucket]++;
+    }
+    return histogram;
+}
+
+size_t GraphAnalytics::countComponents(const vector<unsigned int>& labels, size_t& largest) {
+    /*
+     *  Counts the components of a labelling, and the users in the largest of them
+     *
+     *  Parameters:
+     *      const vector<unsigned int>& labels:
+     *          The smallest user in the component of every user
+     *
+     *      size_t& largest:
+     *          Set to the number of users in the largest component (or 0, if there are no users)
+     *
+     *  Returns:
+     *      size_t:
+     *          The number of components
+     */
+
+    vector<unsigned int> sizes(labels.size(), 0);
+    for (unsigned int label : labels) sizes[label]++;
+    largest = sizes.empty() ? 0 : *max_element(sizes.begin(), sizes.end());
+    return labels.size() - count(sizes.begin(), sizes.end(), 0u);
+}
+
+vector<unsigned int> GraphAnalytics::rankOrder(const vector<double>& ranks) {
+    /*
+     *  Orders the users by their rank
+     *
+     *  Parameters:
+     *      const vector<double>& ranks:
+     *          The rank of every user (such as from pageRank)
+     *
+     *  Returns:
+     *      vector<unsigned int>:
+     *          Every user, from the highest rank to the lowest, with equal ranks in the order of the users
+     */
+
+    vector<unsigned int> order(ranks.size());
+    iota(order.begin(), order.end(), 0u);
+    sort(order.begin(), order.end(), [&ranks](unsigned int a, unsigned int b) {
+        return ranks[a] > ranks[b] || (ranks[a] == ranks[b] && a < b);
+    });
+    return order;
+}
+
+
+// -------------------------------------------- PRIVATE HELPER METHODS ---------------------------------------------- //
+
+vector<unsigned int> GraphAnalytics::restoreLabels(const vector<unsigned int>& labels) const {
+    /*
+     *  Maps the component labels of the relabeled users back to the original users. Each component is labelled by
+     *  the smallest original user in it, so the labels are the same whichever order the users were relabeled in.
+     *
+     *  Parameters:
+     *      const vector<unsigned int>& labels:
+     *          The smallest relabeled user in the component of every relabeled user
+     *
+     *  Returns:
+     *      vector<unsigned int>:
+     *          The smallest original user in the component of every original user (labels, if no user was relabeled)
+     */
+
+    if (this->newIndices.empty()) return labels;
+    const unsigned int numUsers = labels.size();
+    vector<unsigned int> smallest(numUsers, ~0u);
+    for (unsigned int user = 0; user < numUsers; user++) {
+        unsigned int& label = smallest[labels[this->newIndices[user]]];
+        label = min(label, user);
+    }
+
+    vector<unsigned int> originalLabels(numUsers);
+    for (unsigned int user = 0; user < numUsers; user++) {
+        originalLabels[user] = smallest[labels[this->newIndices[user]]];
+    }
+    return originalLabels;
+}
@@ -0,0 +1,89 @@
+/** *************************************************************
+ *  Declaration of the GraphAnalytics class                     *
+ *  @author Brandon Dale                                        *
+ *                                                              *
+ *  Batch analytics over the follows and followers indices of a *
+ *  social network: the PageRank of every user, the weakly and  *
+ *  strongly connected components, and histograms of the number *
+ *  of follows and followers. PageRank pulls the rank of each   *
+ *  user from the followers index (so no two threads write the  *
+ *  same entry), weak components are found by a lock-free union *
+ *  find, and strong components by an iterative Tarjan search.  *
+ *  The users can first be relabeled (see UserOrdering) so that *
+ *  connected users are near each other in memory. The results  *
+ *  are always given by the original 0-based index of the user. *
+ *                                                              *
+ *  NOTE: All users are 0-based indices (user ID - 1).          *
+ *                                                              *
+ *  @file GraphAnalytics.h                                      *
+ *  @date October 14th, 2026                                    *
+ ***************************************************************/
+
+
+#ifndef CS315_PROJECT01_GRAPHANALYTICS_H
+#define CS315_PROJECT01_GRAPHANALYTICS_H
+
+#include <vector>
+#include <cstddef>
+#include "AdjacencyIndex.h"
+#include "ThreadPool.h"
+#include "UserOrdering.h"
+
+
+class GraphAnalytics {
+public:
+    // ------------------------------------------------ Constructors ------------------------------------------------ //
+    // Runs analytics on a network, given its follows index and the transpose of it, using numJobs threads (0 uses the
+    // hardware concurrency). Unless ordering is ID, the analytics run on copies of the indices relabeled by it.
+    GraphAnalytics(const AdjacencyIndex& followsIndex, const AdjacencyIndex& followersIndex, unsigned int numJobs = 0,
+                   UserOrdering::Method ordering = UserOrdering::ID);
+
+
+    // ----------------------------------------------- Public Methods ----------------------------------------------- //
+    // Returns the PageRank of every user after a number of iterations, which sum to 1. The rank of users who follow
+    // nobody is spread evenly over every user. Sets lastChange (if it is not nullptr) to the sum of the changes of
+    // every rank in the last iteration.
+    std::vector<double> pageRank(unsigned int iterations = DEFAULT_PAGERANK_ITERATIONS,
+                                 double damping = DEFAULT_DAMPING, double* lastChange = nullptr);
+
+    // Returns the weakly connected component of every user (ignoring the direction of the follows), labelled by the
+    // smallest user in the component
+    std::vector<unsigned int> weakComponents();
+
+    // Returns the strongly connected component of every user (the users that can each reach the others by follows),
+    // labelled by the smallest user in the component
+    std::vector<unsigned int> strongComponents() const;
+
+    // Returns a histogram of the degrees of the rows of an index. Bucket 0 counts the rows with no neighbors, and
+    // bucket b > 0 counts the rows with a degree from 2^(b - 1) to 2^b - 1.
+    static std::vector<std::size_t> degreeHistogram(const AdjacencyIndex& index);
+
+    // Returns the number of components of a labelling (from weakComponents or strongComponents), and sets largest to
+    // the number of users in the largest of them
+    static std::size_t countComponents(const std::vector<unsigned int>& labels, std::size_t& largest);
+
+    // Returns every user, ordered by rank (highest first), with ties broken by the smaller user
+    static std::vector<unsigned int> rankOrder(const std::vector<double>& ranks);
+
+    // The defaults of pageRank
+    static const unsigned int DEFAULT_PAGERANK_ITERATIONS = 20;
+    static constexpr double DEFAULT_DAMPING = 0.85;
+
+private:
+    // -------------------------------------------- Private Data Members -------------------------------------------- //
+    AdjacencyIndex followsIndex;            // the indices that the analytics run on (copies share the arrays)
+    AdjacencyIndex followersIndex;
+    std::vector<unsigned int> newIndices;   // the relabeled index of each user, or empty if they are not relabeled
+    ThreadPool pool;
+
+    // The number of users in each block of work of the parallel loops
+    static const unsigned int BLOCK_SIZE = 4096;
+
+    // -----------------------------------------  Private Helper Functions ------------------------------------------ //
+    // Returns the labels of the relabeled users (the smallest relabeled user in each component) by the original index
+    // of each user, labelled by the smallest original user in each component
+    std::vector<unsigned int> restoreLabels(const std::vector<unsigned int>& labels) const;
+};
+
+
+#endif //CS315_PROJECT01_GRAPHANALYTICS_H
@@ -0,0 +1,103 @@
+/** ****************************************************************
+ *  Implementation of the IdArena class                            *
+ *  @author Brandon Dale                                           *
+ *                                                                 *
+ *  IDs are bumped out of 1 MB blocks. A request larger than a     *
+ *  block (such as every follows list of a file at once) gets a    *
+ *  block of its own. A block is never resized or freed before     *
+ *  the arena, so every span stays valid for its lifetime.         *
+ *                                                                 *
+ *  @file IdArena.cpp                                              *
+ *  @date October 14th, 2026                                       *
+ ******************************************************************/
+
+
+#include "IdArena.h"
+#include <algorithm>
+
+using namespace std;
+
+
+// -------------------------------------------------- CONSTRUCTORS -------------------------------------------------- //
+
+IdArena::IdArena() {
+    /*
+     *  Creates an empty arena. No block is allocated until the first IDs are.
+     *
+     *  Parameters:
+     *      Takes no parameters
+     *
+     *  Returns:
+     *      No return value, creates an IdArena object
+     */
+
+    blockUsed = 0;
+    blockCapacity = 0;
+    numIds = 0;
+}
+
+
+// ------------------------------------------------ PUBLIC METHODS -------------------------------------------------- //
+
+unsigned int* IdArena::allocate(size_t count) {
+    /*
+     *  Returns space for a number of IDs. The space is carved out of the current block (a new block is started if it
+     *  does not fit), and a request larger than a whole block gets a block of its own. The blocks are not zeroed, since
+     *  every caller fills the space it asks for, and zeroing a block of every follows list would touch it twice.
+     *
+     *  Parameters:
+     *      size_t count:
+     *          The number of IDs to make space for
+     *
+     *  Returns:
+     *      unsigned int*:
+     *          The uninitialized space, valid for the lifetime of the arena (nullptr if count is 0)
+     */
+
+    if (count == 0) return nullptr;
+
+    // Start a new block if the IDs do not fit in the current one
+    if (blocks.empty() || blockCapacity - blockUsed < count) {
+        blockCapacity = count > BLOCK_SIZE ? count : BLOCK_SIZE;
+        blocks.push_back(unique_ptr<unsigned int[]>(new unsigned int[blockCapacity]));
+        blockUsed = 0;
+    }
+
+    unsigned int* space = blocks.back().get() + blockUsed;
+    blockUsed += count;
+    numIds += count;
+    return space;
+}
+
+IdSpan IdArena::store(IdSpan ids) {
+    /*
+     *  Returns a view of a new copy of an array of IDs in the arena
+     *
+     *  Parameters:
+     *      IdSpan ids:
+     *          The IDs to copy. They do not need to stay alive after this call.
+     *
+     *  Returns:
+     *      IdSpan:
+     *          A view of the copy, valid for the lifetime of the arena
+     */
+
+    unsigned int* copy = allocate(ids.size());
+    copy_n(ids.begin(), ids.size(), copy);
+    return IdSpan(copy, ids.size());
+}
+
+size_t IdArena::getNumIds() const {
+    /*
+     *  Returns the number of IDs allocated in the arena
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      size_t:
+     *          The total number of IDs that space was allocated for
+     */
+
+    return numIds;
+}
@@ -0,0 +1,57 @@
+/** *************************************************************
+ *  Declaration of the IdArena class                            *
+ *  @author Brandon Dale                                        *
+ *                                                              *
+ *  A bump allocator for the follows lists of a social network. *
+ *  Arrays of user IDs are carved out of large blocks that      *
+ *  never move, and are handed out as IdSpans, so loading a     *
+ *  network costs a handful of allocations instead of one per   *
+ *  user, and every list is freed at once with the arena.       *
+ *                                                              *
+ *  @file IdArena.h                                             *
+ *  @date October 14th, 2026                                    *
+ ***************************************************************/
+
+
+#ifndef CS315_PROJECT01_IDARENA_H
+#define CS315_PROJECT01_IDARENA_H
+
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include "IdSpan.h"
+
+
+class IdArena {
+public:
+    // ------------------------------------------------ Constructors ------------------------------------------------ //
+    // Creates an empty arena
+    IdArena();
+
+    // The spans handed out point into the arena, so it can not be copied
+    IdArena(const IdArena&) = delete;
+    IdArena& operator=(const IdArena&) = delete;
+
+
+    // ----------------------------------------------- Public Methods ----------------------------------------------- //
+    // Returns uninitialized space for count IDs, which never moves and is valid for the lifetime of the arena
+    unsigned int* allocate(std::size_t count);
+
+    // Returns a view of a new copy of ids in the arena
+    IdSpan store(IdSpan ids);
+
+    // Returns the number of IDs allocated in the arena
+    std::size_t getNumIds() const;
+
+private:
+    // -------------------------------------------- Private Data Members -------------------------------------------- //
+    std::vector<std::unique_ptr<unsigned int[]>> blocks;
+    std::size_t blockUsed;          // the number of IDs used in the last block
+    std::size_t blockCapacity;      // the number of IDs that fit in the last block
+    std::size_t numIds;
+
+    static const std::size_t BLOCK_SIZE = 1 << 18;  // IDs per block (1 MB)
+};
+
+
+#endif //CS315_PROJECT01_IDARENA_H
@@ -0,0 +1,183 @@
+/** ****************************************************************
+ *  Implementation of the IdSpan class                             *
+ *  @author Brandon Dale                                           *
+ *                                                                 *
+ *  @file IdSpan.cpp                                               *
+ *  @date October 14th, 2026                                       *
+ ******************************************************************/
+
+
+#include "IdSpan.h"
+#include <algorithm>
+
+using namespace std;
+
+
+// -------------------------------------------------- CONSTRUCTORS -------------------------------------------------- //
+
+IdSpan::IdSpan() {
+    /*
+     *  Creates an empty span
+     *
+     *  Parameters:
+     *      Takes no parameters
+     *
+     *  Returns:
+     *      No return value, creates an IdSpan object
+     */
+
+    ids = nullptr;
+    numIds = 0;
+}
+
+IdSpan::IdSpan(const unsigned int* ids, size_t size) {
+    /*
+     *  Creates a view of an array of IDs
+     *
+     *  Parameters:
+     *      const unsigned int* ids:
+     *          The first ID. The array must outlive the span (it may be nullptr if size is 0).
+     *
+     *      size_t size:
+     *          The number of IDs
+     *
+     *  Returns:
+     *      No return value, creates an IdSpan object
+     */
+
+    this->ids = ids;
+    this->numIds = size;
+}
+
+IdSpan::IdSpan(const vector<unsigned int>& ids) {
+    /*
+     *  Creates a view of the IDs of a vector. This lets a vector be passed wherever a span is expected.
+     *
+     *  Parameters:
+     *      const vector<unsigned int>& ids:
+     *          The IDs. The vector must not be changed or destroyed while the span is used.
+     *
+     *  Returns:
+     *      No return value, creates an IdSpan object
+     */
+
+    this->ids = ids.data();
+    this->numIds = ids.size();
+}
+
+
+// ---------------------------------------------- OPERATOR OVERLOADING ---------------------------------------------- //
+
+bool IdSpan::operator==(const IdSpan& other) const {
+    /*
+     *  Checks if two spans hold the same IDs in the same order
+     *
+     *  Parameters:
+     *      const IdSpan& other:
+     *          The span to compare with
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if the IDs are equal (wherever they are stored).
+     *          Otherwise, returns false.
+     */
+
+    return numIds == other.numIds && equal(begin(), end(), other.begin());
+}
+
+bool IdSpan::operator!=(const IdSpan& other) const {
+    /*
+     *  Checks if two spans hold different IDs
+     *
+     *  Parameters:
+     *      const IdSpan& other:
+     *          The span to compare with
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if the IDs are not equal.
+     *          Otherwise, returns false.
+     */
+
+    return !(*this == other);
+}
+
+unsigned int IdSpan::operator[](size_t i) const {
+    /*
+     *  Returns the ID at an index. Like a vector's operator[], the index is not checked.
+     *
+     *  Parameters:
+     *      size_t i:
+     *          The index of the ID, less than size()
+     *
+     *  Returns:
+     *      unsigned int:
+     *          The ID at the index
+     */
+
+    return ids[i];
+}
+
+
+// ------------------------------------------------ PUBLIC METHODS -------------------------------------------------- //
+
+const unsigned int* IdSpan::begin() const {
+    /*
+     *  Returns a pointer to the first ID
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      const unsigned int*:
+     *          The first ID (nullptr for a default constructed span)
+     */
+
+    return ids;
+}
+
+const unsigned int* IdSpan::end() const {
+    /*
+     *  Returns a pointer one past the last ID
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      const unsigned int*:
+     *          One past the last ID
+     */
+
+    return ids + numIds;
+}
+
+size_t IdSpan::size() const {
+    /*
+     *  Returns the number of IDs
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      size_t:
+     *          The number of IDs in the span
+     */
+
+    return numIds;
+}
+
+bool IdSpan::empty() const {
+    /*
+     *  Checks if the span has no IDs
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if there are no IDs.
+     *          Otherwise, returns false.
+     */
+
+    return numIds == 0;
+}
@@ -0,0 +1,61 @@
+/** *************************************************************
+ *  Declaration of the IdSpan class                             *
+ *  @author Brandon Dale                                        *
+ *                                                              *
+ *  A read-only view of an array of user IDs that is owned by   *
+ *  something else (an IdArena, a vector, or a mapped file), in *
+ *  the way that a string_view is a view of a string. Copying a *
+ *  span never copies the IDs.                                  *
+ *                                                              *
+ *  @file IdSpan.h                                              *
+ *  @date October 14th, 2026                                    *
+ ***************************************************************/
+
+
+#ifndef CS315_PROJECT01_IDSPAN_H
+#define CS315_PROJECT01_IDSPAN_H
+
+#include <vector>
+#include <cstddef>
+
+
+class IdSpan {
+public:
+    // ------------------------------------------------ Constructors ------------------------------------------------ //
+    // Creates an empty span
+    IdSpan();
+
+    // Creates a view of size IDs starting at ids
+    IdSpan(const unsigned int* ids, std::size_t size);
+
+    // Creates a view of the IDs of a vector, which must not change while the span is used
+    IdSpan(const std::vector<unsigned int>& ids);
+
+
+    // -------------------------------------------- Operator Overloading -------------------------------------------- //
+    // Compares the IDs (not where they are stored)
+    bool operator ==(const IdSpan& other) const;
+    bool operator !=(const IdSpan& other) const;
+
+    // Returns the ID at an index, which is not checked
+    unsigned int operator [](std::size_t i) const;
+
+    // ----------------------------------------------- Public Methods ----------------------------------------------- //
+    // Returns a pointer to the first ID, and one past the last ID
+    const unsigned int* begin() const;
+    const unsigned int* end() const;
+
+    // Returns the number of IDs
+    std::size_t size() const;
+
+    // Returns true if there are no IDs
+    bool empty() const;
+
+private:
+    // -------------------------------------------- Private Data Members -------------------------------------------- //
+    const unsigned int* ids;
+    std::size_t numIds;
+};
+
+
+#endif //CS315_PROJECT01_IDSPAN_H
@@ -0,0 +1,453 @@
+/** ****************************************************************
+ *  Implementation of the IncrementalState class                   *
+ *  @author Brandon Dale                                           *
+ *                                                                 *
+ *  Saves and loads the state of the previous run, and compares    *
+ *  it against the current state to find which pages changed.      *
+ *                                                                 *
+ *  The state file has the following layout (native byte order):   *
+ *      char[8]              magic "SNSTATE" + version byte        *
+ *      uint64               numUsers                              *
+ *      uint64               numEdges                              *
+ *      uint64               numIds (0, or numUsers)               *
+ *      uint64               shardLevels of the page layout        *
+ *      uint64               listPageSize of the page layout       *
+ *      uint64[numUsers]     name hashes                           *
+ *      uint64[numUsers]     page hashes                           *
+ *      uint64[numIds]       the ID of each user in the input file *
+ *      uint64[numUsers + 1] follows index offsets                 *
+ *      uint32[numEdges]     follows index targets                 *
+ *                                                                 *
+ *  @file IncrementalState.cpp                                     *
+ *  @date October 14th, 2026                                       *
+ ******************************************************************/
+
+
+#include "IncrementalState.h"
+#include "MappedFile.h"
+#include "OutputLayout.h"
+#include <fstream>
+#include <cstring>
+#include <cstdint>
+#include <cstdio>
+#include <algorithm>
+
+using namespace std;
+
+const char* const IncrementalState::FILENAME = ".social_network_state";
+
+static const char STATE_MAGIC[8] = {'S', 'N', 'S', 'T', 'A', 'T', 'E', 4};
+
+
+// -------------------------------------------------- CONSTRUCTORS -------------------------------------------------- //
+
+IncrementalState::IncrementalState() {
+    /*
+     *  The default constructor of an IncrementalState object. Creates an empty state with 0 users, which is the state
+     *  used when there was no previous run (so every page is new).
+     *
+     *  Parameters:
+     *      Takes no parameters
+     *
+     *  Returns:
+     *      No return value, creates an IncrementalState object
+     */
+
+    numUsers = 0;
+    shardLevels = 0;
+    listPageSize = 0;
+}
+
+IncrementalState::IncrementalState(const vector<User>& users, const vector<uint64_t>& externalIds,
+                                   const AdjacencyIndex& followsIndex, const OutputLayout& layout) {
+    /*
+     *  Creates the state of a social network from its users and follows index.
+     *
+     *  Two hashes are kept for each user. The name hash changes whenever the name changes, which changes every page
+     *  that links to the user. The page hash covers all of the user's own data that appears on their page: the name,
+     *  location, picture url and follows list (in its original order, as that is the order it is shown in).
+     *  The follows index shares its arrays with the network's index, so it is not copied.
+     *
+     *  Parameters:
+     *      const vector<User>& users:
+     *          The users of the social network, sorted by ID
+     *
+     *      const vector<uint64_t>& externalIds:
+     *          The ID in the input file of each user, or empty if the IDs are 1 to the number of users
+     *
+     *      const AdjacencyIndex& followsIndex:
+     *          The follows index of the social network
+     *
+     *      const OutputLayout& layout:
+     *          The layout that the pages are created in
+     *
+     *  Returns:
+     *      No return value, creates an IncrementalState object
+     */
+
+    numUsers = users.size();
+    shardLevels = layout.getShardLevels();
+    listPageSize = layout.getListPageSize();
+    this->externalIds = externalIds;
+    this->followsIndex = followsIndex;
+    nameHashes.reserve(numUsers);
+    pageHashes.reserve(numUsers);
+
+    const char separator = '\0';
+    for (const User& user : users) {
+        string_view name = user.getName();
+        string_view location = user.getLocation();
+        string_view pic_url = user.getPicUrl();
+        const IdSpan follows = user.getFollows();
+
+        unsigned long long nameHash = hashBytes(name.data(), name.size(), 0);
+        nameHashes.push_back(nameHash);
+
+        unsigned long long pageHash = hashBytes(&separator, 1, nameHash);
+        pageHash = hashBytes(location.data(), location.size(), pageHash);
+        pageHash = hashBytes(&separator, 1, pageHash);
+        pageHash = hashBytes(pic_url.data(), pic_url.size(), pageHash);
+        pageHash = hashBytes(&separator, 1, pageHash);
+        pageHash = hashBytes(follows.begin(), follows.size() * sizeof(unsigned int), pageHash);
+        pageHashes.push_back(pageHash);
+    }
+}
+
+
+// ------------------------------------------------ PUBLIC METHODS -------------------------------------------------- //
+
+bool IncrementalState::load(const string& filename) {
+    /*
+     *  Loads a state saved by save().
+     *
+     *  The file is mapped and checked to be exactly the size that its header says before anything is copied out of it,
+     *  so a truncated or foreign file is treated the same as a missing one.
+     *
+     *  Parameters:
+     *      const string& filename:
+     *          The name of the state file
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if the state was loaded.
+     *          Returns false if the file is missing or invalid, leaving the state empty.
+     */
+
+    numUsers = 0;
+    shardLevels = 0;
+    listPageSize = 0;
+    nameHashes.clear();
+    pageHashes.clear();
+    externalIds.clear();
+    followsIndex = AdjacencyIndex();
+
+    MappedFile stateFile(filename);
+    if (!stateFile.isOpen()) return false;
+    const char* data = stateFile.getContents().data();
+    size_t size = stateFile.getSize();
+
+    // Check the header and the size of the file
+    const size_t headerSize = sizeof(STATE_MAGIC) + 5 * sizeof(uint64_t);
+    if (size < headerSize || memcmp(data, STATE_MAGIC, sizeof(STATE_MAGIC)) != 0) return false;
+
+    uint64_t savedNumUsers;
+    uint64_t savedNumEdges;
+    uint64_t savedNumIds;
+    memcpy(&savedNumUsers, data + sizeof(STATE_MAGIC), sizeof(uint64_t));
+    memcpy(&savedNumEdges, data + sizeof(STATE_MAGIC) + sizeof(uint64_t), sizeof(uint64_t));
+    uint64_t savedShardLevels;
+    memcpy(&savedNumIds, data + sizeof(STATE_MAGIC) + 2 * sizeof(uint64_t), sizeof(uint64_t));
+    memcpy(&savedShardLevels, data + sizeof(STATE_MAGIC) + 3 * sizeof(uint64_t), sizeof(uint64_t));
+    uint64_t savedListPageSize;
+    memcpy(&savedListPageSize, data + sizeof(STATE_MAGIC) + 4 * sizeof(uint64_t), sizeof(uint64_t));
+    if (savedNumUsers > UINT32_MAX || savedNumEdges > size) return false;
+    if (savedShardLevels > OutputLayout::MAX_SHARD_LEVELS) return false;
+    if (savedNumIds != 0 && savedNumIds != savedNumUsers) return false;
+
+    size_t expectedSize = headerSize + (savedNumUsers * 3 + savedNumIds) * sizeof(uint64_t) + sizeof(uint64_t) +
+                          savedNumEdges * sizeof(uint32_t);
+    if (size != expectedSize) return false;
+
+    // Copy out each array
+    const char* pos = data + headerSize;
+    vector<unsigned long long> loadedNameHashes(savedNumUsers);
+    vector<unsigned long long> loadedPageHashes(savedNumUsers);
+    vector<uint64_t> loadedIds(savedNumIds);
+    vector<size_t> offsets(savedNumUsers + 1);
+    vector<unsigned int> targets(savedNumEdges);
+
+    memcpy(loadedNameHashes.data(), pos, savedNumUsers * sizeof(uint64_t));
+    pos += savedNumUsers * sizeof(uint64_t);
+    memcpy(loadedPageHashes.data(), pos, savedNumUsers * sizeof(uint64_t));
+    pos += savedNumUsers * sizeof(uint64_t);
+    memcpy(loadedIds.data(), pos, savedNumIds * sizeof(uint64_t));
+    pos += savedNumIds * sizeof(uint64_t);
+    for (size_t& offset : offsets) {
+        uint64_t savedOffset;
+        memcpy(&savedOffset, pos, sizeof(uint64_t));
+        pos += sizeof(uint64_t);
+        offset = savedOffset;
+    }
+    memcpy(targets.data(), pos, savedNumEdges * sizeof(uint32_t));
+
+    // Make sure the index is consistent before using it
+    if (offsets.front() != 0 || offsets.back() != savedNumEdges) return false;
+    for (size_t v = 0; v < savedNumUsers; v++) {
+        if (offsets[v] > offsets[v + 1]) return false;
+    }
+    for (unsigned int target : targets) {
+        if (target >= savedNumUsers) return false;
+    }
+
+    numUsers = savedNumUsers;
+    shardLevels = savedShardLevels;
+    listPageSize = savedListPageSize;
+    nameHashes = move(loadedNameHashes);
+    pageHashes = move(loadedPageHashes);
+    externalIds = move(loadedIds);
+    followsIndex = AdjacencyIndex(numUsers, move(offsets), move(targets));
+    return true;
+}
+
+bool IncrementalState::save(const string& filename) const {
+    /*
+     *  Saves the state to a file.
+     *
+     *  The state is written to a temporary file which is then renamed over the old one, so an interrupted run never
+     *  leaves behind a state that does not match the pages.
+     *
+     *  Parameters:
+     *      const string& filename:
+     *          The name of the state file
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if the state was saved.
+     *          Otherwise, returns false.
+     */
+
+    string tempFilename = filename + ".tmp";
+    ofstream out(tempFilename, ios::binary | ios::trunc);
+    if (!out.is_open()) return false;
+
+    const size_t* offsets = followsIndex.getOffsets();
+    const unsigned int* targets = followsIndex.getTargets();
+    uint64_t savedNumUsers = numUsers;
+    uint64_t savedNumEdges = followsIndex.getNumEdges();
+    uint64_t savedNumIds = externalIds.size();
+    uint64_t savedShardLevels = shardLevels;
+    uint64_t savedListPageSize = listPageSize;
+
+    out.write(STATE_MAGIC, sizeof(STATE_MAGIC));
+    out.write(reinterpret_cast<const char*>(&savedNumUsers), sizeof(uint64_t));
+    out.write(reinterpret_cast<const char*>(&savedNumEdges), sizeof(uint64_t));
+    out.write(reinterpret_cast<const char*>(&savedNumIds), sizeof(uint64_t));
+    out.write(reinterpret_cast<const char*>(&savedShardLevels), sizeof(uint64_t));
+    out.write(reinterpret_cast<const char*>(&savedListPageSize), sizeof(uint64_t));
+    out.write(reinterpret_cast<const char*>(nameHashes.data()), numUsers * sizeof(uint64_t));
+    out.write(reinterpret_cast<const char*>(pageHashes.data()), numUsers * sizeof(uint64_t));
+    out.write(reinterpret_cast<const char*>(externalIds.data()), savedNumIds * sizeof(uint64_t));
+    for (size_t v = 0; v <= numUsers; v++) {
+        uint64_t savedOffset = offsets[v];
+        out.write(reinterpret_cast<const char*>(&savedOffset), sizeof(uint64_t));
+    }
+    out.write(reinterpret_cast<const char*>(targets), savedNumEdges * sizeof(uint32_t));
+    out.close();
+
+    if (!out) return false;
+    return rename(tempFilename.c_str(), filename.c_str()) == 0;
+}
+
+unsigned int IncrementalState::getNumUsers() const {
+    /*
+     *  Returns the number of users in the state
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      unsigned int:
+     *          The number of users
+     */
+
+    return numUsers;
+}
+
+OutputLayout IncrementalState::getLayout() const {
+    /*
+     *  Returns the layout that the pages were created in (the default layout, for an empty state)
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      OutputLayout:
+     *          The layout, with the levels of directories and the page size of the pages
+     */
+
+    return OutputLayout(shardLevels, listPageSize);
+}
+
+uint64_t IncrementalState::getId(unsigned int i) const {
+    /*
+     *  Returns the ID in the input file of the user with the 0-based index i (which their page is named by)
+     *
+     *  Parameters:
+     *      unsigned int i:
+     *          The 0-based index of the user, less than the number of users
+     *
+     *  Returns:
+     *      uint64_t:
+     *          The ID of the user
+     */
+
+    return externalIds.empty() ? i + 1 : externalIds[i];
+}
+
+bool IncrementalState::findChangedPages(const IncrementalState& previous, const AdjacencyIndex& followersIndex,
+                                        vector<bool>& changedUsers) const {
+    /*
+     *  Marks every user page that differs from the previous state.
+     *
+     *  A user's page is made from their own data, and the names of the users in their follows, followers and mutuals
+     *  lists. So a page changes when:
+     *      1) The user's own data changed (or the user is new)
+     *      2) A follow to or from the user was added or removed (which changes the follows, followers or mutuals lists)
+     *      3) The name of a user that they follow, or that follows them, changed
+     *  If the users were numbered differently (the IDs in the input file are not the same as before), an index no
+     *  longer refers to the same user, so every page is treated as changed. The same goes for pages that move to a
+     *  different layout, as every link changes.
+     *  The follows changes are found by merging the old and new sorted follows rows of a user, which marks both ends of
+     *  every follow that was added or removed. The page hash covers the user's follows, so the rows can only differ if
+     *  the user's page hash did (or the user was added or removed), and only those users' rows are merged. Together
+     *  this is O(N) plus the follows of the changed users, rather than O(N + E) for the whole network.
+     *
+     *  Parameters:
+     *      const IncrementalState& previous:
+     *          The state of the previous run
+     *
+     *      const AdjacencyIndex& followersIndex:
+     *          The (current) followers index of the social network
+     *
+     *      vector<bool>& changedUsers:
+     *          Is resized to the number of users, and then true is set for the 0-based index of every changed page
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if the index page also needs to be re-created (a name changed, or users were added/removed)
+     *          Otherwise, returns false.
+     */
+
+    if (!getLayout().isSameLayout(previous.getLayout()) || !hasSameIds(previous)) {
+        changedUsers.assign(numUsers, true);
+        return true;
+    }
+
+    changedUsers.assign(numUsers, false);
+    bool indexChanged = (numUsers != previous.numUsers);
+    unsigned int maxUsers = max(numUsers, previous.numUsers);
+
+    for (unsigned int u = 0; u < maxUsers; u++) {
+        bool inCurrent = u < numUsers;
+        bool inPrevious = u < previous.numUsers;
+
+        // 1) The user's own data changed
+        if (inCurrent && (!inPrevious || pageHashes[u] != previous.pageHashes[u])) {
+            changedUsers[u] = true;
+        }
+
+        // 3) The user's name changed, so every page that links to them changed
+        if (inCurrent && inPrevious && nameHashes[u] != previous.nameHashes[u]) {
+            indexChanged = true;
+            for (const unsigned int* it = followsIndex.rowBegin(u); it != followsIndex.rowEnd(u); it++) {
+                changedUsers[*it] = true;
+            }
+            for (const unsigned int* it = followersIndex.rowBegin(u); it != followersIndex.rowEnd(u); it++) {
+                changedUsers[*it] = true;
+            }
+        }
+
+        // 2) Mark both ends of every follow that is only in one of the old or new rows (a removed user has no follows)
+        if (inCurrent && inPrevious && pageHashes[u] == previous.pageHashes[u]) continue;
+        const unsigned int* newIt = inCurrent ? followsIndex.rowBegin(u) : nullptr;
+        const unsigned int* newEnd = inCurrent ? followsIndex.rowEnd(u) : nullptr;
+        const unsigned int* oldIt = inPrevious ? previous.followsIndex.rowBegin(u) : nullptr;
+        const unsigned int* oldEnd = inPrevious ? previous.followsIndex.rowEnd(u) : nullptr;
+        while (newIt != newEnd || oldIt != oldEnd) {
+            unsigned int changedTarget;
+            if (oldIt == oldEnd || (newIt != newEnd && *newIt < *oldIt)) {
+                changedTarget = *newIt++;
+            }
+            else if (newIt == newEnd || *oldIt < *newIt) {
+                changedTarget = *oldIt++;
+            }
+            else {
+                newIt++;
+                oldIt++;
+                continue;
+            }
+
+            if (inCurrent) changedUsers[u] = true;
+            if (changedTarget < numUsers) changedUsers[changedTarget] = true;
+        }
+    }
+
+    return indexChanged;
+}
+
+
+// -------------------------------------------- PRIVATE HELPER METHODS ---------------------------------------------- //
+
+bool IncrementalState::hasSameIds(const IncrementalState& previous) const {
+    /*
+     *  Checks if every index that is in both states refers to the user with the same ID in the input file, so that the
+     *  two states can be compared index by index.
+     *
+     *  Parameters:
+     *      const IncrementalState& previous:
+     *          The state of the previous run
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if the indices in both states refer to the same users.
+     *          Otherwise, returns false.
+     */
+
+    if (externalIds.empty() && previous.externalIds.empty()) return true;
+
+    unsigned int numShared = min(numUsers, previous.numUsers);
+    for (unsigned int i = 0; i < numShared; i++) {
+        if (getId(i) != previous.getId(i)) return false;
+    }
+    return true;
+}
+
+unsigned long long IncrementalState::hashBytes(const void* bytes, size_t size, unsigned long long hash) {
+    /*
+     *  Returns the 64-bit FNV-1a hash of a range of bytes. A hash of 0 starts a new hash (using the FNV offset basis),
+     *  any other value continues hashing from it, so several fields can be chained into one hash.
+     *
+     *  Parameters:
+     *      const void* bytes:
+     *          The bytes to hash
+     *
+     *      size_t size:
+     *          The number of bytes
+     *
+     *      unsigned long long hash:
+     *          The hash to continue from, or 0 to start a new one
+     *
+     *  Returns:
+     *      unsigned long long:
+     *          The hash value
+     */
+
+    if (hash == 0) hash = 14695981039346656037ULL;
+
+    const unsigned char* byte = static_cast<const unsigned char*>(bytes);
+    for (size_t i = 0; i < size; i++) {
+        hash ^= byte[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
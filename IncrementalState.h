@@ -0,0 +1,82 @@
+/** *************************************************************
+ *  Declaration of the IncrementalState class                   *
+ *  @author Brandon Dale                                        *
+ *                                                              *
+ *  A compact record of everything the HTML pages of a social   *
+ *  network were created from: a hash of each user's name and   *
+ *  own page data, plus the follows index. Comparing the state  *
+ *  of the previous run with the current one finds exactly      *
+ *  which pages changed, so only those need to be re-created.   *
+ *                                                              *
+ *  @file IncrementalState.h                                    *
+ *  @date October 14th, 2026                                    *
+ ***************************************************************/
+
+
+#ifndef CS315_PROJECT01_INCREMENTALSTATE_H
+#define CS315_PROJECT01_INCREMENTALSTATE_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "User.h"
+#include "AdjacencyIndex.h"
+#include "OutputLayout.h"
+
+
+class IncrementalState {
+public:
+    // ------------------------------------------------ Constructors ------------------------------------------------ //
+    // Default Constructor - Creates an empty state (0 users), as if no pages were created before
+    IncrementalState();
+
+    // Creates the state of a social network from its users (sorted by ID), the ID in the input file of each user (empty
+    // if they are 1 to the number of users), and follows index, whose pages are created in layout
+    IncrementalState(const std::vector<User>& users, const std::vector<uint64_t>& externalIds,
+                     const AdjacencyIndex& followsIndex, const OutputLayout& layout);
+
+
+    // ----------------------------------------------- Public Methods ----------------------------------------------- //
+    // Loads a state saved by save(). Returns false (and leaves the state empty) if the file is missing or invalid.
+    bool load(const std::string& filename);
+
+    // Saves the state to a file. Returns false if the file could not be written.
+    bool save(const std::string& filename) const;
+
+    // Returns the number of users in the state
+    unsigned int getNumUsers() const;
+
+    // Returns the ID in the input file of the user with the 0-based index i
+    uint64_t getId(unsigned int i) const;
+
+    // Returns the layout that the pages were created in
+    OutputLayout getLayout() const;
+
+    // Marks (in changedUsers) the 0-based index of every user page that differs from the previous state.
+    // Returns true if the index page also needs to be re-created.
+    bool findChangedPages(const IncrementalState& previous, const AdjacencyIndex& followersIndex,
+                          std::vector<bool>& changedUsers) const;
+
+    // The name of the file that the state is saved to, in the same directory as the pages
+    static const char* const FILENAME;
+
+private:
+    // -------------------------------------------- Private Data Members -------------------------------------------- //
+    unsigned int numUsers;
+    unsigned int shardLevels;                       // the layout of the pages (see OutputLayout)
+    std::size_t listPageSize;
+    std::vector<unsigned long long> nameHashes;     // hash of each user's name
+    std::vector<unsigned long long> pageHashes;     // hash of each user's own page data (name, location, picture, follows)
+    std::vector<uint64_t> externalIds;              // the ID of each user in the input file, or empty if they are 1 to N
+    AdjacencyIndex followsIndex;                    // shares its arrays with the network's index
+
+    // -----------------------------------------  Private Helper Functions ------------------------------------------ //
+    // Checks if every index in both this and the previous state refers to the user with the same ID in the input file
+    bool hasSameIds(const IncrementalState& previous) const;
+
+    // Returns the 64-bit FNV-1a hash of size bytes, continuing from a previous hash value
+    static unsigned long long hashBytes(const void* bytes, std::size_t size, unsigned long long hash);
+};
+
+
+#endif //CS315_PROJECT01_INCREMENTALSTATE_H
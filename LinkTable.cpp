@@ -0,0 +1,89 @@
+/** ****************************************************************
+ *  Implementation of the LinkTable class                          *
+ *  @author Brandon Dale                                           *
+ *                                                                 *
+ *  Renders the link to every user into a single buffer, with an   *
+ *  offset table in the same format as a contiguous NameTable, so  *
+ *  a NameTable can use it directly (see NameTable::setLinks).     *
+ *                                                                 *
+ *  @file LinkTable.cpp                                            *
+ *  @date October 14th, 2026                                       *
+ ******************************************************************/
+
+
+#include "LinkTable.h"
+
+using namespace std;
+
+
+// -------------------------------------------------- CONSTRUCTORS -------------------------------------------------- //
+
+LinkTable::LinkTable(const NameTable& names) : data(64 * names.size()) {
+    /*
+     *  Renders the link to every user in names back to back in ID order, as seen from a user page in the layout of
+     *  names (see OutputLayout::appendLink).
+     *
+     *  Parameters:
+     *      const NameTable& names:
+     *          The name and ID of every user. The links are copies, so the names do not need to outlive the table.
+     *
+     *  Returns:
+     *      No return value, creates a LinkTable object
+     */
+
+    offsets.reserve(names.size() + 1);
+    offsets.push_back(0);
+    for (size_t i = 0; i < names.size(); i++) {
+        names.getLayout().appendLink(data, names.getId(i), names.getName(i), false);
+        offsets.push_back(data.getSize());
+    }
+}
+
+
+// ------------------------------------------------ PUBLIC METHODS -------------------------------------------------- //
+
+size_t LinkTable::size() const {
+    /*
+     *  Returns the number of links in the table
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      size_t:
+     *          The number of links (one per user)
+     */
+
+    return offsets.size() - 1;
+}
+
+const uint64_t* LinkTable::getOffsets() const {
+    /*
+     *  Returns the offsets of the links, where the link of the user with the 0-based index i is the characters
+     *  [offsets[i], offsets[i + 1]) of getData()
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      const uint64_t*:
+     *          size() + 1 offsets, valid for the lifetime of the table
+     */
+
+    return offsets.data();
+}
+
+const char* LinkTable::getData() const {
+    /*
+     *  Returns the characters of every link, back to back in ID order
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      const char*:
+     *          The characters of the links, valid for the lifetime of the table
+     */
+
+    return data.getContents().data();
+}
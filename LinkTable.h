@@ -0,0 +1,51 @@
+/** *************************************************************
+ *  Declaration of the LinkTable class                          *
+ *  @author Brandon Dale                                        *
+ *                                                              *
+ *  The rendered list item that links to the page of every      *
+ *  user of a social network, <li><a href="userN.html">Name</a> *
+ *  </li>, stored back to back in ID order. Each link is        *
+ *  rendered once, and then every page that lists the user      *
+ *  (which is every follower's page for a popular user) copies  *
+ *  it instead of formatting the ID and name again.             *
+ *                                                              *
+ *  @file LinkTable.h                                           *
+ *  @date October 14th, 2026                                    *
+ ***************************************************************/
+
+
+#ifndef CS315_PROJECT01_LINKTABLE_H
+#define CS315_PROJECT01_LINKTABLE_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "NameTable.h"
+#include "PageBuffer.h"
+
+
+class LinkTable {
+public:
+    // ------------------------------------------------ Constructors ------------------------------------------------ //
+    // Renders the link to every user in names
+    explicit LinkTable(const NameTable& names);
+
+
+    // ----------------------------------------------- Public Methods ----------------------------------------------- //
+    // Returns the number of links in the table
+    std::size_t size() const;
+
+    // Returns the size + 1 offsets of the links into getData()
+    const uint64_t* getOffsets() const;
+
+    // Returns the characters of every link
+    const char* getData() const;
+
+private:
+    // -------------------------------------------- Private Data Members -------------------------------------------- //
+    std::vector<uint64_t> offsets;
+    PageBuffer data;
+};
+
+
+#endif //CS315_PROJECT01_LINKTABLE_H
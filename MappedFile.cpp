@@ -0,0 +1,210 @@
+/** ****************************************************************
+ *  Implementation of the MappedFile class                         *
+ *  @author Brandon Dale                                           *
+ *                                                                 *
+ *  Maps a whole file into memory with mmap, so that the input     *
+ *  file can be read without any stream or copy overhead.          *
+ *                                                                 *
+ *  @file MappedFile.cpp                                           *
+ *  @date October 14th, 2026                                       *
+ ******************************************************************/
+
+
+#include "MappedFile.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace std;
+
+
+// -------------------------------------------------- CONSTRUCTORS -------------------------------------------------- //
+
+MappedFile::MappedFile() {
+    /*
+     *  The default constructor of a MappedFile object. Does not map any file.
+     *
+     *  Parameters:
+     *      Takes no parameters
+     *
+     *  Returns:
+     *      No return value, creates a MappedFile object
+     */
+
+    opened = false;
+    data = nullptr;
+    size = 0;
+}
+
+MappedFile::MappedFile(const string& filename) {
+    /*
+     *  Maps the file with the given filename into memory (read only).
+     *
+     *  The file descriptor is closed as soon as the mapping is made, as the mapping stays valid without it. The kernel
+     *  is told that the file will be read sequentially, so that it can read ahead aggressively.
+     *  If the file cannot be opened or mapped, isOpen() will return false. An empty file is opened successfully, but
+     *  has no contents.
+     *
+     *  Parameters:
+     *      const string& filename:
+     *          The name of the file to map
+     *
+     *  Returns:
+     *      No return value, creates a MappedFile object
+     */
+
+    opened = false;
+    data = nullptr;
+    size = 0;
+
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) return;
+
+    struct stat fileInfo{};
+    if (fstat(fd, &fileInfo) != 0) {
+        close(fd);
+        return;
+    }
+    size = fileInfo.st_size;
+
+    // mmap does not allow a mapping of length 0, so an empty file is simply left unmapped
+    if (size > 0) {
+        void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            close(fd);
+            size = 0;
+            return;
+        }
+        madvise(mapping, size, MADV_SEQUENTIAL);
+        data = static_cast<const char*>(mapping);
+    }
+
+    close(fd);
+    opened = true;
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    /*
+     *  Moves the mapping of another MappedFile into a new MappedFile. The other MappedFile no longer maps any file.
+     *
+     *  Parameters:
+     *      MappedFile&& other:
+     *          The MappedFile to take the mapping from
+     *
+     *  Returns:
+     *      No return value, creates a MappedFile object
+     */
+
+    opened = other.opened;
+    data = other.data;
+    size = other.size;
+
+    other.opened = false;
+    other.data = nullptr;
+    other.size = 0;
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    /*
+     *  Releases the current mapping, and then takes the mapping of another MappedFile.
+     *
+     *  Parameters:
+     *      MappedFile&& other:
+     *          The MappedFile to take the mapping from
+     *
+     *  Returns:
+     *      MappedFile&:
+     *          The current MappedFile object
+     */
+
+    if (this != &other) {
+        unmap();
+        opened = other.opened;
+        data = other.data;
+        size = other.size;
+
+        other.opened = false;
+        other.data = nullptr;
+        other.size = 0;
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile() {
+    /*
+     *  Destructor, releases the mapping of the file.
+     */
+
+    unmap();
+}
+
+
+// ------------------------------------------------ PUBLIC METHODS -------------------------------------------------- //
+
+bool MappedFile::isOpen() const {
+    /*
+     *  Checks if the file was opened and mapped successfully
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if the file is mapped (or was empty). Otherwise, returns false.
+     */
+
+    return opened;
+}
+
+string_view MappedFile::getContents() const {
+    /*
+     *  Returns the contents of the whole file. The view is only valid while this object is alive.
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      string_view:
+     *          A view of every byte in the file
+     */
+
+    return {data, size};
+}
+
+size_t MappedFile::getSize() const {
+    /*
+     *  Returns the size of the file in bytes
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      size_t:
+     *          The size of the file
+     */
+
+    return size;
+}
+
+
+// -------------------------------------------- PRIVATE HELPER METHODS ---------------------------------------------- //
+
+void MappedFile::unmap() {
+    /*
+     *  Releases the current mapping (if there is one)
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    if (data != nullptr) {
+        munmap(const_cast<char*>(data), size);
+    }
+    opened = false;
+    data = nullptr;
+    size = 0;
+}
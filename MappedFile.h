@@ -0,0 +1,64 @@
+/** *************************************************************
+ *  Declaration of the MappedFile class                         *
+ *  @author Brandon Dale                                        *
+ *                                                              *
+ *  A read-only memory mapping of a whole file. The contents    *
+ *  are exposed as a single string_view, so a file can be       *
+ *  scanned without copying it into a stream or a std::string.  *
+ *  The mapping is released when the object is destroyed.       *
+ *                                                              *
+ *  @file MappedFile.h                                          *
+ *  @date October 14th, 2026                                    *
+ ***************************************************************/
+
+
+#ifndef CS315_PROJECT01_MAPPEDFILE_H
+#define CS315_PROJECT01_MAPPEDFILE_H
+
+#include <string>
+#include <string_view>
+#include <cstddef>
+
+
+class MappedFile {
+public:
+    // ------------------------------------------------ Constructors ------------------------------------------------ //
+    // Default Constructor - Creates a MappedFile that does not map any file
+    MappedFile();
+
+    // Maps the file with the given filename into memory (read only)
+    explicit MappedFile(const std::string& filename);
+
+    // A mapping has a single owner, so it can be moved but not copied
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Unmaps the file
+    ~MappedFile();
+
+
+    // ----------------------------------------------- Public Methods ----------------------------------------------- //
+    // Checks if the file was opened and mapped successfully
+    bool isOpen() const;
+
+    // Returns the contents of the whole file
+    std::string_view getContents() const;
+
+    // Returns the size of the file in bytes
+    std::size_t getSize() const;
+
+private:
+    // -------------------------------------------- Private Data Members -------------------------------------------- //
+    bool opened;
+    const char* data;
+    std::size_t size;
+
+    // -----------------------------------------  Private Helper Functions ------------------------------------------ //
+    // Releases the current mapping (if there is one)
+    void unmap();
+};
+
+
+#endif //CS315_PROJECT01_MAPPEDFILE_H
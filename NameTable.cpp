@@ -0,0 +1,263 @@
+/** ****************************************************************
+ *  Implementation of the NameTable class                          *
+ *  @author Brandon Dale                                           *
+ *                                                                 *
+ *  A table only holds pointers to the names, so it is cheap to    *
+ *  create and copy, and never owns the memory it views.           *
+ *                                                                 *
+ *  @file NameTable.cpp                                            *
+ *  @date October 14th, 2026                                       *
+ ******************************************************************/
+
+
+#include "NameTable.h"
+#include <cassert>
+
+using namespace std;
+
+
+// -------------------------------------------------- CONSTRUCTORS -------------------------------------------------- //
+
+NameTable::NameTable() {
+    /*
+     *  Creates a table with no names.
+     *
+     *  Parameters:
+     *      Takes no parameters
+     *
+     *  Returns:
+     *      No return value, creates a NameTable object
+     */
+
+    numNames = 0;
+    names = nullptr;
+    offsets = nullptr;
+    data = nullptr;
+    externalIds = nullptr;
+    linkOffsets = nullptr;
+    linkData = nullptr;
+    layout = nullptr;
+}
+
+NameTable::NameTable(const vector<string_view>& names, const uint64_t* externalIds) {
+    /*
+     *  Creates a table that views a vector of names, where names[i] is the name of the user with the 0-based index i.
+     *
+     *  Parameters:
+     *      const vector<string_view>& names:
+     *          The name of every user. The vector (and the strings it views) must outlive the table.
+     *
+     *      const uint64_t* externalIds:
+     *          The ID of every user as written in the input file (names.size() of them), which must outlive the table.
+     *          nullptr means that the IDs are 1 to the number of users, so the ID of the user with index i is i + 1.
+     *
+     *  Returns:
+     *      No return value, creates a NameTable object
+     */
+
+    this->numNames = names.size();
+    this->names = names.data();
+    this->offsets = nullptr;
+    this->data = nullptr;
+    this->externalIds = externalIds;
+    this->linkOffsets = nullptr;
+    this->linkData = nullptr;
+    this->layout = nullptr;
+}
+
+NameTable::NameTable(size_t numNames, const uint64_t* offsets, const char* data) {
+    /*
+     *  Creates a table that views a contiguous table of names, where the names are stored back to back in id order.
+     *  The IDs of the users are 1 to numNames.
+     *
+     *  Parameters:
+     *      size_t numNames:
+     *          The number of names in the table
+     *
+     *      const uint64_t* offsets:
+     *          numNames + 1 offsets into data. The name of the user with the 0-based index i is the characters
+     *          [offsets[i], offsets[i + 1]) of data.
+     *
+     *      const char* data:
+     *          The characters of every name
+     *
+     *  Returns:
+     *      No return value, creates a NameTable object
+     */
+
+    this->numNames = numNames;
+    this->names = nullptr;
+    this->offsets = offsets;
+    this->data = data;
+    this->externalIds = nullptr;
+    this->linkOffsets = nullptr;
+    this->linkData = nullptr;
+    this->layout = nullptr;
+}
+
+
+// ------------------------------------------------ PUBLIC METHODS -------------------------------------------------- //
+
+size_t NameTable::size() const {
+    /*
+     *  Returns the number of names in the table
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      size_t:
+     *          The number of names
+     */
+
+    return numNames;
+}
+
+string_view NameTable::getName(size_t i) const {
+    /*
+     *  Returns the name of the user with the 0-based index i
+     *  ASSERTS that i is a valid index
+     *
+     *  Parameters:
+     *      size_t i:
+     *          The 0-based index of the user (their position in ID order)
+     *
+     *  Returns:
+     *      string_view:
+     *          The name of the user, which stays valid for as long as the viewed names do
+     */
+
+    assert(i < numNames);
+    if (names != nullptr) return names[i];
+    return {data + offsets[i], static_cast<size_t>(offsets[i + 1] - offsets[i])};
+}
+
+uint64_t NameTable::getId(size_t i) const {
+    /*
+     *  Returns the ID of the user with the 0-based index i, as it is written in the input file. This is the ID that the
+     *  page of the user is named by (user<ID>.html), and that every link to them uses.
+     *  ASSERTS that i is a valid index, if the table has IDs (otherwise the ID is always i + 1)
+     *
+     *  Parameters:
+     *      size_t i:
+     *          The 0-based index of the user
+     *
+     *  Returns:
+     *      uint64_t:
+     *          The ID of the user
+     */
+
+    if (externalIds == nullptr) return i + 1;
+    assert(i < numNames);
+    return externalIds[i];
+}
+
+void NameTable::setLayout(const OutputLayout* layout) {
+    /*
+     *  Makes the table use a layout for the pages of the users (see OutputLayout), which decides both the file that
+     *  each page is written to and the relative links between pages. The layout must outlive the table.
+     *
+     *  Parameters:
+     *      const OutputLayout* layout:
+     *          The layout to use, or nullptr to put every page next to index.html
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    this->layout = layout;
+}
+
+const OutputLayout& NameTable::getLayout() const {
+    /*
+     *  Returns the layout of the pages of the users
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      const OutputLayout&:
+     *          The layout given to setLayout, or a layout that puts every page next to index.html
+     */
+
+    static const OutputLayout flatLayout;
+    return layout != nullptr ? *layout : flatLayout;
+}
+
+void NameTable::setLinks(const uint64_t* linkOffsets, const char* linkData) {
+    /*
+     *  Makes the table use a table of the rendered link to every user (such as one made by LinkTable), which must
+     *  outlive this table. Every page that lists a user then copies the same link, instead of formatting the ID and name again.
+     *
+     *  Parameters:
+     *      const uint64_t* linkOffsets:
+     *          numNames + 1 offsets into linkData. The link of the user with the 0-based index i is the characters
+     *          [linkOffsets[i], linkOffsets[i + 1]) of linkData.
+     *
+     *      const char* linkData:
+     *          The characters of every link
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    this->linkOffsets = linkOffsets;
+    this->linkData = linkData;
+}
+
+void NameTable::appendLink(PageBuffer& page, size_t i) const {
+    /*
+     *  Adds the list item that links to the page of the user with the 0-based index i to the end of page, as seen from
+     *  a user page (see OutputLayout::appendLink). If a link table is used, the link is copied straight from it.
+     *  ASSERTS that i is a valid index
+     *
+     *  Parameters:
+     *      PageBuffer& page:
+     *          The buffer to add the link to
+     *
+     *      size_t i:
+     *          The 0-based index of the user
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    assert(i < numNames);
+    if (linkOffsets != nullptr) {
+        page.append(string_view(linkData + linkOffsets[i], static_cast<size_t>(linkOffsets[i + 1] - linkOffsets[i])));
+    }
+    else {
+        getLayout().appendLink(page, getId(i), getName(i), false);
+    }
+}
+
+void NameTable::appendRootLink(PageBuffer& page, size_t i) const {
+    /*
+     *  Adds the list item that links to the page of the user with the 0-based index i to the end of page, as seen from
+     *  index.html. The link table holds the links as seen from a user page, which only differ by the relative path back
+     *  to index.html at the start of the link, so a cached link is copied without that path.
+     *  ASSERTS that i is a valid index
+     *
+     *  Parameters:
+     *      PageBuffer& page:
+     *          The buffer to add the link to
+     *
+     *      size_t i:
+     *          The 0-based index of the user
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    assert(i < numNames);
+    if (linkOffsets != nullptr) {
+        static const string_view LINK_START = R"(<li><a href=")";
+        size_t skipped = LINK_START.size() + getLayout().getRootPrefix().size();
+        string_view link(linkData + linkOffsets[i], static_cast<size_t>(linkOffsets[i + 1] - linkOffsets[i]));
+        page.append(LINK_START);
+        page.append(link.substr(skipped));
+    }
+    else {
+        getLayout().appendLink(page, getId(i), getName(i), true);
+    }
+}
@@ -0,0 +1,90 @@
+/** *************************************************************
+ *  Declaration of the NameTable class                          *
+ *  @author Brandon Dale                                        *
+ *                                                              *
+ *  A read-only view of the name of every user of a social      *
+ *  network, indexed by the 0-based index of the user. It views *
+ *  either an array of string_views held in memory, or a        *
+ *  contiguous table of offsets and characters (such as one     *
+ *  that is memory mapped from a file), so pages can be created *
+ *  the same way whether or not every name fits in memory.      *
+ *  It also maps each index to the user's ID in the input file  *
+ *  (which is what pages are named and linked by), when those   *
+ *  IDs are not simply 1 to the number of users. A table of the *
+ *  rendered link to every user (see LinkTable) can be attached, *
+ *  so that pages copy each link instead of formatting it, as   *
+ *  well as the layout that decides where each page is.         *
+ *                                                              *
+ *  @file NameTable.h                                           *
+ *  @date October 14th, 2026                                    *
+ ***************************************************************/
+
+
+#ifndef CS315_PROJECT01_NAMETABLE_H
+#define CS315_PROJECT01_NAMETABLE_H
+
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "PageBuffer.h"
+#include "OutputLayout.h"
+
+
+class NameTable {
+public:
+    // ------------------------------------------------ Constructors ------------------------------------------------ //
+    // Default Constructor - Creates a table with no names
+    NameTable();
+
+    // Views a vector of names, which must outlive the table. If externalIds is given, externalIds[i] is the ID of the
+    // user with the 0-based index i (and must outlive the table too). Otherwise the ID of that user is i + 1.
+    explicit NameTable(const std::vector<std::string_view>& names, const uint64_t* externalIds = nullptr);
+
+    // Views a contiguous table, where name i is the characters [offsets[i], offsets[i + 1]) of data
+    NameTable(std::size_t numNames, const uint64_t* offsets, const char* data);
+
+
+    // ----------------------------------------------- Public Methods ----------------------------------------------- //
+    // Returns the number of names in the table
+    std::size_t size() const;
+
+    // Returns the name of the user with the 0-based index i
+    std::string_view getName(std::size_t i) const;
+
+    // Returns the ID (as written in the input file) of the user with the 0-based index i, used to name their page
+    uint64_t getId(std::size_t i) const;
+
+    // Uses a layout (which must outlive the table) for the pages of the users, instead of putting every page next to
+    // index.html
+    void setLayout(const OutputLayout* layout);
+
+    // Returns the layout of the pages of the users
+    const OutputLayout& getLayout() const;
+
+    // Uses a table of the rendered link to every user (as seen from a user page, see OutputLayout::appendLink), where
+    // the link of the user with the 0-based index i is the characters [linkOffsets[i], linkOffsets[i + 1]) of linkData.
+    // The table must outlive this one.
+    void setLinks(const uint64_t* linkOffsets, const char* linkData);
+
+    // Adds the list item that links to the page of the user with the 0-based index i to the end of page, as seen from
+    // a user page. The link is copied from the link table if there is one, and formatted otherwise.
+    void appendLink(PageBuffer& page, std::size_t i) const;
+
+    // Adds the same list item as appendLink, but as seen from index.html
+    void appendRootLink(PageBuffer& page, std::size_t i) const;
+
+private:
+    // -------------------------------------------- Private Data Members -------------------------------------------- //
+    std::size_t numNames;
+    const std::string_view* names;  // the viewed names, or nullptr if the table is contiguous
+    const uint64_t* offsets;        // numNames + 1 offsets into data (for a contiguous table)
+    const char* data;
+    const uint64_t* externalIds;    // the ID of every user, or nullptr if the ID of the user with index i is i + 1
+    const uint64_t* linkOffsets;    // numNames + 1 offsets into linkData, or nullptr if the links are not cached
+    const char* linkData;
+    const OutputLayout* layout;     // the layout of the pages, or nullptr to put every page next to index.html
+};
+
+
+#endif //CS315_PROJECT01_NAMETABLE_H
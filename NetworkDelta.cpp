@@ -0,0 +1,226 @@
+/** ****************************************************************
+ *  Implementation of the NetworkDelta class                       *
+ *  @author Brandon Dale                                           *
+ *                                                                 *
+ *  @file NetworkDelta.cpp                                         *
+ *  @date October 14th, 2026                                       *
+ ******************************************************************/
+
+
+#include "NetworkDelta.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <utility>
+
+using namespace std;
+
+
+// -------------------------------------------------- CONSTRUCTORS -------------------------------------------------- //
+
+NetworkDelta::NetworkDelta() {
+    /*
+     *  The default constructor of a NetworkDelta object. Creates a delta with no changes.
+     *
+     *  Parameters:
+     *      Takes no parameters
+     *
+     *  Returns:
+     *      No return value, creates a NetworkDelta object
+     */
+}
+
+
+// ------------------------------------------------ PUBLIC METHODS -------------------------------------------------- //
+
+void NetworkDelta::follow(uint64_t followerId, uint64_t followedId) {
+    /*
+     *  Adds a change to the end of the delta, where one user starts following another
+     *
+     *  Parameters:
+     *      uint64_t followerId:
+     *          The ID (in the input file) of the user who follows
+     *
+     *      uint64_t followedId:
+     *          The ID (in the input file) of the user who is followed
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    changes.push_back({FOLLOW, followerId, followedId, string()});
+}
+
+void NetworkDelta::unfollow(uint64_t followerId, uint64_t followedId) {
+    /*
+     *  Adds a change to the end of the delta, where one user stops following another
+     *
+     *  Parameters:
+     *      uint64_t followerId:
+     *          The ID (in the input file) of the user who no longer follows
+     *
+     *      uint64_t followedId:
+     *          The ID (in the input file) of the user who is no longer followed
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    changes.push_back({UNFOLLOW, followerId, followedId, string()});
+}
+
+void NetworkDelta::addUser(uint64_t id, string_view name) {
+    /*
+     *  Adds a change to the end of the delta, where a new user (who follows nobody yet) joins the network. The user
+     *  has no location or picture.
+     *
+     *  Parameters:
+     *      uint64_t id:
+     *          The ID of the new user, which must be larger than the ID of every user already in the network
+     *
+     *      string_view name:
+     *          The name of the new user
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    changes.push_back({ADD_USER, id, 0, string(name)});
+}
+
+void NetworkDelta::rename(uint64_t id, string_view name) {
+    /*
+     *  Adds a change to the end of the delta, where a user changes their name
+     *
+     *  Parameters:
+     *      uint64_t id:
+     *          The ID (in the input file) of the user
+     *
+     *      string_view name:
+     *          The new name of the user
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    changes.push_back({RENAME, id, 0, string(name)});
+}
+
+bool NetworkDelta::load(const string& filename, string& error) {
+    /*
+     *  Adds every change in a delta file (see NetworkDelta.h for the format) to the end of the delta. Every line is
+     *  checked before any change is added, so a file with an invalid line adds nothing.
+     *
+     *  Parameters:
+     *      const string& filename:
+     *          The name of the delta file
+     *
+     *      string& error:
+     *          Set to the reason that the file could not be loaded, if it could not
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if every change in the file was added.
+     *          Otherwise, returns false.
+     */
+
+    MappedFile file(filename);
+    if (!file.isOpen()) {
+        error = "COULD NOT OPEN " + filename;
+        return false;
+    }
+
+    vector<Change> fileChanges;
+    string_view contents = file.getContents();
+    size_t lineNumber = 0;
+    while (!contents.empty()) {
+        size_t lineEnd = min(contents.find('\n'), contents.size());
+        string_view line = contents.substr(0, lineEnd);
+        contents.remove_prefix(min(lineEnd + 1, contents.size()));
+        lineNumber++;
+
+        // Split off the kind of change, skipping empty lines and comments
+        const size_t typeBegin = line.find_first_not_of(" \t\r");
+        if (typeBegin == string_view::npos || line[typeBegin] == '#') continue;
+        const size_t typeEnd = min(line.find_first_of(" \t\r", typeBegin), line.size());
+        const string_view type = line.substr(typeBegin, typeEnd - typeBegin);
+        line.remove_prefix(typeEnd);
+
+        Change change{FOLLOW, 0, 0, string()};
+        bool valid = nextNumber(line, change.userId);
+        if (type == "follow" || type == "unfollow") {
+            change.type = type == "follow" ? FOLLOW : UNFOLLOW;
+            valid = valid && nextNumber(line, change.otherId) && line.find_first_not_of(" \t\r") == string_view::npos;
+        }
+        else if (type == "add-user" || type == "rename") {
+            change.type = type == "add-user" ? ADD_USER : RENAME;
+            const size_t nameBegin = line.find_first_not_of(" \t");
+            const size_t nameEnd = line.find_last_not_of(" \t\r");
+            valid = valid && nameBegin != string_view::npos;
+            if (valid) change.name = string(line.substr(nameBegin, nameEnd + 1 - nameBegin));
+        }
+        else {
+            error = "LINE " + to_string(lineNumber) + " OF " + filename + " HAS THE UNKNOWN CHANGE " + string(type);
+            return false;
+        }
+
+        if (!valid) {
+            error = "LINE " + to_string(lineNumber) + " OF " + filename + " IS NOT A VALID " + string(type) + " CHANGE";
+            return false;
+        }
+        fileChanges.push_back(move(change));
+    }
+
+    changes.insert(changes.end(), make_move_iterator(fileChanges.begin()), make_move_iterator(fileChanges.end()));
+    return true;
+}
+
+const vector<NetworkDelta::Change>& NetworkDelta::getChanges() const {
+    /*
+     *  Returns every change in the delta
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      const vector<Change>&:
+     *          The changes, in the order that they are applied
+     */
+
+    return changes;
+}
+
+
+// -------------------------------------------- PRIVATE HELPER METHODS ---------------------------------------------- //
+
+bool NetworkDelta::nextNumber(string_view& line, uint64_t& value) {
+    /*
+     *  Reads the next word of a line as a number, and removes it from the line
+     *
+     *  Parameters:
+     *      string_view& line:
+     *          The rest of the line
+     *
+     *      uint64_t& value:
+     *          Set to the number, if the next word is one
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if the next word is a number that fits in 64 bits.
+     *          Otherwise, returns false (and neither the line nor value is changed).
+     */
+
+    const size_t begin = line.find_first_not_of(" \t\r");
+    if (begin == string_view::npos) return false;
+    const size_t end = min(line.find_first_of(" \t\r", begin), line.size());
+
+    uint64_t number = 0;
+    for (size_t i = begin; i < end; i++) {
+        const char digit = line[i];
+        if (digit < '0' || digit > '9' || number > (UINT64_MAX - (digit - '0')) / 10) return false;
+        number = 10 * number + (digit - '0');
+    }
+
+    value = number;
+    line.remove_prefix(end);
+    return true;
+}
@@ -0,0 +1,81 @@
+/** *************************************************************
+ *  Declaration of the NetworkDelta class                       *
+ *  @author Brandon Dale                                        *
+ *                                                              *
+ *  A batch of changes to a social network (follows, unfollows, *
+ *  new users and renames), applied to a loaded network with    *
+ *  SocialNetwork::applyDelta instead of editing the JSON file  *
+ *  and loading it again. A batch is either built with the      *
+ *  methods below, or loaded from a delta file, which holds one *
+ *  change per line (users are given by their IDs in the input  *
+ *  file, and the name is the rest of the line):                *
+ *                                                              *
+ *      follow FOLLOWER_ID FOLLOWED_ID                          *
+ *      unfollow FOLLOWER_ID FOLLOWED_ID                        *
+ *      add-user ID NAME                                        *
+ *      rename ID NAME                                          *
+ *                                                              *
+ *  Empty lines, and lines that start with #, are skipped.      *
+ *                                                              *
+ *  @file NetworkDelta.h                                        *
+ *  @date October 14th, 2026                                    *
+ ***************************************************************/
+
+
+#ifndef CS315_PROJECT01_NETWORKDELTA_H
+#define CS315_PROJECT01_NETWORKDELTA_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+
+class NetworkDelta {
+public:
+    // The kinds of change in a delta
+    enum ChangeType {
+        FOLLOW,         // userId starts following otherId (nothing changes if they already do)
+        UNFOLLOW,       // userId stops following otherId (nothing changes if they do not)
+        ADD_USER,       // a user with the ID userId, and no follows, is added
+        RENAME          // the user userId is renamed
+    };
+
+    // A single change, in the order that it is applied
+    struct Change {
+        ChangeType type;
+        uint64_t userId;
+        uint64_t otherId;   // the followed user, for FOLLOW and UNFOLLOW
+        std::string name;   // the name of the user, for ADD_USER and RENAME
+    };
+
+    // ------------------------------------------------ Constructors ------------------------------------------------ //
+    // Default Constructor - Creates an empty delta (with no changes)
+    NetworkDelta();
+
+
+    // ----------------------------------------------- Public Methods ----------------------------------------------- //
+    // Adds a change to the end of the delta
+    void follow(uint64_t followerId, uint64_t followedId);
+    void unfollow(uint64_t followerId, uint64_t followedId);
+    void addUser(uint64_t id, std::string_view name);
+    void rename(uint64_t id, std::string_view name);
+
+    // Adds every change in a delta file to the end of the delta. Returns false if the file could not be read or has an
+    // invalid line (and sets error to the reason), in which case no change of the file is added.
+    bool load(const std::string& filename, std::string& error);
+
+    // Returns every change, in order
+    const std::vector<Change>& getChanges() const;
+
+private:
+    // -------------------------------------------- Private Data Members -------------------------------------------- //
+    std::vector<Change> changes;
+
+    // -----------------------------------------  Private Helper Functions ------------------------------------------ //
+    // Reads the next word of a line as a number. Returns false if there is no next word, or it is not a number.
+    static bool nextNumber(std::string_view& line, uint64_t& value);
+};
+
+
+#endif //CS315_PROJECT01_NETWORKDELTA_H
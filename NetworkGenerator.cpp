@@ -0,0 +1,181 @@
+/** ****************************************************************
+ *  Implementation of the NetworkGenerator class                   *
+ *  @author Brandon Dale                                           *
+ *                                                                 *
+ *  The users are written in a shuffled order, with their          *
+ *  attributes in a shuffled order, like the hand written test     *
+ *  files. Some users have no location, pic_url or follows, and a  *
+ *  follows list can have duplicates and the user themselves.      *
+ *                                                                 *
+ *  @file NetworkGenerator.cpp                                     *
+ *  @date October 14th, 2026                                       *
+ ******************************************************************/
+
+
+#include "NetworkGenerator.h"
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+
+using namespace std;
+
+
+// -------------------------------------------------- CONSTRUCTORS -------------------------------------------------- //
+
+NetworkGenerator::NetworkGenerator(unsigned int numUsers, unsigned int meanFollows, Distribution distribution,
+                                   uint64_t seed) {
+    /*
+     *  Prepares to generate a network. Nothing is generated until generateJSON is called.
+     *
+     *  Parameters:
+     *      unsigned int numUsers:
+     *          The number of users in the network, who get the IDs 1 to numUsers
+     *
+     *      unsigned int meanFollows:
+     *          The average number of users that each user follows
+     *
+     *      Distribution distribution:
+     *          How the follows are distributed between the users
+     *
+     *      uint64_t seed:
+     *          The seed of the random number generator
+     *
+     *  Returns:
+     *      No return value, creates a NetworkGenerator object
+     */
+
+    this->numUsers = numUsers;
+    this->meanFollows = meanFollows;
+    this->distribution = distribution;
+    this->seed = seed;
+}
+
+
+// ------------------------------------------------ PUBLIC METHODS -------------------------------------------------- //
+
+void NetworkGenerator::generateJSON(PageBuffer& out) const {
+    /*
+     *  Renders the whole network as JSON into a buffer.
+     *
+     *  Notes:
+     *      1) With the uniform distribution, each user follows between 0 and 2 * meanFollows users, each chosen
+     *         uniformly from every user.
+     *      2) With the power-law distribution, the number of follows is drawn from a Pareto distribution (with an
+     *         exponent of 2.1, scaled so that its mean is meanFollows), and the followed user is drawn so that the
+     *         popularity of the users falls off as a power of their rank. The ranks are shuffled between the IDs, so
+     *         the popular users are spread across the whole ID range.
+     *
+     *  Parameters:
+     *      PageBuffer& out:
+     *          The buffer to render the JSON into. Its previous contents are removed.
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    static const char* const LOCATIONS[] = {"Oregon", "Minnesota", "California", "Texas", "Ohio", "Maine", "Alaska"};
+    static const char* const PIC_URLS[] = {
+        "https://upload.wikimedia.org/wikipedia/en/0/06/Jorts_the_Cat.jpg",
+        "https://upload.wikimedia.org/wikipedia/commons/thumb/1/18/Vombatus_ursinus_-Maria_Island_National_Park.jpg/"
+        "1200px-Vombatus_ursinus_-Maria_Island_National_Park.jpg",
+        "https://upload.wikimedia.org/wikipedia/commons/3/3a/Cat03.jpg",
+        "https://upload.wikimedia.org/wikipedia/commons/2/26/YellowLabradorLooking_new.jpg"
+    };
+    static const char* const NAMES[] = {"Ruel", "Ramira", "Jorts", "Jean", "Ada", "Linus", "Grace", "Ken", "Barbara"};
+
+    mt19937_64 random(seed);
+    uniform_real_distribution<double> unit(0.0, 1.0);
+
+    // The order that the users are written in, and (for power-law) the ID of the user with each popularity rank
+    vector<unsigned int> order(numUsers);
+    iota(order.begin(), order.end(), 1);
+    shuffle(order.begin(), order.end(), random);
+    vector<unsigned int> byRank(order.rbegin(), order.rend());
+
+    const double exponent = 2.1;
+    const double minFollows = meanFollows * (exponent - 1) / exponent;
+    auto chooseNumFollows = [&]() -> unsigned int {
+        if (distribution == Distribution::UNIFORM) {
+            return uniform_int_distribution<unsigned int>(0, 2 * meanFollows)(random);
+        }
+        double follows = minFollows * pow(1.0 - unit(random), -1.0 / (exponent - 1));
+        return static_cast<unsigned int>(min<double>(follows, numUsers));
+    };
+    auto chooseFollowed = [&]() -> unsigned int {
+        if (distribution == Distribution::UNIFORM) {
+            return uniform_int_distribution<unsigned int>(1, numUsers)(random);
+        }
+        auto rank = static_cast<unsigned int>(numUsers * pow(unit(random), 3.0));
+        return byRank[min(rank, numUsers - 1)];
+    };
+
+    out.clear();
+    out.append("{\n\"users\": [\n");
+    vector<string> attributes;
+    string attribute;
+    for (unsigned int i = 0; i < numUsers; i++) {
+        const unsigned int id = order[i];
+        attributes.clear();
+
+        attribute = R"("id_str" : ")" + to_string(id) + "\"";
+        attributes.push_back(attribute);
+        attribute = R"("name" : ")" + string(NAMES[random() % size(NAMES)]) + " " + to_string(id) + "\"";
+        attributes.push_back(attribute);
+        if (unit(random) < 0.8) {
+            attributes.push_back(R"("location" : ")" + string(LOCATIONS[random() % size(LOCATIONS)]) + "\"");
+        }
+        if (unit(random) < 0.5) {
+            attributes.push_back(R"("pic_url" : ")" + string(PIC_URLS[random() % size(PIC_URLS)]) + "\"");
+        }
+        unsigned int numFollows = chooseNumFollows();
+        if (numFollows > 0) {
+            attribute = R"("follows" : [)";
+            for (unsigned int j = 0; j < numFollows; j++) {
+                if (j > 0) attribute += ",";
+                attribute += "\"" + to_string(chooseFollowed()) + "\"";
+            }
+            attribute += "]";
+            attributes.push_back(attribute);
+        }
+        shuffle(attributes.begin(), attributes.end(), random);
+
+        out.append("\t{\n");
+        for (size_t j = 0; j < attributes.size(); j++) {
+            out.append("\t\t");
+            out.append(attributes[j]);
+            out.append(j + 1 < attributes.size() ? " ,\n" : "\n");
+        }
+        out.append(i + 1 < numUsers ? "\t},\n" : "\t}\n");
+    }
+    out.append("]\n}\n");
+}
+
+bool NetworkGenerator::parseDistribution(const string& name, Distribution& distribution) {
+    /*
+     *  Converts the name of a distribution (as given on the command-line) to a distribution.
+     *
+     *  Parameters:
+     *      const string& name:
+     *          "uniform" or "power-law"
+     *
+     *      Distribution& distribution:
+     *          Set to the distribution with that name
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if name is the name of a distribution.
+     *          Otherwise, returns false (and distribution is not changed).
+     */
+
+    if (name == "uniform") {
+        distribution = Distribution::UNIFORM;
+        return true;
+    }
+    if (name == "power-law") {
+        distribution = Distribution::POWER_LAW;
+        return true;
+    }
+    return false;
+}
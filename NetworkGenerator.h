@@ -0,0 +1,54 @@
+/** *************************************************************
+ *  Declaration of the NetworkGenerator class                   *
+ *  @author Brandon Dale                                        *
+ *                                                              *
+ *  Generates synthetic social networks, in the same "special"  *
+ *  JSON dialect as the files in test_files, for benchmarking.  *
+ *  The number of users, the mean number of follows, and the    *
+ *  distribution of the follows (uniform, or power-law with a   *
+ *  few very popular users) can be chosen. The same seed always *
+ *  generates the same network.                                 *
+ *                                                              *
+ *  @file NetworkGenerator.h                                    *
+ *  @date October 14th, 2026                                    *
+ ***************************************************************/
+
+
+#ifndef CS315_PROJECT01_NETWORKGENERATOR_H
+#define CS315_PROJECT01_NETWORKGENERATOR_H
+
+#include <string>
+#include <cstdint>
+#include "PageBuffer.h"
+
+
+class NetworkGenerator {
+public:
+    // How the number of follows of each user, and the users that they follow, are chosen
+    enum class Distribution {
+        UNIFORM,    // every user follows 0 to 2 * meanFollows users, chosen uniformly
+        POWER_LAW   // the number of follows has a heavy tail, and a few users are followed by many
+    };
+
+    // ------------------------------------------------ Constructors ------------------------------------------------ //
+    // Prepares to generate a network of numUsers users, who follow meanFollows users on average
+    NetworkGenerator(unsigned int numUsers, unsigned int meanFollows, Distribution distribution, uint64_t seed);
+
+
+    // ----------------------------------------------- Public Methods ----------------------------------------------- //
+    // Renders the whole network as JSON into out (replacing its contents)
+    void generateJSON(PageBuffer& out) const;
+
+    // Converts "uniform" or "power-law" to a distribution. Returns false if name is neither.
+    static bool parseDistribution(const std::string& name, Distribution& distribution);
+
+private:
+    // -------------------------------------------- Private Data Members -------------------------------------------- //
+    unsigned int numUsers;
+    unsigned int meanFollows;
+    Distribution distribution;
+    uint64_t seed;
+};
+
+
+#endif //CS315_PROJECT01_NETWORKGENERATOR_H
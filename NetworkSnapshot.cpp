@@ -0,0 +1,604 @@
+/** ****************************************************************
+ *  Implementation of the NetworkSnapshot class                    *
+ *  @author Brandon Dale                                           *
+ *                                                                 *
+ *  A snapshot file has the following layout (native byte order),  *
+ *  with every section starting on an 8 byte boundary:             *
+ *      Header                                                     *
+ *      UserRecord[numUsers]                                       *
+ *      uint64[numUsers + 1]     follows list offsets              *
+ *      uint64[numUsers + 1]     follows index offsets             *
+ *      uint64[numUsers + 1]     followers index offsets           *
+ *      uint32[numFollowsEntries] follows list ids (1-based)       *
+ *      byte[followsIndexBytes]   follows index targets            *
+ *      byte[followersIndexBytes] followers index targets          *
+ *      uint64[numExternalIds]   the ID of each user in the file   *
+ *      char[stringTableSize]    string table                      *
+ *                                                                 *
+ *  The follows lists keep each user's follows in their original   *
+ *  order (as they are shown on the user's page), while the        *
+ *  follows/followers index arrays are the sorted CSR rows. The    *
+ *  targets of a CSR index are uint32[numEdges] (0-based), and     *
+ *  the offsets count targets. The targets of a compressed index   *
+ *  are its CompressedIndex rows, and the offsets count bytes.     *
+ *                                                                 *
+ *  @file NetworkSnapshot.cpp                                      *
+ *  @date October 14th, 2026                                       *
+ ******************************************************************/
+
+
+#include "NetworkSnapshot.h"
+#include <fstream>
+#include <cstring>
+#include <cstdio>
+#include <cassert>
+#include <unordered_map>
+
+using namespace std;
+
+static_assert(sizeof(size_t) == sizeof(uint64_t), "snapshot offsets are mapped directly as size_t");
+static_assert(sizeof(unsigned int) == sizeof(uint32_t), "snapshot ids are mapped directly as unsigned int");
+
+const char NetworkSnapshot::MAGIC[8] = {'S', 'N', 'S', 'N', 'A', 'P', 0, 3};
+
+
+// Returns value rounded up to the next multiple of 8
+static uint64_t alignTo8(uint64_t value) {
+    return (value + 7) & ~static_cast<uint64_t>(7);
+}
+
+
+// -------------------------------------------------- CONSTRUCTORS -------------------------------------------------- //
+
+NetworkSnapshot::NetworkSnapshot(const string& filename) {
+    /*
+     *  Opens a snapshot file by memory mapping it.
+     *
+     *  The header is checked against the magic bytes, the byte order and the size of the file, and then every section
+     *  is located from the sizes in the header. The sections are used in place, so every offset, id and string range
+     *  in them is checked once here (in O(N + E), see checkContents), and a file that fails any check is rejected the
+     *  same way as one with the wrong magic bytes. Nothing is copied.
+     *
+     *  Parameters:
+     *      const string& filename:
+     *          The name of the snapshot file
+     *
+     *  Returns:
+     *      No return value, creates a NetworkSnapshot object
+     */
+
+    valid = false;
+    memset(&header, 0, sizeof(header));
+    userRecords = nullptr;
+    followsListOffsets = nullptr;
+    followsListIds = nullptr;
+    followsIndexOffsets = nullptr;
+    followsIndexData = nullptr;
+    followersIndexOffsets = nullptr;
+    followersIndexData = nullptr;
+    externalIds = nullptr;
+    stringTable = nullptr;
+
+    file = make_shared<MappedFile>(filename);
+    if (!file->isOpen() || file->getSize() < sizeof(Header)) return;
+
+    const char* data = file->getContents().data();
+    memcpy(&header, data, sizeof(Header));
+    if (memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.byteOrderMark != BYTE_ORDER_MARK) return;
+
+    Layout layout = computeLayout(header);
+    if (header.fileSize != file->getSize() || layout.fileSize != file->getSize()) return;
+    if (header.numExternalIds != 0 && header.numExternalIds != header.numUsers) return;
+    if (header.indexFormat != CSR_INDEX && header.indexFormat != COMPRESSED_INDEX) return;
+
+    userRecords = reinterpret_cast<const UserRecord*>(data + layout.userRecords);
+    followsListOffsets = reinterpret_cast<const size_t*>(data + layout.followsListOffsets);
+    followsIndexOffsets = reinterpret_cast<const size_t*>(data + layout.followsIndexOffsets);
+    followersIndexOffsets = reinterpret_cast<const size_t*>(data + layout.followersIndexOffsets);
+    followsListIds = reinterpret_cast<const unsigned int*>(data + layout.followsListIds);
+    followsIndexData = reinterpret_cast<const unsigned char*>(data + layout.followsIndexData);
+    followersIndexData = reinterpret_cast<const unsigned char*>(data + layout.followersIndexData);
+    externalIds = reinterpret_cast<const uint64_t*>(data + layout.externalIds);
+    stringTable = data + layout.stringTable;
+
+    valid = checkContents();
+}
+
+
+// ------------------------------------------------ PUBLIC METHODS -------------------------------------------------- //
+
+bool NetworkSnapshot::isValid() const {
+    /*
+     *  Checks if the snapshot file was opened and is a valid snapshot of the current version
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if the snapshot can be used.
+     *          Otherwise, returns false.
+     */
+
+    return valid;
+}
+
+unsigned int NetworkSnapshot::getNumUsers() const {
+    /*
+     *  Returns the number of users in the snapshot
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      unsigned int:
+     *          The number of users
+     */
+
+    return header.numUsers;
+}
+
+User NetworkSnapshot::getUser(unsigned int i) const {
+    /*
+     *  Creates the User object of the user with the 0-based index i, from their user record, the string table, and
+     *  their follows list. The user's strings are views into the mapped string table, and their follows are a view of
+     *  their mapped follows list (nothing is copied), so they are only valid while the storage returned by
+     *  getStorage() is kept alive.
+     *
+     *  Parameters:
+     *      unsigned int i:
+     *          The 0-based index of the user. ASSERTS that it is valid.
+     *
+     *  Returns:
+     *      User:
+     *          The user object
+     */
+
+    assert(valid && i < header.numUsers);
+    const UserRecord& record = userRecords[i];
+
+    return User(record.id,
+                string_view(stringTable + record.nameOffset, record.nameLength),
+                string_view(stringTable + record.locationOffset, record.locationLength),
+                string_view(stringTable + record.picUrlOffset, record.picUrlLength),
+                IdSpan(followsListIds + followsListOffsets[i], followsListOffsets[i + 1] - followsListOffsets[i]));
+}
+
+shared_ptr<const void> NetworkSnapshot::getStorage() const {
+    /*
+     *  Returns the owner of the mapped file. The strings and follows of every user created by getUser point into the
+     *  mapping, so it must be kept alive for as long as they are used.
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      shared_ptr<const void>:
+     *          The owner of the mapping
+     */
+
+    return file;
+}
+
+vector<uint64_t> NetworkSnapshot::getExternalIds() const {
+    /*
+     *  Returns the ID in the input file of each user. These are only stored when they are not 1 to the number of users.
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      vector<uint64_t>:
+     *          The ID (in the input file) of the user with each 0-based index, or an empty vector if the ID of the user
+     *          with index i is i + 1
+     */
+
+    assert(valid);
+    return vector<uint64_t>(externalIds, externalIds + header.numExternalIds);
+}
+
+bool NetworkSnapshot::hasCompressedIndices() const {
+    /*
+     *  Checks if the follows and followers indices of the snapshot were saved compressed, in which case they are
+     *  returned by getCompressedFollowsIndex and getCompressedFollowersIndex
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if the indices are compressed.
+     *          Otherwise, returns false.
+     */
+
+    assert(valid);
+    return header.indexFormat == COMPRESSED_INDEX;
+}
+
+AdjacencyIndex NetworkSnapshot::getFollowsIndex() const {
+    /*
+     *  Returns the follows index of the snapshot. The index views the arrays inside the mapped file, and keeps the
+     *  mapping alive for as long as it (or any copy of it) exists.
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      AdjacencyIndex:
+     *          The follows index
+     */
+
+    assert(valid && !hasCompressedIndices());
+    return AdjacencyIndex(header.numUsers, header.numEdges, followsIndexOffsets,
+                          reinterpret_cast<const unsigned int*>(followsIndexData), file);
+}
+
+AdjacencyIndex NetworkSnapshot::getFollowersIndex() const {
+    /*
+     *  Returns the followers index of the snapshot. The index views the arrays inside the mapped file, and keeps the
+     *  mapping alive for as long as it (or any copy of it) exists.
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      AdjacencyIndex:
+     *          The followers index
+     */
+
+    assert(valid && !hasCompressedIndices());
+    return AdjacencyIndex(header.numUsers, header.numEdges, followersIndexOffsets,
+                          reinterpret_cast<const unsigned int*>(followersIndexData), file);
+}
+
+CompressedIndex NetworkSnapshot::getCompressedFollowsIndex() const {
+    /*
+     *  Returns the compressed follows index of the snapshot. The index views the arrays inside the mapped file, and
+     *  keeps the mapping alive for as long as it (or any copy of it) exists.
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      CompressedIndex:
+     *          The compressed follows index
+     */
+
+    assert(valid && hasCompressedIndices());
+    return CompressedIndex(header.numUsers, header.numEdges, followsIndexOffsets, followsIndexData, file);
+}
+
+CompressedIndex NetworkSnapshot::getCompressedFollowersIndex() const {
+    /*
+     *  Returns the compressed followers index of the snapshot. The index views the arrays inside the mapped file, and
+     *  keeps the mapping alive for as long as it (or any copy of it) exists.
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      CompressedIndex:
+     *          The compressed followers index
+     */
+
+    assert(valid && hasCompressedIndices());
+    return CompressedIndex(header.numUsers, header.numEdges, followersIndexOffsets, followersIndexData, file);
+}
+
+bool NetworkSnapshot::isSnapshotFile(const string& filename) {
+    /*
+     *  Checks if a file starts with the snapshot magic bytes. This is used to tell snapshots apart from JSON files.
+     *
+     *  Parameters:
+     *      const string& filename:
+     *          The name of the file to check
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if the file starts with the magic bytes of a snapshot (of any version).
+     *          Otherwise, returns false.
+     */
+
+    ifstream in(filename, ios::binary);
+    char magic[sizeof(MAGIC)];
+    if (!in.read(magic, sizeof(magic))) return false;
+
+    // The last byte is the version, which is not compared
+    return memcmp(magic, MAGIC, sizeof(MAGIC) - 1) == 0;
+}
+
+bool NetworkSnapshot::write(const string& filename, const vector<User>& users, const vector<uint64_t>& externalIds,
+                            const AdjacencyIndex& followsIndex, const AdjacencyIndex& followersIndex) {
+    /*
+     *  Writes a snapshot of a social network to a file, with its indices as CSR arrays
+     *
+     *  Parameters:
+     *      const string& filename:
+     *          The name of the snapshot file to write
+     *
+     *      const vector<User>& users:
+     *          The users of the social network, sorted by ID
+     *
+     *      const vector<uint64_t>& externalIds:
+     *          The ID in the input file of each user, or empty if the IDs are 1 to the number of users
+     *
+     *      const AdjacencyIndex& followsIndex:
+     *          The follows index of the social network
+     *
+     *      const AdjacencyIndex& followersIndex:
+     *          The followers index of the social network
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if the snapshot was written.
+     *          Otherwise, returns false.
+     */
+
+    const uint64_t numBytes = followsIndex.getNumEdges() * sizeof(uint32_t);
+    return writeFile(filename, users, externalIds, CSR_INDEX, followsIndex.getNumEdges(),
+                     {followsIndex.getOffsets(), followsIndex.getTargets(), numBytes},
+                     {followersIndex.getOffsets(), followersIndex.getTargets(), numBytes});
+}
+
+bool NetworkSnapshot::write(const string& filename, const vector<User>& users, const vector<uint64_t>& externalIds,
+                            const CompressedIndex& followsIndex, const CompressedIndex& followersIndex) {
+    /*
+     *  Writes a snapshot of a social network to a file, with its indices compressed. The rows are written as they are,
+     *  so a network opened from the snapshot uses them in place without decoding them first.
+     *
+     *  Parameters:
+     *      const string& filename:
+     *          The name of the snapshot file to write
+     *
+     *      const vector<User>& users:
+     *          The users of the social network, sorted by ID
+     *
+     *      const vector<uint64_t>& externalIds:
+     *          The ID in the input file of each user, or empty if the IDs are 1 to the number of users
+     *
+     *      const CompressedIndex& followsIndex:
+     *          The compressed follows index of the social network
+     *
+     *      const CompressedIndex& followersIndex:
+     *          The compressed followers index of the social network
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if the snapshot was written.
+     *          Otherwise, returns false.
+     */
+
+    return writeFile(filename, users, externalIds, COMPRESSED_INDEX, followsIndex.getNumEdges(),
+                     {followsIndex.getOffsets(), followsIndex.getData(), followsIndex.getNumBytes()},
+                     {followersIndex.getOffsets(), followersIndex.getData(), followersIndex.getNumBytes()});
+}
+
+// -------------------------------------------- PRIVATE HELPER METHODS ---------------------------------------------- //
+
+NetworkSnapshot::Layout NetworkSnapshot::computeLayout(const Header& header) {
+    /*
+     *  Returns the offset of every section of a snapshot, given the sizes of the sections in its header.
+     *  Both the writer and the reader use this, so they always agree on where each section is.
+     *
+     *  Parameters:
+     *      const Header& header:
+     *          A header with the numUsers, numFollowsEntries, followsIndexBytes, followersIndexBytes,
+     *          numExternalIds and stringTableSize filled in
+     *
+     *  Returns:
+     *      Layout:
+     *          The byte offset of every section, and the total size of the file
+     */
+
+    uint64_t numOffsets = static_cast<uint64_t>(header.numUsers) + 1;
+
+    Layout layout{};
+    layout.userRecords = alignTo8(sizeof(Header));
+    layout.followsListOffsets = alignTo8(layout.userRecords + header.numUsers * sizeof(UserRecord));
+    layout.followsIndexOffsets = layout.followsListOffsets + numOffsets * sizeof(uint64_t);
+    layout.followersIndexOffsets = layout.followsIndexOffsets + numOffsets * sizeof(uint64_t);
+    layout.followsListIds = layout.followersIndexOffsets + numOffsets * sizeof(uint64_t);
+    layout.followsIndexData = alignTo8(layout.followsListIds + header.numFollowsEntries * sizeof(uint32_t));
+    layout.followersIndexData = alignTo8(layout.followsIndexData + header.followsIndexBytes);
+    layout.externalIds = alignTo8(layout.followersIndexData + header.followersIndexBytes);
+    layout.stringTable = layout.externalIds + header.numExternalIds * sizeof(uint64_t);
+    layout.fileSize = alignTo8(layout.stringTable + header.stringTableSize);
+    return layout;
+}
+
+bool NetworkSnapshot::checkContents() const {
+    /*
+     *  Checks that every array of the mapped file can be used in place, the same way IncrementalState::load checks
+     *  its arrays before using them. The sections themselves were already checked to fit in the file.
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if the user records are numbered 1 to numUsers in order, every string range of them is
+     *          inside the string table, the offset arrays start at 0, never decrease and end at the sizes in the
+     *          header, every id of the follows lists is a user (1-based), every index row is strictly increasing and
+     *          only holds users (0-based), and the external IDs are strictly increasing.
+     *          Otherwise, returns false.
+     */
+
+    const unsigned int n = header.numUsers;
+    const bool compressed = header.indexFormat == COMPRESSED_INDEX;
+
+    // Checks that offsets[0..n] start at 0, never decrease, and end at end
+    auto checkOffsets = [n](const size_t* offsets, uint64_t end) {
+        if (offsets[0] != 0 || offsets[n] != end) return false;
+        for (unsigned int i = 0; i < n; i++) {
+            if (offsets[i] > offsets[i + 1]) return false;
+        }
+        return true;
+    };
+
+    // Checks that the string [offset, offset + length) is inside the string table (without overflowing)
+    auto checkString = [this](uint64_t offset, uint32_t length) {
+        return offset <= header.stringTableSize && length <= header.stringTableSize - offset;
+    };
+
+    for (unsigned int i = 0; i < n; i++) {
+        const UserRecord& record = userRecords[i];
+        if (record.id != i + 1) return false;
+        if (!checkString(record.nameOffset, record.nameLength) ||
+            !checkString(record.locationOffset, record.locationLength) ||
+            !checkString(record.picUrlOffset, record.picUrlLength)) return false;
+    }
+
+    if (!checkOffsets(followsListOffsets, header.numFollowsEntries)) return false;
+    for (uint64_t i = 0; i < header.numFollowsEntries; i++) {
+        if (followsListIds[i] == 0 || followsListIds[i] > n) return false;
+    }
+
+    // The offsets of a CSR index count targets, and those of a compressed index count bytes
+    if (compressed) {
+        if (!checkOffsets(followsIndexOffsets, header.followsIndexBytes) ||
+            !checkOffsets(followersIndexOffsets, header.followersIndexBytes)) return false;
+        const CompressedIndex follows(n, header.numEdges, followsIndexOffsets, followsIndexData, nullptr);
+        const CompressedIndex followers(n, header.numEdges, followersIndexOffsets, followersIndexData, nullptr);
+        if (!follows.isConsistent() || !followers.isConsistent()) return false;
+    }
+    else {
+        if (header.followsIndexBytes != header.numEdges * sizeof(uint32_t) ||
+            header.followersIndexBytes != header.numEdges * sizeof(uint32_t)) return false;
+        if (!checkOffsets(followsIndexOffsets, header.numEdges) ||
+            !checkOffsets(followersIndexOffsets, header.numEdges)) return false;
+
+        // The rows are searched and intersected as sorted sets, so each must be strictly increasing
+        auto checkRows = [n](const size_t* offsets, const unsigned int* targets) {
+            for (unsigned int v = 0; v < n; v++) {
+                for (size_t e = offsets[v]; e < offsets[v + 1]; e++) {
+                    if (targets[e] >= n || (e > offsets[v] && targets[e - 1] >= targets[e])) return false;
+                }
+            }
+            return true;
+        };
+        if (!checkRows(followsIndexOffsets, reinterpret_cast<const unsigned int*>(followsIndexData)) ||
+            !checkRows(followersIndexOffsets, reinterpret_cast<const unsigned int*>(followersIndexData))) return false;
+    }
+
+    for (uint64_t i = 1; i < header.numExternalIds; i++) {
+        if (externalIds[i - 1] >= externalIds[i]) return false;
+    }
+    return true;
+}
+
+bool NetworkSnapshot::writeFile(const string& filename, const vector<User>& users, const vector<uint64_t>& externalIds,
+                                IndexFormat indexFormat, size_t numEdges, const IndexArrays& followsIndex,
+                                const IndexArrays& followersIndex) {
+    /*
+     *  Writes a snapshot of a social network to a file.
+     *
+     *  The string table and the user records are built in memory first, then every section is written in the order
+     *  given at the top of this file. The snapshot is written to a temporary file, which is renamed once it is
+     *  complete, so a reader never maps a partially written snapshot.
+     *
+     *  Parameters:
+     *      const string& filename:
+     *          The name of the snapshot file to write
+     *
+     *      const vector<User>& users:
+     *          The users of the social network, sorted by ID
+     *
+     *      const vector<uint64_t>& externalIds:
+     *          The ID in the input file of each user, or empty if the IDs are 1 to the number of users
+     *
+     *      IndexFormat indexFormat:
+     *          The format of the arrays of both indices
+     *
+     *      size_t numEdges:
+     *          The number of edges in each index
+     *
+     *      const IndexArrays& followsIndex:
+     *          The arrays of the follows index of the social network
+     *
+     *      const IndexArrays& followersIndex:
+     *          The arrays of the followers index of the social network
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if the snapshot was written.
+     *          Otherwise, returns false.
+     */
+
+    // Build the string table, the user records and the follows list offsets. Interned strings share their storage, so
+    // each distinct string is found by its address and only written to the string table once.
+    string strings;
+    unordered_map<const char*, uint64_t> stringOffsets;
+    auto addString = [&strings, &stringOffsets](string_view str) {
+        if (str.empty()) return static_cast<uint64_t>(0);
+        auto existing = stringOffsets.find(str.data());
+        if (existing != stringOffsets.end()) return existing->second;
+        uint64_t offset = strings.size();
+        strings.append(str.data(), str.size());
+        stringOffsets.emplace(str.data(), offset);
+        return offset;
+    };
+
+    vector<UserRecord> records(users.size());
+    vector<uint64_t> listOffsets(users.size() + 1, 0);
+    for (size_t i = 0; i < users.size(); i++) {
+        const User& user = users[i];
+        UserRecord& record = records[i];
+
+        record.id = user.getId();
+        record.nameOffset = addString(user.getName());
+        record.nameLength = user.getName().size();
+        record.locationOffset = addString(user.getLocation());
+        record.locationLength = user.getLocation().size();
+        record.picUrlOffset = addString(user.getPicUrl());
+        record.picUrlLength = user.getPicUrl().size();
+
+        listOffsets[i + 1] = listOffsets[i] + user.getFollowsSize();
+    }
+
+    Header header{};
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.byteOrderMark = BYTE_ORDER_MARK;
+    header.numUsers = users.size();
+    header.numFollowsEntries = listOffsets.back();
+    header.numEdges = numEdges;
+    header.stringTableSize = strings.size();
+    header.numExternalIds = externalIds.size();
+    header.indexFormat = indexFormat;
+    header.followsIndexBytes = followsIndex.numBytes;
+    header.followersIndexBytes = followersIndex.numBytes;
+    Layout layout = computeLayout(header);
+    header.fileSize = layout.fileSize;
+
+    string tempFilename = filename + ".tmp";
+    ofstream out(tempFilename, ios::binary | ios::trunc);
+    if (!out.is_open()) return false;
+
+    // Writes size bytes, and then pads the file with zeros up to the next section
+    auto writeSection = [&out](const void* bytes, size_t size) {
+        static const char padding[8] = {};
+        out.write(static_cast<const char*>(bytes), size);
+        out.write(padding, alignTo8(size) - size);
+    };
+
+    writeSection(&header, sizeof(Header));
+    writeSection(records.data(), records.size() * sizeof(UserRecord));
+    writeSection(listOffsets.data(), listOffsets.size() * sizeof(uint64_t));
+    writeSection(followsIndex.offsets, (users.size() + 1) * sizeof(uint64_t));
+    writeSection(followersIndex.offsets, (users.size() + 1) * sizeof(uint64_t));
+
+    vector<unsigned int> followsList;
+    followsList.reserve(header.numFollowsEntries);
+    for (const User& user : users) {
+        const IdSpan follows = user.getFollows();
+        followsList.insert(followsList.end(), follows.begin(), follows.end());
+    }
+    writeSection(followsList.data(), followsList.size() * sizeof(uint32_t));
+    writeSection(followsIndex.data, followsIndex.numBytes);
+    writeSection(followersIndex.data, followersIndex.numBytes);
+    writeSection(externalIds.data(), externalIds.size() * sizeof(uint64_t));
+    writeSection(strings.data(), strings.size());
+    out.close();
+
+    if (!out) return false;
+    return rename(tempFilename.c_str(), filename.c_str()) == 0;
+}
@@ -0,0 +1,172 @@
+/** *************************************************************
+ *  Declaration of the NetworkSnapshot class                    *
+ *  @author Brandon Dale                                        *
+ *                                                              *
+ *  A versioned binary snapshot of a loaded social network. It  *
+ *  holds a table of user records, a string table for the       *
+ *  names/locations/picture urls, the follows and followers     *
+ *  CSR arrays, and the ID of each user in the input file (if   *
+ *  they are not 1 to the number of users). A snapshot is       *
+ *  opened by memory mapping it, and the CSR arrays are used in *
+ *  place, so opening a snapshot does not parse or copy the     *
+ *  relationships. The indices can also be saved compressed     *
+ *  (see CompressedIndex), and are then used in place the same  *
+ *  way.                                                        *
+ *                                                              *
+ *  @file NetworkSnapshot.h                                     *
+ *  @date October 14th, 2026                                    *
+ ***************************************************************/
+
+
+#ifndef CS315_PROJECT01_NETWORKSNAPSHOT_H
+#define CS315_PROJECT01_NETWORKSNAPSHOT_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include "User.h"
+#include "AdjacencyIndex.h"
+#include "CompressedIndex.h"
+#include "MappedFile.h"
+
+
+class NetworkSnapshot {
+public:
+    // ------------------------------------------------ Constructors ------------------------------------------------ //
+    // Opens (memory maps) a snapshot file. Use isValid() to check that it is a valid snapshot.
+    explicit NetworkSnapshot(const std::string& filename);
+
+
+    // ----------------------------------------------- Public Methods ----------------------------------------------- //
+    // Checks if the snapshot file was opened and is a valid snapshot of the current version
+    bool isValid() const;
+
+    // Returns the number of users in the snapshot
+    unsigned int getNumUsers() const;
+
+    // Creates the User object of the user with the 0-based index i. Its strings view the mapped string table, and its
+    // follows view the mapped follows list.
+    User getUser(unsigned int i) const;
+
+    // Returns the owner of the mapped file, which must be kept alive for as long as the users' strings and follows are
+    // used
+    std::shared_ptr<const void> getStorage() const;
+
+    // Returns the ID in the input file of each user, or an empty vector if the IDs are 1 to the number of users
+    std::vector<uint64_t> getExternalIds() const;
+
+    // Checks if the indices of the snapshot were saved compressed
+    bool hasCompressedIndices() const;
+
+    // Returns the follows/followers index, which views the arrays in the mapped file (nothing is copied). The indices
+    // must not be compressed.
+    AdjacencyIndex getFollowsIndex() const;
+    AdjacencyIndex getFollowersIndex() const;
+
+    // Returns the compressed follows/followers index, which views the arrays in the mapped file (nothing is copied).
+    // The indices must be compressed.
+    CompressedIndex getCompressedFollowsIndex() const;
+    CompressedIndex getCompressedFollowersIndex() const;
+
+    // Checks if a file starts with the snapshot magic bytes (so it is a snapshot rather than a JSON file)
+    static bool isSnapshotFile(const std::string& filename);
+
+    // Writes a snapshot of a social network to a file. Returns false if the file could not be written.
+    static bool write(const std::string& filename, const std::vector<User>& users,
+                      const std::vector<uint64_t>& externalIds, const AdjacencyIndex& followsIndex,
+                      const AdjacencyIndex& followersIndex);
+
+    // Writes a snapshot of a social network, with its indices compressed, to a file. Returns false if the file could
+    // not be written.
+    static bool write(const std::string& filename, const std::vector<User>& users,
+                      const std::vector<uint64_t>& externalIds, const CompressedIndex& followsIndex,
+                      const CompressedIndex& followersIndex);
+
+private:
+    // The ways that the follows and followers indices can be stored
+    enum IndexFormat : uint64_t {
+        CSR_INDEX = 0,                  // uint32 targets, with the offsets counted in targets
+        COMPRESSED_INDEX = 1            // CompressedIndex rows, with the offsets counted in bytes
+    };
+
+    // The arrays of one index to write out
+    struct IndexArrays {
+        const std::size_t* offsets;     // numUsers + 1 entries
+        const void* data;
+        uint64_t numBytes;              // the size of data in bytes
+    };
+
+    // The fixed size header at the start of every snapshot
+    struct Header {
+        char magic[8];                  // "SNSNAP" followed by a 0 byte and the version byte
+        uint32_t byteOrderMark;         // BYTE_ORDER_MARK, in the byte order of the machine that wrote the file
+        uint32_t numUsers;
+        uint64_t numFollowsEntries;     // the total length of every user's follows list (in its original order)
+        uint64_t numEdges;              // the number of edges in the (de-duplicated) follows index
+        uint64_t stringTableSize;
+        uint64_t numExternalIds;        // 0 if the IDs are 1 to numUsers, otherwise numUsers
+        uint64_t fileSize;
+        uint64_t indexFormat;           // an IndexFormat
+        uint64_t followsIndexBytes;     // the size of the targets (or compressed rows) of each index in bytes
+        uint64_t followersIndexBytes;
+    };
+
+    // The record of a single user. The strings are stored in the string table.
+    struct UserRecord {
+        uint32_t id;
+        uint32_t nameLength;
+        uint32_t locationLength;
+        uint32_t picUrlLength;
+        uint64_t nameOffset;
+        uint64_t locationOffset;
+        uint64_t picUrlOffset;
+    };
+
+    // The byte offset of every section of a snapshot file
+    struct Layout {
+        uint64_t userRecords;
+        uint64_t followsListOffsets;
+        uint64_t followsIndexOffsets;
+        uint64_t followersIndexOffsets;
+        uint64_t followsListIds;
+        uint64_t followsIndexData;
+        uint64_t followersIndexData;
+        uint64_t externalIds;
+        uint64_t stringTable;
+        uint64_t fileSize;
+    };
+
+    // -------------------------------------------- Private Data Members -------------------------------------------- //
+    std::shared_ptr<MappedFile> file;
+    bool valid;
+    Header header;
+    const UserRecord* userRecords;
+    const std::size_t* followsListOffsets;
+    const unsigned int* followsListIds;
+    const std::size_t* followsIndexOffsets;
+    const unsigned char* followsIndexData;      // the targets of the index, or its compressed rows
+    const std::size_t* followersIndexOffsets;
+    const unsigned char* followersIndexData;
+    const uint64_t* externalIds;
+    const char* stringTable;
+
+    static const char MAGIC[8];
+    static const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+    // -----------------------------------------  Private Helper Functions ------------------------------------------ //
+    // Returns the offset of every section for a snapshot with the sizes given in header
+    static Layout computeLayout(const Header& header);
+
+    // Checks every array of the mapped file (string ranges, offsets, ids and index rows) before anything is read
+    // through them. Returns false if the snapshot is not consistent.
+    bool checkContents() const;
+
+    // Writes a snapshot with the index arrays given (in the format given) to a file, for both versions of write
+    static bool writeFile(const std::string& filename, const std::vector<User>& users,
+                          const std::vector<uint64_t>& externalIds, IndexFormat indexFormat, std::size_t numEdges,
+                          const IndexArrays& followsIndex, const IndexArrays& followersIndex);
+};
+
+
+#endif //CS315_PROJECT01_NETWORKSNAPSHOT_H
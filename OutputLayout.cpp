@@ -0,0 +1,440 @@
+/** ****************************************************************
+ *  Implementation of the OutputLayout class                       *
+ *  @author Brandon Dale                                           *
+ *                                                                 *
+ *  With L levels, the page of the user with ID N is in            *
+ *  users/D1/.../DL/, where DL is the last two decimal digits of   *
+ *  N, D(L-1) the two before them, and so on (zero padded). So     *
+ *  consecutive IDs are spread over every directory, and each      *
+ *  directory holds about 1 / 100^L of the pages. The continuation *
+ *  pages of the lists of a user are next to the page of the user, *
+ *  and the index pages are all next to index.html.                *
+ *                                                                 *
+ *  @file OutputLayout.cpp                                         *
+ *  @date October 14th, 2026                                       *
+ ******************************************************************/
+
+
+#include "OutputLayout.h"
+#include <cassert>
+#include <cerrno>
+#include <cstdio>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+
+// The directory that holds the levels of page directories
+static const char PAGE_DIRECTORY[] = "users";
+
+// The name of each list in the filenames of its continuation pages, in the order of OutputLayout::UserList
+static const char* const LIST_FILENAMES[OutputLayout::NUM_USER_LISTS] = {
+    "follows", "followers", "mutuals", "suggested"
+};
+
+// Returns 100 to the power of levels
+static uint64_t powerOf100(unsigned int levels) {
+    uint64_t power = 1;
+    for (unsigned int level = 0; level < levels; level++) power *= 100;
+    return power;
+}
+
+
+// -------------------------------------------------- CONSTRUCTORS -------------------------------------------------- //
+
+OutputLayout::OutputLayout(unsigned int shardLevels, size_t listPageSize) {
+    /*
+     *  Creates a layout with a certain number of levels of directories, and a certain number of users per page.
+     *  ASSERTS that there are at most MAX_SHARD_LEVELS levels
+     *
+     *  Parameters:
+     *      unsigned int shardLevels:
+     *          The number of levels of two digit directories under users/. 0 puts every page next to index.html.
+     *
+     *      size_t listPageSize:
+     *          The largest number of users in the list of the index, or in each list of a user page. Longer lists
+     *          continue on further pages. 0 puts every user of a list on one page.
+     *
+     *  Returns:
+     *      No return value, creates an OutputLayout object
+     */
+
+    assert(shardLevels <= MAX_SHARD_LEVELS);
+    this->shardLevels = shardLevels;
+    this->listPageSize = listPageSize;
+    if (shardLevels > 0) {
+        for (unsigned int level = 0; level <= shardLevels; level++) rootPrefix += "../";
+    }
+}
+
+
+// ------------------------------------------------ PUBLIC METHODS -------------------------------------------------- //
+
+unsigned int OutputLayout::getShardLevels() const {
+    /*
+     *  Returns the number of levels of directories
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      unsigned int:
+     *          The number of levels (0 if every page is next to index.html)
+     */
+
+    return shardLevels;
+}
+
+size_t OutputLayout::getListPageSize() const {
+    /*
+     *  Returns the largest number of users in the list of a single page
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      size_t:
+     *          The number of users, or 0 if every user of a list is on one page
+     */
+
+    return listPageSize;
+}
+
+bool OutputLayout::isSameLayout(const OutputLayout& other) const {
+    /*
+     *  Checks if another layout creates exactly the same files, with the same links between them, as this one
+     *
+     *  Parameters:
+     *      const OutputLayout& other:
+     *          The layout to compare with
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if both layouts have the same levels of directories and page size.
+     *          Otherwise, returns false.
+     */
+
+    return shardLevels == other.shardLevels && listPageSize == other.listPageSize;
+}
+
+size_t OutputLayout::getNumListPages(size_t numItems) const {
+    /*
+     *  Returns the number of pages that a list is split over. An empty list still has its (first) page.
+     *
+     *  Parameters:
+     *      size_t numItems:
+     *          The number of users in the list
+     *
+     *  Returns:
+     *      size_t:
+     *          The number of pages, at least 1
+     */
+
+    if (listPageSize == 0 || numItems <= listPageSize) return 1;
+    return (numItems + listPageSize - 1) / listPageSize;
+}
+
+string OutputLayout::getIndexFilename(size_t pageNumber) const {
+    /*
+     *  Returns the name of an index page. Every index page is next to index.html.
+     *  ASSERTS that the page number is at least 1
+     *
+     *  Parameters:
+     *      size_t pageNumber:
+     *          The 1-based number of the index page
+     *
+     *  Returns:
+     *      string:
+     *          "index.html" for the first page, otherwise "index_<page number>.html"
+     */
+
+    assert(pageNumber >= 1);
+    if (pageNumber == 1) return "index.html";
+    return "index_" + to_string(pageNumber) + ".html";
+}
+
+string OutputLayout::getPageDirectory(uint64_t id) const {
+    /*
+     *  Returns the directory of the page of a user, relative to index.html
+     *
+     *  Parameters:
+     *      uint64_t id:
+     *          The ID of the user (as written in the input file)
+     *
+     *  Returns:
+     *      string:
+     *          The directory (such as "users/12/34"), or "" if the page is next to index.html
+     */
+
+    if (shardLevels == 0) return string();
+
+    PageBuffer directory(64);
+    appendPageDirectory(directory, id);
+    return string(directory.getContents());
+}
+
+string OutputLayout::getPageFilename(uint64_t id) const {
+    /*
+     *  Returns the name of the page file of a user, without its directory
+     *
+     *  Parameters:
+     *      uint64_t id:
+     *          The ID of the user (as written in the input file)
+     *
+     *  Returns:
+     *      string:
+     *          The name of the file, "user<ID>.html"
+     */
+
+    return "user" + to_string(id) + ".html";
+}
+
+string OutputLayout::getPagePath(uint64_t id) const {
+    /*
+     *  Returns the path of the page of a user, relative to index.html
+     *
+     *  Parameters:
+     *      uint64_t id:
+     *          The ID of the user (as written in the input file)
+     *
+     *  Returns:
+     *      string:
+     *          The path of the file (such as "users/12/34/user1234.html", or "user1234.html" with no levels)
+     */
+
+    if (shardLevels == 0) return getPageFilename(id);
+    return getPageDirectory(id) + "/" + getPageFilename(id);
+}
+
+string OutputLayout::getListPageFilename(uint64_t id, UserList list, size_t pageNumber) const {
+    /*
+     *  Returns the name of a continuation page of a list of a user (the first page of every list is the page of the
+     *  user itself). It is in the same directory as the page of the user.
+     *  ASSERTS that the page number is at least 2
+     *
+     *  Parameters:
+     *      uint64_t id:
+     *          The ID of the user (as written in the input file)
+     *
+     *      UserList list:
+     *          The list that the page continues
+     *
+     *      size_t pageNumber:
+     *          The 1-based number of the page of the list
+     *
+     *  Returns:
+     *      string:
+     *          The name of the file, such as "user1234_followers_2.html"
+     */
+
+    assert(list < NUM_USER_LISTS && pageNumber >= 2);
+    return "user" + to_string(id) + "_" + LIST_FILENAMES[list] + "_" + to_string(pageNumber) + ".html";
+}
+
+string OutputLayout::getListPagePath(uint64_t id, UserList list, size_t pageNumber) const {
+    /*
+     *  Returns the path of a continuation page of a list of a user, relative to index.html
+     *
+     *  Parameters:
+     *      uint64_t id:
+     *          The ID of the user (as written in the input file)
+     *
+     *      UserList list:
+     *          The list that the page continues
+     *
+     *      size_t pageNumber:
+     *          The 1-based number of the page of the list, at least 2
+     *
+     *  Returns:
+     *      string:
+     *          The path of the file (such as "users/12/34/user1234_followers_2.html")
+     */
+
+    if (shardLevels == 0) return getListPageFilename(id, list, pageNumber);
+    return getPageDirectory(id) + "/" + getListPageFilename(id, list, pageNumber);
+}
+
+uint64_t OutputLayout::getDirectoryKey(uint64_t id) const {
+    /*
+     *  Returns a number that is the same for exactly the users whose pages are in the same directory (the digits of the
+     *  ID that the directories are named by). Sorting pages by it groups the pages of each directory together.
+     *
+     *  Parameters:
+     *      uint64_t id:
+     *          The ID of the user (as written in the input file)
+     *
+     *  Returns:
+     *      uint64_t:
+     *          The key of the directory of the page
+     */
+
+    return id % powerOf100(shardLevels);
+}
+
+string_view OutputLayout::getRootPrefix() const {
+    /*
+     *  Returns the relative path from the directory of any user page back to the directory of index.html. Every user
+     *  page is at the same depth, so it is the same for all of them.
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      string_view:
+     *          The prefix (such as "../../../" with 2 levels, or "" with no levels), valid for the lifetime of the
+     *          layout
+     */
+
+    return rootPrefix;
+}
+
+bool OutputLayout::createPageDirectory(uint64_t id) const {
+    /*
+     *  Creates the directory of the page of a user, and each of its parents, if they do not exist
+     *
+     *  Parameters:
+     *      uint64_t id:
+     *          The ID of the user (as written in the input file)
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if the directory exists.
+     *          Otherwise, returns false.
+     */
+
+    if (shardLevels == 0) return true;
+
+    // Create each level, from users/ down to the directory of the page
+    string directory = getPageDirectory(id);
+    for (size_t end = sizeof(PAGE_DIRECTORY) - 1; end <= directory.size(); end += 3) {
+        if (mkdir(directory.substr(0, end).c_str(), 0755) != 0 && errno != EEXIST) return false;
+    }
+    return true;
+}
+
+void OutputLayout::removePageDirectory(uint64_t id) const {
+    /*
+     *  Removes the directory of the page of a user, and each of its parents, if they are empty (such as after the pages
+     *  have moved to a different layout). A directory that still holds a page is left as it is.
+     *
+     *  Parameters:
+     *      uint64_t id:
+     *          The ID of the user (as written in the input file)
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    if (shardLevels == 0) return;
+
+    // Remove each level, from the directory of the page up to users/, stopping at the first one that is not empty
+    string directory = getPageDirectory(id);
+    for (size_t end = directory.size(); end >= sizeof(PAGE_DIRECTORY) - 1; end -= 3) {
+        if (rmdir(directory.substr(0, end).c_str()) != 0) return;
+    }
+}
+
+void OutputLayout::removeListPages(uint64_t id) const {
+    /*
+     *  Removes every continuation page of every list of a user (such as before the lists of the user are re-created,
+     *  as they may now fit on fewer pages). The pages of a list are numbered from 2 with no gaps, so each list stops at
+     *  the first page that does not exist.
+     *
+     *  Parameters:
+     *      uint64_t id:
+     *          The ID of the user (as written in the input file)
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    for (unsigned int list = 0; list < NUM_USER_LISTS; list++) {
+        size_t pageNumber = 2;
+        while (remove(getListPagePath(id, static_cast<UserList>(list), pageNumber).c_str()) == 0) pageNumber++;
+    }
+}
+
+void OutputLayout::removeIndexPages() const {
+    /*
+     *  Removes every index page after the first, stopping at the first page that does not exist (the pages are
+     *  numbered with no gaps)
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    size_t pageNumber = 2;
+    while (remove(getIndexFilename(pageNumber).c_str()) == 0) pageNumber++;
+}
+
+void OutputLayout::appendLink(PageBuffer& page, uint64_t id, string_view name, bool fromRoot) const {
+    /*
+     *  Adds the list item that links to the page of a user to the end of page. The list item is the same in the index
+     *  page and in the follows, followers and mutuals lists, apart from the relative path to the page:
+     *  <li><a href="path/user<ID>.html"><name></a></li>
+     *
+     *  Parameters:
+     *      PageBuffer& page:
+     *          The buffer to add the link to
+     *
+     *      uint64_t id:
+     *          The ID of the user (as written in the input file)
+     *
+     *      string_view name:
+     *          The name of the user
+     *
+     *      bool fromRoot:
+     *          Whether the link is on index.html (true), or on a user page (false)
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    page.append(R"(<li><a href=")");
+    if (!fromRoot) page.append(rootPrefix);
+    if (shardLevels > 0) {
+        appendPageDirectory(page, id);
+        page.append("/");
+    }
+    page.append("user");
+    page.append(id);
+    page.append(R"(.html">)");
+    page.append(name);
+    page.append("</a></li>\n");
+}
+
+
+// -------------------------------------------- PRIVATE HELPER METHODS ---------------------------------------------- //
+
+void OutputLayout::appendPageDirectory(PageBuffer& page, uint64_t id) const {
+    /*
+     *  Adds the directory of the page of a user, relative to index.html, to the end of page (see getPageDirectory).
+     *  ASSERTS that there is at least one level of directories
+     *
+     *  Parameters:
+     *      PageBuffer& page:
+     *          The buffer to add the directory to
+     *
+     *      uint64_t id:
+     *          The ID of the user (as written in the input file)
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    assert(shardLevels > 0);
+    page.append(PAGE_DIRECTORY);
+
+    // Each level is named by the next two digits of the ID, ending with the last two
+    uint64_t divisor = powerOf100(shardLevels);
+    for (unsigned int level = 0; level < shardLevels; level++) {
+        divisor /= 100;
+        unsigned int digits = (id / divisor) % 100;
+        const char name[3] = {'/', static_cast<char>('0' + digits / 10), static_cast<char>('0' + digits % 10)};
+        page.append(string_view(name, sizeof(name)));
+    }
+}
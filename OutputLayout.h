@@ -0,0 +1,115 @@
+/** *************************************************************
+ *  Declaration of the OutputLayout class                       *
+ *  @author Brandon Dale                                        *
+ *                                                              *
+ *  Decides where the page of each user is created, and how the *
+ *  pages link to each other. The pages are either all next to  *
+ *  index.html (the original layout), or spread over levels of  *
+ *  two digit directories under users/ (such as                 *
+ *  users/12/34/user1234.html), so no directory holds more than *
+ *  a small share of millions of pages. Links between pages are *
+ *  relative, so the pages can be served from any path. A page  *
+ *  size can also split the index, and each long follows,       *
+ *  followers or mutuals list, over numbered continuation pages *
+ *  (index_2.html, user1234_followers_2.html, ...).             *
+ *                                                              *
+ *  @file OutputLayout.h                                        *
+ *  @date October 14th, 2026                                    *
+ ***************************************************************/
+
+
+#ifndef CS315_PROJECT01_OUTPUTLAYOUT_H
+#define CS315_PROJECT01_OUTPUTLAYOUT_H
+
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <cstddef>
+#include "PageBuffer.h"
+
+
+class OutputLayout {
+public:
+    // The lists of a user page that can continue on further pages
+    enum UserList {
+        FOLLOWS,
+        FOLLOWERS,
+        MUTUALS,
+        SUGGESTED,      // only on the pages of a run with suggestions
+        NUM_USER_LISTS
+    };
+
+    // ------------------------------------------------ Constructors ------------------------------------------------ //
+    // Creates a layout with shardLevels levels of directories (0 puts every page next to index.html), and at most
+    // listPageSize users in the list of each page (0 puts every user of a list on one page)
+    explicit OutputLayout(unsigned int shardLevels = 0, std::size_t listPageSize = 0);
+
+
+    // ----------------------------------------------- Public Methods ----------------------------------------------- //
+    // Returns the number of levels of directories
+    unsigned int getShardLevels() const;
+
+    // Returns the largest number of users in the list of a single page (0 if the lists are not split)
+    std::size_t getListPageSize() const;
+
+    // Checks if another layout creates exactly the same files as this one
+    bool isSameLayout(const OutputLayout& other) const;
+
+    // Returns the number of pages that a list of numItems users is split over (at least 1)
+    std::size_t getNumListPages(std::size_t numItems) const;
+
+    // Returns the name of the index page with a certain (1-based) page number, "index.html" for the first one
+    std::string getIndexFilename(std::size_t pageNumber) const;
+
+    // Returns the directory of the page of a user, relative to index.html ("" if it is next to index.html)
+    std::string getPageDirectory(uint64_t id) const;
+
+    // Returns the name of the page file of a user (without its directory)
+    std::string getPageFilename(uint64_t id) const;
+
+    // Returns the path of the page of a user, relative to index.html
+    std::string getPagePath(uint64_t id) const;
+
+    // Returns the name of a continuation page (page number 2 or more) of a list of a user, in the directory of the page
+    // of the user: "user<ID>_<list>_<page number>.html"
+    std::string getListPageFilename(uint64_t id, UserList list, std::size_t pageNumber) const;
+
+    // Returns the path of a continuation page of a list of a user, relative to index.html
+    std::string getListPagePath(uint64_t id, UserList list, std::size_t pageNumber) const;
+
+    // Returns a number that is the same for exactly the users whose pages are in the same directory
+    uint64_t getDirectoryKey(uint64_t id) const;
+
+    // Returns the relative path from the directory of any user page back to the directory of index.html
+    std::string_view getRootPrefix() const;
+
+    // Creates the directory of the page of a user (and its parents), if it does not exist. Returns false if it failed.
+    bool createPageDirectory(uint64_t id) const;
+
+    // Removes the directory of the page of a user (and its parents), if they are empty
+    void removePageDirectory(uint64_t id) const;
+
+    // Removes every continuation page of every list of a user, and every index page after the first
+    void removeListPages(uint64_t id) const;
+    void removeIndexPages() const;
+
+    // Adds the list item that links to the page of a user to the end of page, as seen from a user page (or from
+    // index.html, if fromRoot is true): <li><a href="path/user<ID>.html"><name></a></li>
+    void appendLink(PageBuffer& page, uint64_t id, std::string_view name, bool fromRoot) const;
+
+    // The largest number of levels of directories
+    static const unsigned int MAX_SHARD_LEVELS = 4;
+
+private:
+    // -------------------------------------------- Private Data Members -------------------------------------------- //
+    unsigned int shardLevels;
+    std::size_t listPageSize;       // the largest number of users in the list of a page, or 0
+    std::string rootPrefix;         // "../" once for every level, and once for the users directory
+
+    // -----------------------------------------  Private Helper Functions ------------------------------------------ //
+    // Adds the directory of the page of a user (relative to index.html) to the end of page. Needs at least one level.
+    void appendPageDirectory(PageBuffer& page, uint64_t id) const;
+};
+
+
+#endif //CS315_PROJECT01_OUTPUTLAYOUT_H
@@ -0,0 +1,69 @@
+/** *************************************************************
+ *  Declaration of the OutputOptions struct                     *
+ *  @author Brandon Dale                                        *
+ *                                                              *
+ *  Holds the options that control how the HTML files of a      *
+ *  social network are created. The default values create the   *
+ *  same files as the original project.                         *
+ *                                                              *
+ *  @file OutputOptions.h                                       *
+ *  @date October 14th, 2026                                    *
+ ***************************************************************/
+
+
+#ifndef CS315_PROJECT01_OUTPUTOPTIONS_H
+#define CS315_PROJECT01_OUTPUTOPTIONS_H
+
+#include <cstddef>
+#include <string>
+#include "UserOrdering.h"
+#include "PageCompressor.h"
+
+
+struct OutputOptions {
+    // The number of threads used to create the user pages. 0 uses the hardware concurrency.
+    unsigned int numJobs = 0;
+
+    // Only re-create the pages that changed since the previous incremental run (tracked in a state file)
+    bool incremental = false;
+
+    // The number of bytes of memory that the streaming (out-of-core) mode may use. 0 holds the whole network in memory.
+    std::size_t memoryBudget = 0;
+
+    // The number of levels of two digit directories under users/ that the user pages are spread over (see
+    // OutputLayout). 0 creates every page next to index.html.
+    unsigned int shardLevels = 0;
+
+    // The largest number of users listed on the index page, or in each list of a user page. Longer lists continue on
+    // numbered pages (see OutputLayout). 0 puts every user of a list on a single page.
+    std::size_t pageSize = 0;
+
+    // The name of a tar archive to write every page into, instead of creating a file for each page. "" creates files.
+    std::string archiveFilename;
+
+    // The number of friend of friend suggestions listed on each user page (see SuggestionFinder). 0 lists none. The
+    // suggestions of a user depend on users two steps away, so they can not be created incrementally.
+    unsigned int numSuggestions = 0;
+
+    // List the users of the index page by their PageRank (see GraphAnalytics), highest first, instead of by ID. The
+    // ranks depend on every follow, so a ranked index can not be created incrementally.
+    bool rankIndex = false;
+
+    // The number of PageRank iterations run for a ranked index
+    unsigned int pageRankIterations = 20;
+
+    // The order that the users are relabeled in for the analytics of a ranked index, so that connected users are near
+    // each other in memory. It does not change any output (beyond the rounding of the ranks).
+    UserOrdering::Method userOrdering = UserOrdering::ID;
+
+    // The number of batches of rendered pages that can wait for the thread that writes them (see PageQueue). 0 has
+    // every worker write its own pages.
+    std::size_t writeQueueBatches = 0;
+
+    // The formats (the bits of PageCompressor::Format) that every page is written in. GZIP and BROTLI write the page
+    // compressed next to it (userN.html.gz, userN.html.br), and leaving PLAIN out writes only the compressed files.
+    unsigned int pageFormats = PageCompressor::PLAIN;
+};
+
+
+#endif //CS315_PROJECT01_OUTPUTOPTIONS_H
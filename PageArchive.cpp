@@ -0,0 +1,318 @@
+/** ****************************************************************
+ *  Implementation of the PageArchive class                        *
+ *  @author Brandon Dale                                           *
+ *                                                                 *
+ *  The archive is a POSIX ustar file: every page is a 512 byte    *
+ *  header followed by its contents, padded to a multiple of 512   *
+ *  bytes, and the archive ends with two blocks of zeros. It can   *
+ *  be listed and extracted by any tar program.                    *
+ *                                                                 *
+ *  @file PageArchive.cpp                                          *
+ *  @date October 14th, 2026                                       *
+ ******************************************************************/
+
+
+#include "PageArchive.h"
+#include <cassert>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace std;
+
+
+// A block of zeros, used for the padding after the contents of each entry and for the end of the archive
+static const char ZERO_BLOCK[512] = {};
+
+// Writes a number into a header field of width bytes, as width - 1 zero padded octal digits and a 0 byte. A number
+// that is too large for that (such as the size of a file of 8 GB or more) is written in the base-256 form of GNU tar.
+static void writeNumber(char* field, size_t width, uint64_t value) {
+    if (width - 1 >= 22 || value < (uint64_t(1) << (3 * (width - 1)))) {
+        for (size_t i = width - 1; i > 0; i--) {
+            field[i - 1] = static_cast<char>('0' + (value & 7));
+            value >>= 3;
+        }
+        field[width - 1] = '\0';
+        return;
+    }
+
+    memset(field, 0, width);
+    field[0] = static_cast<char>(0x80);
+    for (size_t i = width; i > 1 && value > 0; i--) {
+        field[i - 1] = static_cast<char>(value & 0xff);
+        value >>= 8;
+    }
+}
+
+// Returns the number of bytes of padding after contents of a certain size, up to the end of their last block
+static size_t getPaddingSize(uint64_t size) {
+    return (sizeof(ZERO_BLOCK) - size % sizeof(ZERO_BLOCK)) % sizeof(ZERO_BLOCK);
+}
+
+
+// -------------------------------------------------- CONSTRUCTORS -------------------------------------------------- //
+
+PageArchive::PageArchive(const string& filename) {
+    /*
+     *  Creates an empty archive file, replacing the file if it already exists. Every entry is given the time at which
+     *  the archive was created as its modification time.
+     *
+     *  Parameters:
+     *      const string& filename:
+     *          The name of the archive file to create
+     *
+     *  Returns:
+     *      No return value, creates a PageArchive object
+     */
+
+    fd = open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    archiveSize = 0;
+    modifiedTime = time(nullptr);
+    entryOpen = false;
+    entryHeaderOffset = 0;
+    entrySize = 0;
+}
+
+PageArchive::~PageArchive() {
+    /*
+     *  Closes the archive file, if it is still open
+     *
+     *  Parameters:
+     *      Takes no parameters
+     *
+     *  Returns:
+     *      No return value
+     */
+
+    if (fd >= 0) close(fd);
+}
+
+
+// ------------------------------------------------ PUBLIC METHODS -------------------------------------------------- //
+
+bool PageArchive::isOpen() const {
+    /*
+     *  Checks if the archive file was created (and has not been finished yet)
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if entries can be written to the archive.
+     *          Otherwise, returns false.
+     */
+
+    return fd >= 0;
+}
+
+void PageArchive::appendEntry(PageBuffer& entries, string_view path, string_view contents) const {
+    /*
+     *  Adds a whole file entry to the end of a batch of entries: the header of the file, its contents, and the padding
+     *  up to the end of its last block. Nothing is written to the archive until the batch is passed to write, so each
+     *  worker can fill a batch of its own without locking.
+     *
+     *  Parameters:
+     *      PageBuffer& entries:
+     *          The batch to add the entry to
+     *
+     *      string_view path:
+     *          The path of the file in the archive (such as "index.html" or "users/12/34/user1234.html")
+     *
+     *      string_view contents:
+     *          The contents of the file
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    char header[BLOCK_SIZE];
+    formatHeader(header, path, contents.size());
+    entries.append(string_view(header, BLOCK_SIZE));
+    entries.append(contents);
+    entries.append(string_view(ZERO_BLOCK, getPaddingSize(contents.size())));
+}
+
+bool PageArchive::write(const PageBuffer& entries) {
+    /*
+     *  Writes a batch of whole entries (made by appendEntry) to the end of the archive, with a single write. Each batch
+     *  is written while holding a lock, so the batches of different workers are never interleaved.
+     *  ASSERTS that no entry started by beginEntry is open
+     *
+     *  Parameters:
+     *      const PageBuffer& entries:
+     *          The batch of entries to write
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if the whole batch was written.
+     *          Otherwise, returns false.
+     */
+
+    lock_guard<mutex> lock(writeMutex);
+    assert(!entryOpen);
+    if (fd < 0 || !entries.writeAll(fd)) return false;
+    archiveSize += entries.getSize();
+    return true;
+}
+
+bool PageArchive::beginEntry(string_view path) {
+    /*
+     *  Starts a file entry whose contents are then written in pieces with writeToEntry, so that a file that is too
+     *  large to hold in memory (such as the index page of a huge network) can still be added. The size of the file is
+     *  not known yet, so the header is written with a size of 0, and is re-written by endEntry.
+     *  ASSERTS that no other entry is open
+     *
+     *  Parameters:
+     *      string_view path:
+     *          The path of the file in the archive
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if the header was written.
+     *          Otherwise, returns false.
+     */
+
+    lock_guard<mutex> lock(writeMutex);
+    assert(!entryOpen);
+    if (fd < 0) return false;
+
+    char header[BLOCK_SIZE];
+    formatHeader(header, path, 0);
+    PageBuffer block(BLOCK_SIZE);
+    block.append(string_view(header, BLOCK_SIZE));
+    if (!block.writeAll(fd)) return false;
+
+    entryOpen = true;
+    entryHeaderOffset = archiveSize;
+    entryPath = string(path);
+    entrySize = 0;
+    archiveSize += BLOCK_SIZE;
+    return true;
+}
+
+bool PageArchive::writeToEntry(const PageBuffer& contents) {
+    /*
+     *  Adds the next piece of the contents of the entry started by beginEntry
+     *  ASSERTS that an entry is open
+     *
+     *  Parameters:
+     *      const PageBuffer& contents:
+     *          The next piece of the contents of the file
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if the whole piece was written.
+     *          Otherwise, returns false.
+     */
+
+    lock_guard<mutex> lock(writeMutex);
+    assert(entryOpen);
+    if (fd < 0 || !contents.writeAll(fd)) return false;
+    entrySize += contents.getSize();
+    archiveSize += contents.getSize();
+    return true;
+}
+
+bool PageArchive::endEntry() {
+    /*
+     *  Ends the entry started by beginEntry: pads its contents to the end of their last block, and re-writes its header
+     *  with the final size of the file
+     *  ASSERTS that an entry is open
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if the entry was completed.
+     *          Otherwise, returns false.
+     */
+
+    lock_guard<mutex> lock(writeMutex);
+    assert(entryOpen);
+    entryOpen = false;
+    if (fd < 0) return false;
+
+    PageBuffer padding(BLOCK_SIZE);
+    padding.append(string_view(ZERO_BLOCK, getPaddingSize(entrySize)));
+    if (!padding.writeAll(fd)) return false;
+    archiveSize += padding.getSize();
+
+    char header[BLOCK_SIZE];
+    formatHeader(header, entryPath, entrySize);
+    return pwrite(fd, header, BLOCK_SIZE, entryHeaderOffset) == static_cast<ssize_t>(BLOCK_SIZE);
+}
+
+bool PageArchive::finish() {
+    /*
+     *  Writes the end of archive marker (two blocks of zeros) and closes the file. No entries can be written after.
+     *  ASSERTS that no entry is open
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if the whole archive was written and closed.
+     *          Otherwise, returns false.
+     */
+
+    lock_guard<mutex> lock(writeMutex);
+    assert(!entryOpen);
+    if (fd < 0) return false;
+
+    PageBuffer marker(2 * BLOCK_SIZE);
+    marker.append(string_view(ZERO_BLOCK, BLOCK_SIZE));
+    marker.append(string_view(ZERO_BLOCK, BLOCK_SIZE));
+    bool written = marker.writeAll(fd);
+    archiveSize += marker.getSize();
+
+    bool closed = close(fd) == 0;
+    fd = -1;
+    return written && closed;
+}
+
+
+// -------------------------------------------- PRIVATE HELPER METHODS ---------------------------------------------- //
+
+void PageArchive::formatHeader(char header[BLOCK_SIZE], string_view path, uint64_t size) const {
+    /*
+     *  Fills a block with the ustar header of a regular file, readable by the owner and everyone else (0644), and owned
+     *  by user and group 0.
+     *  ASSERTS that the path fits in the name field of the header
+     *
+     *  Parameters:
+     *      char header[BLOCK_SIZE]:
+     *          The block to fill
+     *
+     *      string_view path:
+     *          The path of the file in the archive
+     *
+     *      uint64_t size:
+     *          The size of the contents of the file
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    // The pages of every layout have short paths, so the prefix field of the header is never needed
+    assert(!path.empty() && path.size() <= 100);
+
+    memset(header, 0, BLOCK_SIZE);
+    memcpy(header, path.data(), path.size());           // name
+    writeNumber(header + 100, 8, 0644);                 // mode
+    writeNumber(header + 108, 8, 0);                    // uid
+    writeNumber(header + 116, 8, 0);                    // gid
+    writeNumber(header + 124, 12, size);                // size
+    writeNumber(header + 136, 12, modifiedTime);        // mtime
+    header[156] = '0';                                  // typeflag (a regular file)
+    memcpy(header + 257, "ustar", 6);                   // magic
+    memcpy(header + 263, "00", 2);                      // version
+
+    // The checksum is the sum of every byte of the header, counting the checksum field itself as spaces
+    memset(header + 148, ' ', 8);
+    unsigned int checksum = 0;
+    for (size_t i = 0; i < BLOCK_SIZE; i++) checksum += static_cast<unsigned char>(header[i]);
+    writeNumber(header + 148, 7, checksum);
+}
@@ -0,0 +1,81 @@
+/** *************************************************************
+ *  Declaration of the PageArchive class                        *
+ *  @author Brandon Dale                                        *
+ *                                                              *
+ *  Writes the HTML pages of a social network into a single tar *
+ *  (ustar) archive rather than a file per page, so creating    *
+ *  millions of pages is one large sequential write instead of  *
+ *  millions of small file creations. Each worker formats its   *
+ *  pages into a batch of its own, and the batches are appended *
+ *  to the archive whole, so the workers only take the lock     *
+ *  once per batch.                                             *
+ *                                                              *
+ *  @file PageArchive.h                                         *
+ *  @date October 14th, 2026                                    *
+ ***************************************************************/
+
+
+#ifndef CS315_PROJECT01_PAGEARCHIVE_H
+#define CS315_PROJECT01_PAGEARCHIVE_H
+
+#include <string>
+#include <string_view>
+#include <mutex>
+#include <cstdint>
+#include <ctime>
+#include "PageBuffer.h"
+
+
+class PageArchive {
+public:
+    // ------------------------------------------------ Constructors ------------------------------------------------ //
+    // Creates (or replaces) an empty archive file. Use isOpen() to check that it was created.
+    explicit PageArchive(const std::string& filename);
+
+    // The archive owns its open file, so it can not be copied
+    PageArchive(const PageArchive&) = delete;
+    PageArchive& operator=(const PageArchive&) = delete;
+
+    // Closes the archive file (without finishing it, if finish was not called)
+    ~PageArchive();
+
+
+    // ----------------------------------------------- Public Methods ----------------------------------------------- //
+    // Checks if the archive file was created
+    bool isOpen() const;
+
+    // Adds a whole file entry (its header, contents and padding) to the end of a batch of entries
+    void appendEntry(PageBuffer& entries, std::string_view path, std::string_view contents) const;
+
+    // Writes a batch of whole entries to the end of the archive. Safe to call from many threads at once.
+    bool write(const PageBuffer& entries);
+
+    // Starts a file entry whose contents are written in pieces (with writeToEntry), for a file too large to hold in
+    // memory. No other entry may be written until it is ended with endEntry.
+    bool beginEntry(std::string_view path);
+    bool writeToEntry(const PageBuffer& contents);
+    bool endEntry();
+
+    // Writes the end of archive marker and closes the file. Returns false if the archive could not be written.
+    bool finish();
+
+private:
+    // -------------------------------------------- Private Data Members -------------------------------------------- //
+    int fd;                         // the archive file, or -1
+    std::mutex writeMutex;          // held while a batch is written, so batches are never interleaved
+    uint64_t archiveSize;           // the number of bytes written so far
+    std::time_t modifiedTime;       // the modification time of every entry (when the archive was created)
+    bool entryOpen;                 // whether an entry started by beginEntry has not been ended yet
+    uint64_t entryHeaderOffset;     // the offset of the header of that entry
+    std::string entryPath;          // the path of that entry
+    uint64_t entrySize;             // the number of bytes of contents written to that entry so far
+
+    static const std::size_t BLOCK_SIZE = 512;
+
+    // -----------------------------------------  Private Helper Functions ------------------------------------------ //
+    // Fills a block with the ustar header of a regular file
+    void formatHeader(char header[BLOCK_SIZE], std::string_view path, uint64_t size) const;
+};
+
+
+#endif //CS315_PROJECT01_PAGEARCHIVE_H
@@ -0,0 +1,223 @@
+/** ****************************************************************
+ *  Implementation of the PageBuffer class                         *
+ *  @author Brandon Dale                                           *
+ *                                                                 *
+ *  Pages are built in memory and then written with one write(2)   *
+ *  call per file, instead of flushing a file stream per line.     *
+ *                                                                 *
+ *  @file PageBuffer.cpp                                           *
+ *  @date October 14th, 2026                                       *
+ ******************************************************************/
+
+
+#include "PageBuffer.h"
+#include "Stats.h"
+#include <charconv>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace std;
+
+
+// -------------------------------------------------- CONSTRUCTORS -------------------------------------------------- //
+
+PageBuffer::PageBuffer(size_t initialCapacity) {
+    /*
+     *  Creates an empty buffer, preallocating room for initialCapacity bytes.
+     *
+     *  Parameters:
+     *      size_t initialCapacity:
+     *          The number of bytes to preallocate. Should be around the size of a typical page.
+     *
+     *  Returns:
+     *      No return value, creates a PageBuffer object
+     */
+
+    bytes.reserve(initialCapacity);
+}
+
+
+// ------------------------------------------------ PUBLIC METHODS -------------------------------------------------- //
+
+void PageBuffer::clear() {
+    /*
+     *  Removes the contents of the buffer, but keeps its capacity so that the next page does not need to allocate.
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    bytes.clear();
+}
+
+void PageBuffer::append(string_view str) {
+    /*
+     *  Adds a string to the end of the buffer
+     *
+     *  Parameters:
+     *      string_view str:
+     *          The characters to add
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    bytes.append(str.data(), str.size());
+}
+
+void PageBuffer::append(unsigned long long value) {
+    /*
+     *  Adds the decimal digits of an unsigned integer to the end of the buffer (the same digits that operator<< would
+     *  output for it).
+     *
+     *  Parameters:
+     *      unsigned long long value:
+     *          The integer to add
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    char digits[20];
+    to_chars_result result = to_chars(digits, digits + sizeof(digits), value);
+    bytes.append(digits, result.ptr - digits);
+}
+
+string_view PageBuffer::getContents() const {
+    /*
+     *  Returns the contents of the buffer. The view is only valid until the buffer is next changed.
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      string_view:
+     *          A view of every byte in the buffer
+     */
+
+    return bytes;
+}
+
+size_t PageBuffer::getSize() const {
+    /*
+     *  Returns the number of bytes in the buffer
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      size_t:
+     *          The size of the contents of the buffer
+     */
+
+    return bytes.size();
+}
+
+bool PageBuffer::writeToFile(const string& filename) const {
+    /*
+     *  Writes the contents of the buffer to a file, replacing the file if it already exists.
+     *
+     *  The whole buffer is passed to a single write call. The call is only repeated in the (rare) case that the kernel
+     *  writes fewer bytes than asked for, or is interrupted by a signal.
+     *
+     *  Parameters:
+     *      const string& filename:
+     *          The name of the file to write
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if the whole buffer was written.
+     *          Otherwise, returns false.
+     */
+
+    int fd = open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return false;
+
+    bool written = writeAll(fd);
+    return close(fd) == 0 && written;
+}
+
+bool PageBuffer::writeToFileAt(int directoryFd, const string& filename) const {
+    /*
+     *  Writes the contents of the buffer to a file in an open directory, replacing the file if it already exists.
+     *
+     *  The file is opened relative to the directory (with openat), so the kernel does not look up the path of the
+     *  directory again for every file. Otherwise this is the same as writeToFile.
+     *
+     *  Parameters:
+     *      int directoryFd:
+     *          An open file descriptor of the directory to write the file in
+     *
+     *      const string& filename:
+     *          The name of the file to write, relative to the directory
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if the whole buffer was written.
+     *          Otherwise, returns false.
+     */
+
+    int fd = openat(directoryFd, filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return false;
+
+    bool written = writeAll(fd);
+    return close(fd) == 0 && written;
+}
+
+bool PageBuffer::appendToFile(const string& filename) const {
+    /*
+     *  Adds the contents of the buffer to the end of a file, creating the file if it does not exist.
+     *
+     *  This lets a file that is too large to hold in memory be written in pieces, by filling the buffer, appending it
+     *  and clearing it again. Like writeToFile, the whole buffer is passed to a single write call.
+     *
+     *  Parameters:
+     *      const string& filename:
+     *          The name of the file to add to
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if the whole buffer was written.
+     *          Otherwise, returns false.
+     */
+
+    int fd = open(filename.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+    if (fd < 0) return false;
+
+    bool written = writeAll(fd);
+    return close(fd) == 0 && written;
+}
+
+bool PageBuffer::writeAll(int fd) const {
+    /*
+     *  Writes the whole buffer to an open file, at its current offset, repeating the write call if the kernel writes
+     *  fewer bytes than asked for, or is interrupted by a signal.
+     *
+     *  Parameters:
+     *      int fd:
+     *          The file descriptor to write to
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if the whole buffer was written.
+     *          Otherwise, returns false.
+     */
+
+    Stats::add(Stats::BYTES_WRITTEN, bytes.size());
+    const char* data = bytes.data();
+    size_t remaining = bytes.size();
+    while (remaining > 0) {
+        ssize_t written = write(fd, data, remaining);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += written;
+        remaining -= written;
+    }
+    return true;
+}
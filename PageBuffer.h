@@ -0,0 +1,65 @@
+/** *************************************************************
+ *  Declaration of the PageBuffer class                         *
+ *  @author Brandon Dale                                        *
+ *                                                              *
+ *  A reusable byte buffer that a whole HTML page is rendered   *
+ *  into before it is written to its file with a single write   *
+ *  call. Clearing the buffer keeps its capacity, so a buffer   *
+ *  that is reused for many pages stops allocating once it has  *
+ *  grown to fit the largest page.                              *
+ *                                                              *
+ *  @file PageBuffer.h                                          *
+ *  @date October 14th, 2026                                    *
+ ***************************************************************/
+
+
+#ifndef CS315_PROJECT01_PAGEBUFFER_H
+#define CS315_PROJECT01_PAGEBUFFER_H
+
+#include <string>
+#include <string_view>
+#include <cstddef>
+
+
+class PageBuffer {
+public:
+    // ------------------------------------------------ Constructors ------------------------------------------------ //
+    // Creates an empty buffer with room for initialCapacity bytes
+    explicit PageBuffer(std::size_t initialCapacity = 64 * 1024);
+
+
+    // ----------------------------------------------- Public Methods ----------------------------------------------- //
+    // Removes the contents of the buffer, but keeps its capacity
+    void clear();
+
+    // Adds a string to the end of the buffer
+    void append(std::string_view str);
+
+    // Adds the decimal digits of an unsigned integer to the end of the buffer
+    void append(unsigned long long value);
+
+    // Returns the contents of the buffer
+    std::string_view getContents() const;
+
+    // Returns the number of bytes in the buffer
+    std::size_t getSize() const;
+
+    // Writes the contents of the buffer to a file (replacing it) with a single write. Returns false if it failed.
+    bool writeToFile(const std::string& filename) const;
+
+    // Writes the contents of the buffer to a file in an open directory (replacing it). Returns false if it failed.
+    bool writeToFileAt(int directoryFd, const std::string& filename) const;
+
+    // Adds the contents of the buffer to the end of a file with a single write. Returns false if it failed.
+    bool appendToFile(const std::string& filename) const;
+
+    // Writes the whole buffer to an open file descriptor (such as an archive). Returns false if it failed.
+    bool writeAll(int fd) const;
+
+private:
+    // -------------------------------------------- Private Data Members -------------------------------------------- //
+    std::string bytes;
+};
+
+
+#endif //CS315_PROJECT01_PAGEBUFFER_H
@@ -0,0 +1,253 @@
+/** ****************************************************************
+ *  Implementation of the PageCompressor class                     *
+ *  @author Brandon Dale                                           *
+ *                                                                 *
+ *  The gzip files are written by a single zlib deflate stream     *
+ *  (with a gzip header), which is reset between pages, so its     *
+ *  window and hash tables are only allocated once per worker. A   *
+ *  brotli stream can not be reset, so one is created per page,    *
+ *  with a window sized to the page, and its output is taken       *
+ *  straight from the stream's own buffer.                         *
+ *                                                                 *
+ *  @file PageCompressor.cpp                                       *
+ *  @date October 14th, 2026                                       *
+ ******************************************************************/
+
+
+#include "PageCompressor.h"
+#include <cassert>
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
+
+using namespace std;
+
+const PageCompressor::Format PageCompressor::FORMATS[3] = {PLAIN, GZIP, BROTLI};
+
+
+// -------------------------------------------------- CONSTRUCTORS -------------------------------------------------- //
+
+PageCompressor::PageCompressor() {
+    /*
+     *  Creates a compressor with no streams. The zlib stream is created by the first gzip page, and a brotli stream by
+     *  each brotli page.
+     *
+     *  Parameters:
+     *      Takes no parameters
+     *
+     *  Returns:
+     *      No return value, creates a PageCompressor object
+     */
+
+    format = PLAIN;
+    memset(&gzipStream, 0, sizeof(gzipStream));
+    gzipStreamCreated = false;
+    brotliStream = nullptr;
+}
+
+PageCompressor::~PageCompressor() {
+    /*
+     *  Destructor, frees the zlib and brotli streams, if they were created
+     *
+     *  Parameters:
+     *      Takes no parameters
+     *
+     *  Returns:
+     *      No return value
+     */
+
+    if (gzipStreamCreated) deflateEnd(&gzipStream);
+    if (brotliStream != nullptr) BrotliEncoderDestroyInstance(brotliStream);
+}
+
+
+// ------------------------------------------------ PUBLIC METHODS -------------------------------------------------- //
+
+bool PageCompressor::compressPage(Format format, string_view page, PageBuffer& compressed) {
+    /*
+     *  Compresses a whole page in a format
+     *
+     *  Parameters:
+     *      Format format:
+     *          The format to compress the page in, GZIP or BROTLI
+     *
+     *      string_view page:
+     *          The page to compress
+     *
+     *      PageBuffer& compressed:
+     *          Set to the compressed page (its previous contents are removed)
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if the page was compressed.
+     *          Otherwise, returns false.
+     */
+
+    compressed.clear();
+    begin(format, page.size());
+    return compress(page, compressed, true);
+}
+
+void PageCompressor::begin(Format format, size_t sizeHint) {
+    /*
+     *  Starts compressing a new page in a format. The zlib stream is reset (or created, the first time), and a new
+     *  brotli stream is created (freeing the one of the previous page).
+     *
+     *  A brotli stream allocates (and clears) a window and hash tables of several MB by default, which takes far longer
+     *  than compressing a page of a few KB. Given the size of the page, the window is only made large enough to hold
+     *  it, and the stream sizes its tables to match, which gives the same compressed page.
+     *  ASSERTS that the format is GZIP or BROTLI, and that the streams could be created
+     *
+     *  Parameters:
+     *      Format format:
+     *          The format to compress the page in
+     *
+     *      size_t sizeHint:
+     *          About the number of bytes in the page, or 0 if it is not known
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    assert(format == GZIP || format == BROTLI);
+    this->format = format;
+
+    if (format == GZIP) {
+        // A window of 2^15 bytes, with 16 added to write a gzip header and trailer rather than a zlib one
+        if (!gzipStreamCreated) {
+            int created = deflateInit2(&gzipStream, GZIP_LEVEL, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY);
+            assert(created == Z_OK);
+            gzipStreamCreated = (created == Z_OK);
+        }
+        else {
+            deflateReset(&gzipStream);
+        }
+        return;
+    }
+
+    if (brotliStream != nullptr) BrotliEncoderDestroyInstance(brotliStream);
+    brotliStream = BrotliEncoderCreateInstance(nullptr, nullptr, nullptr);
+    assert(brotliStream != nullptr);
+    BrotliEncoderSetParameter(brotliStream, BROTLI_PARAM_QUALITY, BROTLI_QUALITY);
+    BrotliEncoderSetParameter(brotliStream, BROTLI_PARAM_MODE, BROTLI_MODE_TEXT);
+    if (sizeHint > 0) {
+        // A window of 2^bits bytes holds 2^bits - 16 bytes of the page
+        uint32_t windowBits = BROTLI_MIN_WINDOW_BITS;
+        while (windowBits < BROTLI_DEFAULT_WINDOW && (size_t(1) << windowBits) - 16 < sizeHint) windowBits++;
+        BrotliEncoderSetParameter(brotliStream, BROTLI_PARAM_LGWIN, windowBits);
+        BrotliEncoderSetParameter(brotliStream, BROTLI_PARAM_SIZE_HINT, static_cast<uint32_t>(min(sizeHint,
+                                  size_t(UINT32_MAX))));
+    }
+}
+
+bool PageCompressor::compress(string_view piece, PageBuffer& compressed, bool finish) {
+    /*
+     *  Compresses the next piece of the page started by begin, and adds the bytes that the stream gives back to the end
+     *  of compressed. The streams hold back some of their output until the page is finished, so the compressed bytes
+     *  do not match the pieces one to one.
+     *
+     *  Parameters:
+     *      string_view piece:
+     *          The next part of the page (may be empty)
+     *
+     *      PageBuffer& compressed:
+     *          The buffer to add the compressed bytes to
+     *
+     *      bool finish:
+     *          Whether this is the last piece of the page, which writes out the rest of the compressed page
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if the piece was compressed.
+     *          Otherwise, returns false.
+     */
+
+    if (format == GZIP) {
+        if (!gzipStreamCreated) return false;
+        chunk.resize(CHUNK_SIZE);
+        gzipStream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(piece.data()));
+        gzipStream.avail_in = piece.size();
+
+        // Deflate until every byte of the piece was taken (and, when finishing, until the stream ends)
+        int result = Z_OK;
+        do {
+            gzipStream.next_out = reinterpret_cast<Bytef*>(&chunk[0]);
+            gzipStream.avail_out = CHUNK_SIZE;
+            result = deflate(&gzipStream, finish ? Z_FINISH : Z_NO_FLUSH);
+            if (result == Z_STREAM_ERROR) return false;
+            compressed.append(string_view(chunk.data(), CHUNK_SIZE - gzipStream.avail_out));
+        } while (gzipStream.avail_out == 0 || (finish && result != Z_STREAM_END));
+        return gzipStream.avail_in == 0;
+    }
+
+    if (format != BROTLI || brotliStream == nullptr) return false;
+    const uint8_t* nextIn = reinterpret_cast<const uint8_t*>(piece.data());
+    size_t availableIn = piece.size();
+    const BrotliEncoderOperation operation = finish ? BROTLI_OPERATION_FINISH : BROTLI_OPERATION_PROCESS;
+    while (availableIn > 0 || BrotliEncoderHasMoreOutput(brotliStream) ||
+           (finish && !BrotliEncoderIsFinished(brotliStream))) {
+        // No output buffer is given, so the stream keeps its output, which is then copied out of it
+        size_t availableOut = 0;
+        if (!BrotliEncoderCompressStream(brotliStream, operation, &availableIn, &nextIn, &availableOut, nullptr,
+                                         nullptr)) {
+            return false;
+        }
+        size_t outputSize = 0;
+        const uint8_t* output = BrotliEncoderTakeOutput(brotliStream, &outputSize);
+        compressed.append(string_view(reinterpret_cast<const char*>(output), outputSize));
+    }
+    return true;
+}
+
+const char* PageCompressor::getExtension(Format format) {
+    /*
+     *  Returns the extension that is added to the filename of a page written in a format
+     *
+     *  Parameters:
+     *      Format format:
+     *          The format
+     *
+     *  Returns:
+     *      const char*:
+     *          "" for PLAIN, ".gz" for GZIP, or ".br" for BROTLI
+     */
+
+    switch (format) {
+        case GZIP: return ".gz";
+        case BROTLI: return ".br";
+        default: return "";
+    }
+}
+
+bool PageCompressor::parse(const string& names, unsigned int& formats) {
+    /*
+     *  Finds the formats in a comma separated list of their names, such as "gzip,br"
+     *
+     *  Parameters:
+     *      const string& names:
+     *          The names of the formats ("gzip" or "br")
+     *
+     *      unsigned int& formats:
+     *          Set to the formats (as bits), if every name is a format
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if every name is a format.
+     *          Otherwise, returns false (and formats is not changed).
+     */
+
+    unsigned int found = 0;
+    size_t start = 0;
+    while (start <= names.size()) {
+        size_t end = names.find(',', start);
+        if (end == string::npos) end = names.size();
+        const string name = names.substr(start, end - start);
+        if (name == "gzip") found |= GZIP;
+        else if (name == "br") found |= BROTLI;
+        else return false;
+        start = end + 1;
+    }
+
+    formats = found;
+    return true;
+}
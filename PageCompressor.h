@@ -0,0 +1,90 @@
+/** *************************************************************
+ *  Declaration of the PageCompressor class                     *
+ *  @author Brandon Dale                                        *
+ *                                                              *
+ *  Compresses rendered pages with gzip (zlib) or brotli, so a  *
+ *  static server can send the .gz and .br files as they are,   *
+ *  instead of compressing the page on every request. Each      *
+ *  worker thread keeps a compressor of its own, whose zlib     *
+ *  stream is reset for each page rather than created again.    *
+ *  A page can also be compressed in pieces (begin, then        *
+ *  compress), for a page too large to hold in memory.          *
+ *                                                              *
+ *  @file PageCompressor.h                                      *
+ *  @date October 14th, 2026                                    *
+ ***************************************************************/
+
+
+#ifndef CS315_PROJECT01_PAGECOMPRESSOR_H
+#define CS315_PROJECT01_PAGECOMPRESSOR_H
+
+#include <string>
+#include <string_view>
+#include <cstddef>
+#include <zlib.h>
+#include <brotli/encode.h>
+#include "PageBuffer.h"
+
+
+class PageCompressor {
+public:
+    // The formats that a page can be written in, which are combined as bits (PLAIN | GZIP writes both)
+    enum Format {
+        PLAIN = 1,      // the page itself (userN.html)
+        GZIP = 2,       // gzip (userN.html.gz)
+        BROTLI = 4      // brotli (userN.html.br)
+    };
+
+    // The formats, in the order that the files of a page are written
+    static const Format FORMATS[3];
+
+    // ------------------------------------------------ Constructors ------------------------------------------------ //
+    // Creates a compressor. The zlib stream is created when it is first used.
+    PageCompressor();
+
+    // The compressor owns its zlib and brotli streams, so it can not be copied
+    PageCompressor(const PageCompressor&) = delete;
+    PageCompressor& operator=(const PageCompressor&) = delete;
+
+    // Frees the zlib and brotli streams
+    ~PageCompressor();
+
+
+    // ----------------------------------------------- Public Methods ----------------------------------------------- //
+    // Sets compressed to a whole page compressed in a format (GZIP or BROTLI). Returns false if it failed.
+    bool compressPage(Format format, std::string_view page, PageBuffer& compressed);
+
+    // Starts compressing a page in pieces in a format (GZIP or BROTLI), which ends an unfinished page. If sizeHint is
+    // not 0, it is about the size of the page, which lets brotli allocate a window that fits it.
+    void begin(Format format, std::size_t sizeHint = 0);
+
+    // Compresses the next piece of the page, adding the compressed bytes to the end of compressed. finish ends the
+    // page (the last piece may be empty). Returns false if it failed.
+    bool compress(std::string_view piece, PageBuffer& compressed, bool finish);
+
+    // Returns the extension of the files of a format ("", ".gz" or ".br")
+    static const char* getExtension(Format format);
+
+    // Sets formats to the formats in a comma separated list of names ("gzip", "br"). Returns false if a name is not a
+    // format.
+    static bool parse(const std::string& names, unsigned int& formats);
+
+    // The zlib level (1 to 9) and brotli quality (0 to 11) that pages are compressed with. Each page is compressed
+    // once, and then sent compressed for every request of it, so both are high.
+    static const int GZIP_LEVEL = 9;
+    static const int BROTLI_QUALITY = 9;
+
+private:
+    // -------------------------------------------- Private Data Members -------------------------------------------- //
+    Format format;                          // the format of the page being compressed
+    z_stream gzipStream;
+    bool gzipStreamCreated;                 // whether deflateInit2 was called on gzipStream
+    BrotliEncoderState* brotliStream;       // the stream of the brotli page being compressed, or nullptr
+    std::string chunk;                      // the output of zlib, before it is added to the compressed page
+
+    // The size of chunk
+    static const std::size_t CHUNK_SIZE = 64 * 1024;
+};
+
+
+#endif //CS315_PROJECT01_PAGECOMPRESSOR_H
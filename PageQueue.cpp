@@ -0,0 +1,225 @@
+/** ****************************************************************
+ *  Implementation of the PageQueue class                          *
+ *  @author Brandon Dale                                           *
+ *                                                                 *
+ *  Each page in a batch is an entry header (the ID of the user    *
+ *  and the lengths of the file name and the page) followed by     *
+ *  the file name and the page, so a whole batch is one buffer.    *
+ *                                                                 *
+ *  @file PageQueue.cpp                                            *
+ *  @date October 14th, 2026                                       *
+ ******************************************************************/
+
+
+#include "PageQueue.h"
+#include "Stats.h"
+#include <iostream>
+#include <cstring>
+#include <cstdlib>
+#include <cassert>
+
+using namespace std;
+
+
+// The header of each page in a batch
+struct PageEntryHeader {
+    uint64_t id;
+    uint64_t filenameLength;
+    uint64_t pageLength;
+};
+
+
+// -------------------------------------------------- CONSTRUCTORS -------------------------------------------------- //
+
+PageQueue::PageQueue(const OutputLayout& layout, PageArchive* archive, size_t maxBatches)
+    : layout(layout) {
+    /*
+     *  Creates an empty queue and starts its writer thread
+     *
+     *  Parameters:
+     *      const OutputLayout& layout:
+     *          The layout that decides which directory and file each page is written to, which must outlive the queue
+     *
+     *      PageArchive* archive:
+     *          The archive to add the pages to, or nullptr to create a file for each page
+     *
+     *      size_t maxBatches:
+     *          The largest number of batches that wait in the queue at once (at least 1)
+     *
+     *  Returns:
+     *      No return value, creates a PageQueue object
+     */
+
+    writer.setArchive(archive);
+    this->maxBatches = maxBatches > 0 ? maxBatches : 1;
+    finishing = false;
+    writerThread = thread(&PageQueue::writerLoop, this);
+}
+
+PageQueue::~PageQueue() {
+    /*
+     *  Destructor, writes the batches that are left and stops the writer thread, if finish was not called already.
+     */
+
+    finish();
+}
+
+
+// ------------------------------------------------ PUBLIC METHODS -------------------------------------------------- //
+
+void PageQueue::appendPage(PageBuffer& batch, uint64_t id, const string& filename, string_view page) {
+    /*
+     *  Adds a page to the end of a batch. The batch belongs to the caller, so no locking is done.
+     *
+     *  Parameters:
+     *      PageBuffer& batch:
+     *          The batch to add the page to
+     *
+     *      uint64_t id:
+     *          The ID of the user (as written in the input file) whose directory the file is in
+     *
+     *      const string& filename:
+     *          The name of the file, without its directory
+     *
+     *      string_view page:
+     *          The rendered page
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    PageEntryHeader header = {id, filename.size(), page.size()};
+    batch.append(string_view(reinterpret_cast<const char*>(&header), sizeof(header)));
+    batch.append(filename);
+    batch.append(page);
+}
+
+void PageQueue::push(PageBuffer& batch) {
+    /*
+     *  Adds a batch to the end of the queue, for the writer thread to write. If the queue already holds maxBatches
+     *  batches, this waits until the writer takes one, so the rendering can never get more than maxBatches batches
+     *  ahead of the writing. The batch is swapped with a written one (emptied, but with its capacity kept), so the
+     *  caller can keep filling it without allocating again.
+     *  ASSERTS that the queue was not finished
+     *
+     *  Parameters:
+     *      PageBuffer& batch:
+     *          The batch to write. It is left empty.
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    if (batch.getSize() == 0) return;
+
+    unique_lock<mutex> guard(queueLock);
+    assert(!finishing);
+    if (queued.size() >= maxBatches) {
+        Stats::add(Stats::PAGE_QUEUE_WAITS, 1);
+        batchTaken.wait(guard, [this]() { return queued.size() < maxBatches; });
+    }
+
+    queued.push_back(move(batch));
+    if (spareBatches.empty()) batch = PageBuffer();
+    else {
+        batch = move(spareBatches.back());
+        spareBatches.pop_back();
+    }
+    guard.unlock();
+    batchPushed.notify_one();
+}
+
+void PageQueue::finish() {
+    /*
+     *  Waits until the writer thread has written every batch in the queue (and, with an archive, the pages that it
+     *  collected), and stops it. Does nothing if the queue was already finished.
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    {
+        lock_guard<mutex> guard(queueLock);
+        if (finishing) return;
+        finishing = true;
+    }
+    batchPushed.notify_one();
+    writerThread.join();
+
+    if (!writer.flush()) {
+        cerr << "COULD NOT WRITE THE PAGES TO THE ARCHIVE" << endl;
+        exit(1);
+    }
+}
+
+
+// -------------------------------------------- PRIVATE HELPER METHODS ---------------------------------------------- //
+
+void PageQueue::writerLoop() {
+    /*
+     *  Takes the oldest batch in the queue, writes it (without holding the lock, so batches can still be pushed), and
+     *  keeps it as a spare, until the queue is finished and empty
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    unique_lock<mutex> guard(queueLock);
+    while (true) {
+        batchPushed.wait(guard, [this]() { return !queued.empty() || finishing; });
+        if (queued.empty()) return;
+
+        PageBuffer batch = move(queued.front());
+        queued.pop_front();
+        guard.unlock();
+        batchTaken.notify_one();
+
+        writeBatch(batch);
+        batch.clear();
+
+        guard.lock();
+        if (spareBatches.size() < maxBatches) spareBatches.push_back(move(batch));
+    }
+}
+
+void PageQueue::writeBatch(const PageBuffer& batch) {
+    /*
+     *  Writes every page of a batch with the writer of the queue. Each page is copied into a page buffer of its own
+     *  first, which costs far less than the open and write calls of its file. A page that can not be written ends the
+     *  program, as it does when a worker writes its own pages.
+     *
+     *  Parameters:
+     *      const PageBuffer& batch:
+     *          The batch to write
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    string_view contents = batch.getContents();
+    string filename;
+    size_t position = 0;
+    while (position < contents.size()) {
+        PageEntryHeader header;
+        assert(contents.size() - position >= sizeof(header));
+        memcpy(&header, contents.data() + position, sizeof(header));
+        position += sizeof(header);
+        filename.assign(contents.data() + position, header.filenameLength);
+        position += header.filenameLength;
+        page.clear();
+        page.append(contents.substr(position, header.pageLength));
+        position += header.pageLength;
+
+        if (!writer.writePage(page, layout, header.id, filename)) {
+            string directory = layout.getPageDirectory(header.id);
+            cerr << "COULD NOT WRITE THE PAGE " << (directory.empty() ? filename : directory + "/" + filename) << endl;
+            exit(1);
+        }
+    }
+}
@@ -0,0 +1,91 @@
+/** *************************************************************
+ *  Declaration of the PageQueue class                          *
+ *  @author Brandon Dale                                        *
+ *                                                              *
+ *  A bounded queue of batches of rendered pages, which a       *
+ *  thread of its own writes to their files (or to an archive), *
+ *  so the workers rendering pages do not wait on the file      *
+ *  system. Each worker collects its pages into a batch (see    *
+ *  PageWriter::setQueue) and pushes it once it is full. When   *
+ *  the queue already holds its largest number of batches, a    *
+ *  push waits for the writer to take one, so a slow disk holds *
+ *  back the rendering instead of the memory growing. Written   *
+ *  batches are reused, so the memory of the queue stays flat.  *
+ *                                                              *
+ *  @file PageQueue.h                                           *
+ *  @date October 14th, 2026                                    *
+ ***************************************************************/
+
+
+#ifndef CS315_PROJECT01_PAGEQUEUE_H
+#define CS315_PROJECT01_PAGEQUEUE_H
+
+#include <string>
+#include <string_view>
+#include <deque>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+#include <cstddef>
+#include "PageBuffer.h"
+#include "PageWriter.h"
+#include "OutputLayout.h"
+#include "PageArchive.h"
+
+
+class PageQueue {
+public:
+    // ------------------------------------------------ Constructors ------------------------------------------------ //
+    // Starts the writer thread, which writes the pages into the directories of layout, or into archive if it is not
+    // nullptr. At most maxBatches batches wait in the queue at once.
+    PageQueue(const OutputLayout& layout, PageArchive* archive, std::size_t maxBatches = DEFAULT_MAX_BATCHES);
+
+    // The writer thread belongs to a single queue, so it can not be copied
+    PageQueue(const PageQueue&) = delete;
+    PageQueue& operator=(const PageQueue&) = delete;
+
+    // Writes the batches that are left and stops the writer thread (see finish)
+    ~PageQueue();
+
+
+    // ----------------------------------------------- Public Methods ----------------------------------------------- //
+    // Adds a page, to be written to a file with a certain name in the directory of the user with a certain ID, to the
+    // end of a batch
+    static void appendPage(PageBuffer& batch, uint64_t id, const std::string& filename, std::string_view page);
+
+    // Hands a batch to the writer thread, waiting while the queue is full. batch is left empty.
+    void push(PageBuffer& batch);
+
+    // Waits until every batch has been written, and stops the writer thread
+    void finish();
+
+    // The default largest number of batches waiting in the queue
+    static const std::size_t DEFAULT_MAX_BATCHES = 8;
+
+private:
+    // -------------------------------------------- Private Data Members -------------------------------------------- //
+    const OutputLayout& layout;
+    PageWriter writer;                      // only used by the writer thread
+    PageBuffer page;                        // the page being written, only used by the writer thread
+    std::deque<PageBuffer> queued;          // the batches waiting to be written, oldest first
+    std::vector<PageBuffer> spareBatches;   // written batches, which keep their capacity for the next push
+    std::size_t maxBatches;
+    bool finishing;
+
+    std::mutex queueLock;
+    std::condition_variable batchPushed;
+    std::condition_variable batchTaken;
+    std::thread writerThread;
+
+    // -----------------------------------------  Private Helper Functions ------------------------------------------ //
+    // The main loop of the writer thread, writes each batch that is pushed until the queue is finished
+    void writerLoop();
+
+    // Writes every page of a batch
+    void writeBatch(const PageBuffer& batch);
+};
+
+
+#endif //CS315_PROJECT01_PAGEQUEUE_H
@@ -0,0 +1,266 @@
+/** ****************************************************************
+ *  Implementation of the PageWriter class                         *
+ *  @author Brandon Dale                                           *
+ *                                                                 *
+ *  Each worker has its own writer, so the open directory and the  *
+ *  batch are never shared between threads. A queue is shared, but *
+ *  it only sees whole batches.                                    *
+ *                                                                 *
+ *  @file PageWriter.cpp                                           *
+ *  @date October 14th, 2026                                       *
+ ******************************************************************/
+
+
+#include "PageWriter.h"
+#include "PageQueue.h"
+#include <string>
+#include <cassert>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace std;
+
+
+// -------------------------------------------------- CONSTRUCTORS -------------------------------------------------- //
+
+PageWriter::PageWriter() {
+    /*
+     *  Creates a writer with no open directory, that writes a file for every page. The first page that is written
+     *  opens its directory.
+     *
+     *  Parameters:
+     *      Takes no parameters
+     *
+     *  Returns:
+     *      No return value, creates a PageWriter object
+     */
+
+    directoryFd = -1;
+    directoryKey = 0;
+    archive = nullptr;
+    queue = nullptr;
+    formats = PageCompressor::PLAIN;
+}
+
+PageWriter::~PageWriter() {
+    /*
+     *  Closes the open directory, if there is one
+     *
+     *  Parameters:
+     *      Takes no parameters
+     *
+     *  Returns:
+     *      No return value
+     */
+
+    if (directoryFd >= 0) close(directoryFd);
+}
+
+
+// ------------------------------------------------ PUBLIC METHODS -------------------------------------------------- //
+
+void PageWriter::setArchive(PageArchive* archive) {
+    /*
+     *  Makes the writer add the pages to an archive, rather than write a file for each of them. The pages are collected
+     *  into a batch, so flush must be called once the last page was written.
+     *  ASSERTS that the batch of a previous archive is empty
+     *
+     *  Parameters:
+     *      PageArchive* archive:
+     *          The archive to write the pages to, or nullptr to write a file for each page
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    assert(batch.getSize() == 0);
+    this->archive = archive;
+}
+
+void PageWriter::setQueue(PageQueue* queue) {
+    /*
+     *  Makes the writer collect the pages into a batch, which is pushed to a queue whose own thread writes them (see
+     *  PageQueue), rather than write them itself. flush must be called once the last page was written. A queue takes
+     *  the place of an archive (the queue's thread writes to the archive instead).
+     *  ASSERTS that the batch of a previous archive or queue is empty
+     *
+     *  Parameters:
+     *      PageQueue* queue:
+     *          The queue to hand the pages to, or nullptr to write them again
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    assert(batch.getSize() == 0);
+    this->queue = queue;
+}
+
+void PageWriter::setFormats(unsigned int formats) {
+    /*
+     *  Sets the formats that each page is written in. A page written in GZIP (or BROTLI) is compressed by the writer's
+     *  own compressor, and written to the file of the page with ".gz" (or ".br") added to its name. The writer of a
+     *  queue's thread is given pages that were already compressed, so it only writes PLAIN.
+     *  ASSERTS that there is at least one format
+     *
+     *  Parameters:
+     *      unsigned int formats:
+     *          The formats, as the bits of PageCompressor::Format
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    assert(formats != 0);
+    this->formats = formats;
+}
+
+bool PageWriter::writePage(const PageBuffer& page, const OutputLayout& layout, uint64_t id) {
+    /*
+     *  Writes a page to the file of a user, replacing it if it exists (see the other writePage)
+     *
+     *  Parameters:
+     *      const PageBuffer& page:
+     *          The rendered page
+     *
+     *      const OutputLayout& layout:
+     *          The layout that decides which directory and file the page is written to
+     *
+     *      uint64_t id:
+     *          The ID of the user (as written in the input file)
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if the whole page was written (or added to the batch).
+     *          Otherwise, returns false.
+     */
+
+    return writePage(page, layout, id, layout.getPageFilename(id));
+}
+
+bool PageWriter::writePage(const PageBuffer& page, const OutputLayout& layout, uint64_t id, const string& filename) {
+    /*
+     *  Writes a page to a file in the directory of the page of a user, replacing it if it exists. If the directory is
+     *  different from the one of the previous page, it is opened (and the previous one closed) first. The directory
+     *  must already exist (see OutputLayout::createPageDirectory).
+     *
+     *  If the writer has an archive, the page is instead added to the batch, under its path in the layout, and the
+     *  batch is written to the archive once it holds at least BATCH_SIZE bytes. If it has a queue, the page is added to
+     *  the batch in the same way (under the user ID and the file name), and the batch is pushed to the queue.
+     *
+     *  The page is written once for each of the writer's formats: compressed (with the extension of the format added
+     *  to filename) for GZIP and BROTLI, and as it is for PLAIN.
+     *
+     *  Parameters:
+     *      const PageBuffer& page:
+     *          The rendered page
+     *
+     *      const OutputLayout& layout:
+     *          The layout that decides which directory the page is written to
+     *
+     *      uint64_t id:
+     *          The ID of the user (as written in the input file) whose directory the file is in
+     *
+     *      const string& filename:
+     *          The name of the file, without its directory
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if the whole page was written (or added to the batch) in every format.
+     *          Otherwise, returns false.
+     */
+
+    if (formats == PageCompressor::PLAIN) return writeFile(page, layout, id, filename);
+
+    for (PageCompressor::Format format : PageCompressor::FORMATS) {
+        if ((formats & format) == 0) continue;
+        if (format == PageCompressor::PLAIN) {
+            if (!writeFile(page, layout, id, filename)) return false;
+            continue;
+        }
+        if (!compressor.compressPage(format, page.getContents(), compressedPage) ||
+            !writeFile(compressedPage, layout, id, filename + PageCompressor::getExtension(format))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool PageWriter::flush() {
+    /*
+     *  Writes the pages that are still in the batch to the archive, with a single write, or pushes them to the queue
+     *  (which may wait while the queue is full). Does nothing if the writer has neither, as every page is then written
+     *  as soon as it is given.
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if every page in the batch was written.
+     *          Otherwise, returns false.
+     */
+
+    if (batch.getSize() == 0) return true;
+    if (queue != nullptr) {
+        queue->push(batch);
+        return true;
+    }
+    if (archive == nullptr) return true;
+
+    bool written = archive->write(batch);
+    batch.clear();
+    return written;
+}
+
+
+// -------------------------------------------- PRIVATE HELPER METHODS ---------------------------------------------- //
+
+bool PageWriter::writeFile(const PageBuffer& contents, const OutputLayout& layout, uint64_t id,
+                           const string& filename) {
+    /*
+     *  Writes the contents of one file in the directory of the page of a user, replacing it if it exists: to the open
+     *  directory (opening the directory first, if it is different from the one of the previous file), or to the batch
+     *  of the archive or queue (see writePage).
+     *
+     *  Parameters:
+     *      const PageBuffer& contents:
+     *          The contents of the file
+     *
+     *      const OutputLayout& layout:
+     *          The layout that decides which directory the file is written to
+     *
+     *      uint64_t id:
+     *          The ID of the user (as written in the input file) whose directory the file is in
+     *
+     *      const string& filename:
+     *          The name of the file, without its directory
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if the whole file was written (or added to the batch).
+     *          Otherwise, returns false.
+     */
+
+    if (queue != nullptr) {
+        PageQueue::appendPage(batch, id, filename, contents.getContents());
+        return batch.getSize() < BATCH_SIZE || flush();
+    }
+
+    if (archive != nullptr) {
+        string directory = layout.getPageDirectory(id);
+        archive->appendEntry(batch, directory.empty() ? filename : directory + "/" + filename, contents.getContents());
+        return batch.getSize() < BATCH_SIZE || flush();
+    }
+
+    uint64_t key = layout.getDirectoryKey(id);
+    if (directoryFd < 0 || key != directoryKey) {
+        if (directoryFd >= 0) close(directoryFd);
+        string directory = layout.getPageDirectory(id);
+        directoryFd = open(directory.empty() ? "." : directory.c_str(), O_RDONLY | O_DIRECTORY);
+        directoryKey = key;
+        if (directoryFd < 0) return false;
+    }
+
+    return contents.writeToFileAt(directoryFd, filename);
+}
@@ -0,0 +1,91 @@
+/** *************************************************************
+ *  Declaration of the PageWriter class                         *
+ *  @author Brandon Dale                                        *
+ *                                                              *
+ *  Writes the pages of a single worker thread into the         *
+ *  directories of an output layout. The directory that was     *
+ *  written to last is kept open, and each page is created      *
+ *  relative to it (with openat), so when the pages of each     *
+ *  directory are written together, the path of a directory is  *
+ *  only looked up once rather than once per page. If it is     *
+ *  given an archive, the pages are instead collected into a    *
+ *  batch, which is added to the archive with a single write    *
+ *  once it is large enough. If it is given a page queue, the   *
+ *  batch is instead handed to the writer thread of the queue.  *
+ *  It can also write each page compressed (next to the page,   *
+ *  or instead of it), with a compressor of its own.            *
+ *                                                              *
+ *  @file PageWriter.h                                          *
+ *  @date October 14th, 2026                                    *
+ ***************************************************************/
+
+
+#ifndef CS315_PROJECT01_PAGEWRITER_H
+#define CS315_PROJECT01_PAGEWRITER_H
+
+#include <string>
+#include <cstdint>
+#include "PageBuffer.h"
+#include "OutputLayout.h"
+#include "PageArchive.h"
+#include "PageCompressor.h"
+
+class PageQueue;
+
+
+class PageWriter {
+public:
+    // ------------------------------------------------ Constructors ------------------------------------------------ //
+    // Creates a writer with no open directory, that writes a file for every page
+    PageWriter();
+
+    // The writer owns its open directory, so it can not be copied
+    PageWriter(const PageWriter&) = delete;
+    PageWriter& operator=(const PageWriter&) = delete;
+
+    // Closes the open directory. Pages that are still in the batch are not written (see flush).
+    ~PageWriter();
+
+
+    // ----------------------------------------------- Public Methods ----------------------------------------------- //
+    // Writes the pages into an archive rather than a file each (nullptr writes files again)
+    void setArchive(PageArchive* archive);
+
+    // Hands the pages to the writer thread of a queue in batches, rather than writing them (nullptr writes them again)
+    void setQueue(PageQueue* queue);
+
+    // Sets the formats (the bits of PageCompressor::Format) that each page is written in. By default only PLAIN.
+    void setFormats(unsigned int formats);
+
+    // Writes a page to the file of the user with a certain ID in layout. Returns false if it failed.
+    bool writePage(const PageBuffer& page, const OutputLayout& layout, uint64_t id);
+
+    // Writes a page to a file with a certain name in the directory of the page of a user (such as a continuation page
+    // of one of their lists). Returns false if it failed.
+    bool writePage(const PageBuffer& page, const OutputLayout& layout, uint64_t id, const std::string& filename);
+
+    // Writes the pages that are still in the batch to the archive, or pushes them to the queue. Returns false if it
+    // failed.
+    bool flush();
+
+private:
+    // -------------------------------------------- Private Data Members -------------------------------------------- //
+    int directoryFd;                // the open directory, or -1
+    uint64_t directoryKey;          // the directory key (see OutputLayout::getDirectoryKey) of the open directory
+    PageArchive* archive;           // the archive that the pages are written to, or nullptr
+    PageQueue* queue;               // the queue that the pages are handed to, or nullptr
+    PageBuffer batch;               // the archive (or queue) entries of the pages that were not written yet
+    unsigned int formats;           // the formats that each page is written in
+    PageCompressor compressor;      // compresses the pages of the formats other than PLAIN
+    PageBuffer compressedPage;      // the page compressed in one format, before it is written
+
+    // The size that the batch is written to the archive (or pushed to the queue) at
+    static const std::size_t BATCH_SIZE = 1 << 20;
+
+    // -----------------------------------------  Private Helper Functions ------------------------------------------ //
+    // Writes the contents of a single file (to the open directory, the batch or the queue). Returns false if it failed.
+    bool writeFile(const PageBuffer& contents, const OutputLayout& layout, uint64_t id, const std::string& filename);
+};
+
+
+#endif //CS315_PROJECT01_PAGEWRITER_H
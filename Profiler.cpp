@@ -0,0 +1,530 @@
+/** ****************************************************************
+ *  Implementation of the Profiler class                           *
+ *  @author Brandon Dale                                           *
+ *                                                                 *
+ *  In a profiling build (SOCIAL_NETWORK_PROFILE), the global      *
+ *  operator new and delete are replaced by a counting allocator,  *
+ *  which puts a 16 byte header before each allocation holding its *
+ *  size and the stage it was counted against, so it is taken off  *
+ *  the same stage when it is freed (in whatever stage that is).   *
+ *  Each stage keeps its live, peak and total bytes in atomics.    *
+ *  The memory of the mapped files and of the zlib and brotli      *
+ *  streams is not allocated with new, so it is not counted.       *
+ *                                                                 *
+ *  The slowest pages are kept in a heap (of at most               *
+ *  numSlowestPages), behind a lock that is only taken by a page   *
+ *  slower than the fastest page in the heap, so once the heap is  *
+ *  full the workers rarely take it.                               *
+ *                                                                 *
+ *  @file Profiler.cpp                                             *
+ *  @date October 14th, 2026                                       *
+ ******************************************************************/
+
+
+#include "Profiler.h"
+#include "PageBuffer.h"
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+using namespace std;
+
+
+namespace {
+    // A timed stage of one thread
+    struct TraceEvent {
+        Stats::Stage stage;
+        int64_t startNanoseconds;       // since the profiler was enabled
+        int64_t durationNanoseconds;
+        int thread;
+        int64_t liveBytes;              // the bytes allocated (in every stage) at the end of the stage
+    };
+
+    // The creation of one user page
+    struct PageRecord {
+        uint64_t id;                    // the ID of the user in the input file
+        int64_t startNanoseconds;       // since the profiler was enabled
+        int64_t durationNanoseconds;
+        size_t follows;
+        size_t followers;
+        size_t mutuals;
+        int thread;
+    };
+
+    atomic<bool> enabled(false);
+    size_t numSlowestPages = Profiler::DEFAULT_SLOWEST_PAGES;
+    chrono::steady_clock::time_point epoch;
+
+    // The stage that each thread is in (-1 for none), and the number of each thread in the trace
+    thread_local int threadStage = -1;
+    thread_local int threadNumber = -1;
+    atomic<int> numThreads(0);
+
+    mutex eventsLock;
+    vector<TraceEvent> events;
+
+    // A heap of the slowest pages, with the fastest of them on top, and its duration once the heap is full
+    mutex pagesLock;
+    vector<PageRecord> slowestPages;
+    atomic<int64_t> slowestPagesThreshold(0);
+
+    // The bytes of the allocations of each stage, with the allocations made outside of any stage last
+    const int NUM_BUCKETS = Stats::NUM_STAGES + 1;
+    atomic<int64_t> liveBytes[NUM_BUCKETS];
+    atomic<int64_t> peakBytes[NUM_BUCKETS];
+    atomic<uint64_t> allocatedBytes[NUM_BUCKETS];
+    atomic<uint64_t> numAllocations[NUM_BUCKETS];
+    atomic<int64_t> totalLiveBytes(0);
+    atomic<int64_t> totalPeakBytes(0);
+
+    // Orders the pages so that the fastest is on top of the heap
+    bool isSlower(const PageRecord& a, const PageRecord& b) {
+        return a.durationNanoseconds > b.durationNanoseconds;
+    }
+
+    // Returns the number of the calling thread in the trace, numbering it if it has none yet
+    int getThreadNumber() {
+        if (threadNumber < 0) threadNumber = numThreads.fetch_add(1, memory_order_relaxed);
+        return threadNumber;
+    }
+
+    // Returns the nanoseconds between the profiler being enabled and a point in time
+    int64_t sinceEpoch(chrono::steady_clock::time_point time) {
+        return chrono::duration_cast<chrono::nanoseconds>(time - epoch).count();
+    }
+
+    // Appends a number of nanoseconds to a trace as microseconds (the unit of its timestamps)
+    void appendMicroseconds(PageBuffer& trace, int64_t nanoseconds) {
+        char value[32];
+        snprintf(value, sizeof(value), "%.3f", nanoseconds / 1e3);
+        trace.append(value);
+    }
+}
+
+
+#ifdef SOCIAL_NETWORK_PROFILE
+
+// ----------------------------------------------- COUNTING ALLOCATOR ----------------------------------------------- //
+
+namespace {
+    // The header before each allocation. 16 bytes keeps the alignment that malloc gives.
+    struct AllocationHeader {
+        uint64_t size;
+        int64_t bucket;
+    };
+    static_assert(sizeof(AllocationHeader) == 16, "the header must keep the alignment of malloc");
+
+    // Raises a peak to a value, if the value is higher
+    void raisePeak(atomic<int64_t>& peak, int64_t value) {
+        int64_t current = peak.load(memory_order_relaxed);
+        while (value > current && !peak.compare_exchange_weak(current, value, memory_order_relaxed)) {}
+    }
+
+    void* allocate(size_t size, size_t alignment) {
+        /*
+         *  Allocates memory with a header before it, and counts it against the stage of the calling thread
+         *
+         *  Parameters:
+         *      size_t size:
+         *          The number of bytes to allocate
+         *
+         *      size_t alignment:
+         *          The alignment of the memory (at least that of malloc, 16)
+         *
+         *  Returns:
+         *      void*:
+         *          The memory, or nullptr if it could not be allocated
+         */
+
+        // An over-aligned allocation is padded by its alignment, so the header fits in the padding
+        const size_t padding = max(alignment, sizeof(AllocationHeader));
+        char* block;
+        if (alignment <= sizeof(AllocationHeader)) {
+            block = static_cast<char*>(malloc(size + padding));
+        }
+        else {
+            block = static_cast<char*>(aligned_alloc(alignment, (size + padding + alignment - 1) / alignment *
+                                                                alignment));
+        }
+        if (block == nullptr) return nullptr;
+
+        char* memory = block + padding;
+        AllocationHeader* header = reinterpret_cast<AllocationHeader*>(memory) - 1;
+        const int bucket = threadStage >= 0 ? threadStage : Stats::NUM_STAGES;
+        header->size = size;
+        header->bucket = bucket;
+
+        raisePeak(peakBytes[bucket], liveBytes[bucket].fetch_add(size, memory_order_relaxed) + size);
+        raisePeak(totalPeakBytes, totalLiveBytes.fetch_add(size, memory_order_relaxed) + size);
+        allocatedBytes[bucket].fetch_add(size, memory_order_relaxed);
+        numAllocations[bucket].fetch_add(1, memory_order_relaxed);
+        return memory;
+    }
+
+    void release(void* memory, size_t alignment) {
+        /*
+         *  Frees memory from allocate, taking it off the stage that it was counted against
+         *
+         *  Parameters:
+         *      void* memory:
+         *          The memory, or nullptr (which does nothing)
+         *
+         *      size_t alignment:
+         *          The alignment that the memory was allocated with
+         *
+         *  Returns:
+         *      Returns nothing.
+         */
+
+        if (memory == nullptr) return;
+        const AllocationHeader* header = static_cast<const AllocationHeader*>(memory) - 1;
+        liveBytes[header->bucket].fetch_sub(header->size, memory_order_relaxed);
+        totalLiveBytes.fetch_sub(header->size, memory_order_relaxed);
+        free(static_cast<char*>(memory) - max(alignment, sizeof(AllocationHeader)));
+    }
+
+    void* allocateOrThrow(size_t size, size_t alignment) {
+        void* memory = allocate(size, alignment);
+        if (memory == nullptr) throw bad_alloc();
+        return memory;
+    }
+}
+
+// Every form of the global operator new and delete, each of which allocates or frees through the counting allocator
+void* operator new(size_t size) { return allocateOrThrow(size, sizeof(AllocationHeader)); }
+void* operator new[](size_t size) { return allocateOrThrow(size, sizeof(AllocationHeader)); }
+void* operator new(size_t size, const nothrow_t&) noexcept { return allocate(size, sizeof(AllocationHeader)); }
+void* operator new[](size_t size, const nothrow_t&) noexcept { return allocate(size, sizeof(AllocationHeader)); }
+void* operator new(size_t size, align_val_t alignment) { return allocateOrThrow(size, size_t(alignment)); }
+void* operator new[](size_t size, align_val_t alignment) { return allocateOrThrow(size, size_t(alignment)); }
+void* operator new(size_t size, align_val_t alignment, const nothrow_t&) noexcept {
+    return allocate(size, size_t(alignment));
+}
+void* operator new[](size_t size, align_val_t alignment, const nothrow_t&) noexcept {
+    return allocate(size, size_t(alignment));
+}
+
+void operator delete(void* memory) noexcept { release(memory, sizeof(AllocationHeader)); }
+void operator delete[](void* memory) noexcept { release(memory, sizeof(AllocationHeader)); }
+void operator delete(void* memory, size_t) noexcept { release(memory, sizeof(AllocationHeader)); }
+void operator delete[](void* memory, size_t) noexcept { release(memory, sizeof(AllocationHeader)); }
+void operator delete(void* memory, const nothrow_t&) noexcept { release(memory, sizeof(AllocationHeader)); }
+void operator delete[](void* memory, const nothrow_t&) noexcept { release(memory, sizeof(AllocationHeader)); }
+void operator delete(void* memory, align_val_t alignment) noexcept { release(memory, size_t(alignment)); }
+void operator delete[](void* memory, align_val_t alignment) noexcept { release(memory, size_t(alignment)); }
+void operator delete(void* memory, size_t, align_val_t alignment) noexcept { release(memory, size_t(alignment)); }
+void operator delete[](void* memory, size_t, align_val_t alignment) noexcept { release(memory, size_t(alignment)); }
+void operator delete(void* memory, align_val_t alignment, const nothrow_t&) noexcept {
+    release(memory, size_t(alignment));
+}
+void operator delete[](void* memory, align_val_t alignment, const nothrow_t&) noexcept {
+    release(memory, size_t(alignment));
+}
+
+#endif
+
+
+// -------------------------------------------------- PAGE TIMER ---------------------------------------------------- //
+
+Profiler::PageTimer::PageTimer() {
+    /*
+     *  Starts timing a user page, if the profiler is enabled.
+     *
+     *  Parameters:
+     *      Takes no parameters
+     *
+     *  Returns:
+     *      No return value, creates a PageTimer object
+     */
+
+    this->running = enabled.load(memory_order_relaxed);
+    if (running) start = chrono::steady_clock::now();
+}
+
+void Profiler::PageTimer::stop(uint64_t id, size_t follows, size_t followers, size_t mutuals) {
+    /*
+     *  Ends the timing of a user page, and keeps it if it is one of the slowest pages so far. Does nothing if the timer
+     *  was already stopped.
+     *
+     *  Parameters:
+     *      uint64_t id:
+     *          The ID of the user (as written in the input file)
+     *
+     *      size_t follows:
+     *          The length of the follows list of the user
+     *
+     *      size_t followers:
+     *          The length of the followers list of the user
+     *
+     *      size_t mutuals:
+     *          The length of the mutuals list of the user
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    if (!running) return;
+    running = false;
+    const chrono::steady_clock::time_point end = chrono::steady_clock::now();
+    const int64_t duration = chrono::duration_cast<chrono::nanoseconds>(end - start).count();
+    if (duration <= slowestPagesThreshold.load(memory_order_relaxed)) return;
+
+    lock_guard<mutex> guard(pagesLock);
+    if (slowestPages.size() == numSlowestPages) {
+        if (duration <= slowestPages.front().durationNanoseconds) return;
+        pop_heap(slowestPages.begin(), slowestPages.end(), isSlower);
+        slowestPages.pop_back();
+    }
+    slowestPages.push_back({id, sinceEpoch(start), duration, follows, followers, mutuals, getThreadNumber()});
+    push_heap(slowestPages.begin(), slowestPages.end(), isSlower);
+    if (slowestPages.size() == numSlowestPages) {
+        slowestPagesThreshold.store(slowestPages.front().durationNanoseconds, memory_order_relaxed);
+    }
+}
+
+
+// ------------------------------------------------ PUBLIC METHODS -------------------------------------------------- //
+
+void Profiler::enable(size_t numSlowestPages) {
+    /*
+     *  Starts profiling the run, which also starts measuring the stats (whose stage timers the trace is made of). The
+     *  trace is timed from this call.
+     *
+     *  Parameters:
+     *      size_t numSlowestPages:
+     *          The number of the slowest user pages to keep
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    ::numSlowestPages = numSlowestPages;
+    slowestPages.reserve(numSlowestPages + 1);
+    epoch = chrono::steady_clock::now();
+    getThreadNumber();
+    Stats::enable();
+    enabled.store(true, memory_order_relaxed);
+}
+
+bool Profiler::isEnabled() {
+    /*
+     *  Checks if the run is being profiled
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if enable was called.
+     *          Otherwise, returns false.
+     */
+
+    return enabled.load(memory_order_relaxed);
+}
+
+bool Profiler::isCountingAllocations() {
+    /*
+     *  Checks if this is a profiling build (built with SOCIAL_NETWORK_PROFILE defined, by make profile), whose
+     *  allocations are counted
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if the allocations are counted.
+     *          Otherwise, returns false.
+     */
+
+#ifdef SOCIAL_NETWORK_PROFILE
+    return true;
+#else
+    return false;
+#endif
+}
+
+int Profiler::getThreadStage() {
+    /*
+     *  Returns the stage that the calling thread is in (the innermost stage timer that is running on it, or the stage
+     *  that it was given by setThreadStage)
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      int:
+     *          The stage (a Stats::Stage), or -1 if the thread is in none
+     */
+
+    return threadStage;
+}
+
+void Profiler::setThreadStage(int stage) {
+    /*
+     *  Sets the stage that the calling thread is in, which is the stage that its allocations are counted against
+     *
+     *  Parameters:
+     *      int stage:
+     *          The stage (a Stats::Stage), or -1 for none
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    threadStage = stage;
+}
+
+void Profiler::addStageEvent(Stats::Stage stage, chrono::steady_clock::time_point start,
+                             chrono::steady_clock::time_point end) {
+    /*
+     *  Adds a timed stage of the calling thread to the trace. Does nothing if the profiler is not enabled.
+     *
+     *  Parameters:
+     *      Stats::Stage stage:
+     *          The stage
+     *
+     *      chrono::steady_clock::time_point start:
+     *          When the stage started
+     *
+     *      chrono::steady_clock::time_point end:
+     *          When the stage ended
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    if (!enabled.load(memory_order_relaxed)) return;
+    const int thread = getThreadNumber();
+    const int64_t live = totalLiveBytes.load(memory_order_relaxed);
+    lock_guard<mutex> guard(eventsLock);
+    events.push_back({stage, sinceEpoch(start), chrono::duration_cast<chrono::nanoseconds>(end - start).count(),
+                      thread, live});
+}
+
+void Profiler::printReport(ostream& out) {
+    /*
+     *  Prints the memory allocated in each stage, and the slowest user pages (slowest first), as tables. Without a
+     *  profiling build, the allocations are not counted, and a line saying so is printed instead of the memory table.
+     *
+     *  The memory of a stage is that of the allocations made while a thread was in it (and not in a stage nested in
+     *  it), such as the users and their strings for parse, the follows and followers indices for build_indices, the
+     *  name and link tables for user_names and link_table, and the page buffers and lists of each worker for
+     *  user_pages. Its peak is the most of that memory that was allocated at once.
+     *
+     *  Parameters:
+     *      ostream& out:
+     *          The stream to print to
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    char line[160];
+    if (isCountingAllocations()) {
+        snprintf(line, sizeof(line), "\n%-20s %12s %12s %14s %12s\n", "memory of stage", "peak MB", "live MB",
+                 "allocated MB", "allocations");
+        out << line;
+        for (int bucket = 0; bucket < NUM_BUCKETS; bucket++) {
+            const uint64_t allocations = numAllocations[bucket].load(memory_order_relaxed);
+            if (allocations == 0) continue;
+            snprintf(line, sizeof(line), "%-20s %12.3f %12.3f %14.3f %12llu\n",
+                     bucket < Stats::NUM_STAGES ? Stats::getStageName(static_cast<Stats::Stage>(bucket)) : "(none)",
+                     peakBytes[bucket].load(memory_order_relaxed) / 1e6,
+                     liveBytes[bucket].load(memory_order_relaxed) / 1e6,
+                     allocatedBytes[bucket].load(memory_order_relaxed) / 1e6,
+                     static_cast<unsigned long long>(allocations));
+            out << line;
+        }
+        snprintf(line, sizeof(line), "%-20s %12.3f %12.3f\n", "(all stages)",
+                 totalPeakBytes.load(memory_order_relaxed) / 1e6, totalLiveBytes.load(memory_order_relaxed) / 1e6);
+        out << line;
+    }
+    else {
+        out << "\nmemory of stage: not counted (build with make profile to count the allocations of each stage)\n";
+    }
+
+    lock_guard<mutex> guard(pagesLock);
+    vector<PageRecord> pages = slowestPages;
+    sort(pages.begin(), pages.end(), isSlower);
+    snprintf(line, sizeof(line), "\n%-20s %12s %12s %12s %12s\n", "slowest user pages", "ms", "follows", "followers",
+             "mutuals");
+    out << line;
+    for (const PageRecord& page : pages) {
+        const string user = "user" + to_string(page.id);
+        snprintf(line, sizeof(line), "%-20s %12.3f %12zu %12zu %12zu\n", user.c_str(), page.durationNanoseconds / 1e6,
+                 page.follows, page.followers, page.mutuals);
+        out << line;
+    }
+}
+
+bool Profiler::writeTrace(const string& filename) {
+    /*
+     *  Writes the trace as a Chrome trace JSON file (which chrome://tracing, ui.perfetto.dev and speedscope open),
+     *  with an event for each timed stage on each thread, such as
+     *      {"name":"parse","cat":"stage","ph":"X","ts":12.5,"dur":3400.25,"pid":1,"tid":0}
+     *  an event for each of the slowest user pages (with the length of its lists), and in a profiling build, a counter
+     *  of the bytes allocated at the end of each stage.
+     *
+     *  Parameters:
+     *      const string& filename:
+     *          The name of the file to write
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if the file was written.
+     *          Otherwise, returns false.
+     */
+
+    PageBuffer trace;
+    trace.append(R"({"displayTimeUnit":"ms","traceEvents":[)");
+    bool first = true;
+    auto beginEvent = [&](string_view name, const char* category, const char* phase, int64_t start, int thread) {
+        trace.append(first ? "\n" : ",\n");
+        first = false;
+        trace.append(R"({"name":")");
+        trace.append(name);
+        trace.append(R"(","cat":")");
+        trace.append(category);
+        trace.append(R"(","ph":")");
+        trace.append(phase);
+        trace.append(R"(","ts":)");
+        appendMicroseconds(trace, start);
+        trace.append(R"(,"pid":1,"tid":)");
+        trace.append(static_cast<unsigned long long>(thread));
+    };
+
+    {
+        lock_guard<mutex> guard(eventsLock);
+        for (const TraceEvent& event : events) {
+            beginEvent(Stats::getStageName(event.stage), "stage", "X", event.startNanoseconds, event.thread);
+            trace.append(R"(,"dur":)");
+            appendMicroseconds(trace, event.durationNanoseconds);
+            trace.append("}");
+            if (!isCountingAllocations()) continue;
+            beginEvent("allocated", "memory", "C", event.startNanoseconds + event.durationNanoseconds, 0);
+            trace.append(R"(,"args":{"bytes":)");
+            trace.append(static_cast<unsigned long long>(max<int64_t>(event.liveBytes, 0)));
+            trace.append("}}");
+        }
+    }
+
+    lock_guard<mutex> guard(pagesLock);
+    for (const PageRecord& page : slowestPages) {
+        beginEvent("user" + to_string(page.id), "page", "X", page.startNanoseconds, page.thread);
+        trace.append(R"(,"dur":)");
+        appendMicroseconds(trace, page.durationNanoseconds);
+        trace.append(R"(,"args":{"follows":)");
+        trace.append(static_cast<unsigned long long>(page.follows));
+        trace.append(R"(,"followers":)");
+        trace.append(static_cast<unsigned long long>(page.followers));
+        trace.append(R"(,"mutuals":)");
+        trace.append(static_cast<unsigned long long>(page.mutuals));
+        trace.append("}}");
+    }
+    trace.append("\n]}\n");
+    return trace.writeToFile(filename);
+}
@@ -0,0 +1,80 @@
+/** *************************************************************
+ *  Declaration of the Profiler class                           *
+ *  @author Brandon Dale                                        *
+ *                                                              *
+ *  The profiling mode of a run (--profile), on top of the      *
+ *  stage timers of Stats: each timed stage becomes an event of *
+ *  a Chrome trace (chrome://tracing or ui.perfetto.dev), the   *
+ *  slowest user pages are kept (with the length of their       *
+ *  lists), and in a profiling build (make profile) every       *
+ *  allocation is counted against the stage that its thread is  *
+ *  in, so the peak memory of the users, the indices, the name  *
+ *  tables and the page buffers can each be seen. Nothing is    *
+ *  recorded unless the profiler is enabled.                    *
+ *                                                              *
+ *  @file Profiler.h                                            *
+ *  @date October 14th, 2026                                    *
+ ***************************************************************/
+
+
+#ifndef CS315_PROJECT01_PROFILER_H
+#define CS315_PROJECT01_PROFILER_H
+
+#include <string>
+#include <ostream>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include "Stats.h"
+
+
+class Profiler {
+public:
+    // Times the creation (finding the lists, rendering and writing) of a single user page, from its creation until
+    // stop is called (if the profiler is enabled)
+    class PageTimer {
+    public:
+        PageTimer();
+        void stop(uint64_t id, std::size_t follows, std::size_t followers, std::size_t mutuals);
+        PageTimer(const PageTimer&) = delete;
+        PageTimer& operator=(const PageTimer&) = delete;
+
+    private:
+        bool running;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    // ----------------------------------------------- Public Methods ----------------------------------------------- //
+    // Starts profiling (and measuring the stats), keeping the numSlowestPages slowest user pages
+    static void enable(std::size_t numSlowestPages);
+
+    // Checks if the run is being profiled
+    static bool isEnabled();
+
+    // Checks if this is a profiling build, whose allocations are counted
+    static bool isCountingAllocations();
+
+    // Returns the stage that the calling thread is in, which its allocations are counted against (-1 if it is in none)
+    static int getThreadStage();
+
+    // Sets the stage that the calling thread is in (such as a worker of a pool, to the stage of the thread that runs
+    // the pool)
+    static void setThreadStage(int stage);
+
+    // Adds a timed stage of the calling thread to the trace
+    static void addStageEvent(Stats::Stage stage, std::chrono::steady_clock::time_point start,
+                              std::chrono::steady_clock::time_point end);
+
+    // Prints the memory of each stage (in a profiling build) and the slowest user pages, as tables
+    static void printReport(std::ostream& out);
+
+    // Writes the trace (each stage, and each of the slowest pages) as a Chrome trace JSON file. Returns false if it
+    // failed.
+    static bool writeTrace(const std::string& filename);
+
+    // The number of slowest pages that are kept by default
+    static const std::size_t DEFAULT_SLOWEST_PAGES = 10;
+};
+
+
+#endif //CS315_PROJECT01_PROFILER_H
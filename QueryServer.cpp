@@ -0,0 +1,296 @@
+/** ****************************************************************
+ *  Implementation of the QueryServer class                        *
+ *  @author Brandon Dale                                           *
+ *                                                                 *
+ *  serve reads whatever input is ready, answers every whole query *
+ *  in it, and writes all of the answers with a single write. So a *
+ *  client that sends one query at a time gets each answer as soon *
+ *  as it is found, and a client that sends many queries at once   *
+ *  is not slowed down by a write for every answer.                *
+ *                                                                 *
+ *  @file QueryServer.cpp                                          *
+ *  @date October 14th, 2026                                       *
+ ******************************************************************/
+
+
+#include "QueryServer.h"
+#include <string>
+#include <cerrno>
+#include <unistd.h>
+
+using namespace std;
+
+
+// -------------------------------------------------- CONSTRUCTORS -------------------------------------------------- //
+
+QueryServer::QueryServer(const SocialNetwork& network) : network(network) {
+    /*
+     *  Creates a server that answers queries on a network
+     *
+     *  Parameters:
+     *      const SocialNetwork& network:
+     *          The network to answer queries on, which must outlive the server
+     *
+     *  Returns:
+     *      No return value, creates a QueryServer object
+     */
+}
+
+
+// ------------------------------------------------ PUBLIC METHODS -------------------------------------------------- //
+
+void QueryServer::answer(string_view query, PageBuffer& out) const {
+    /*
+     *  Answers a single query, adding the answer line (OK followed by the answer, or ERROR followed by the reason the
+     *  query could not be answered) to the end of out. The queries are listed in QueryServer.h.
+     *
+     *  Parameters:
+     *      string_view query:
+     *          The query, without its newline
+     *
+     *      PageBuffer& out:
+     *          The buffer to add the answer line to
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    // Split off the name of the query
+    const size_t nameBegin = min(query.find_first_not_of(" \t\r"), query.size());
+    const size_t nameEnd = min(query.find_first_of(" \t\r", nameBegin), query.size());
+    const string_view name = query.substr(nameBegin, nameEnd - nameBegin);
+    query.remove_prefix(nameEnd);
+
+    uint64_t extra = 0;
+    if (name == "follows" || name == "followers" || name == "mutuals") {
+        unsigned int id = 0;
+        if (!this->nextUser(query, id, out)) return;
+
+        // The offset and limit are optional, but must be numbers if they are given
+        uint64_t offset = 0;
+        uint64_t limit = DEFAULT_LIMIT;
+        string_view rest = query;
+        if (this->nextNumber(rest, offset)) {
+            query = rest;
+            if (this->nextNumber(rest, limit)) query = rest;
+        }
+        if (this->nextNumber(query, extra) || query.find_first_not_of(" \t\r") != string_view::npos) {
+            out.append("ERROR INVALID OFFSET OR LIMIT\n");
+            return;
+        }
+
+        const OutputLayout::UserList list = name == "follows" ? OutputLayout::FOLLOWS
+                                          : name == "followers" ? OutputLayout::FOLLOWERS
+                                          : OutputLayout::MUTUALS;
+        vector<unsigned int> ids;
+        const size_t listSize = this->network.getUserList(id, list, offset, limit, ids);
+        out.append("OK ");
+        out.append(static_cast<unsigned long long>(listSize));
+        this->appendUsers(ids, out);
+        out.append("\n");
+    }
+    else if (name == "is-following") {
+        unsigned int followerID = 0;
+        unsigned int followedID = 0;
+        if (!this->nextUser(query, followerID, out) || !this->nextUser(query, followedID, out)) return;
+        if (!this->checkEnd(query, out)) return;
+        out.append(this->network.isFollowing(followerID, followedID) ? "OK 1\n" : "OK 0\n");
+    }
+    else if (name == "degree") {
+        unsigned int id = 0;
+        if (!this->nextUser(query, id, out) || !this->checkEnd(query, out)) return;
+        vector<unsigned int> none;
+        out.append("OK ");
+        out.append(static_cast<unsigned long long>(this->network.getUserList(id, OutputLayout::FOLLOWS, 0, 0, none)));
+        out.append(" ");
+        out.append(static_cast<unsigned long long>(this->network.getUserList(id, OutputLayout::FOLLOWERS, 0, 0, none)));
+        out.append(" ");
+        out.append(static_cast<unsigned long long>(this->network.getUserList(id, OutputLayout::MUTUALS, 0, 0, none)));
+        out.append("\n");
+    }
+    else if (name == "users") {
+        if (!this->checkEnd(query, out)) return;
+        out.append("OK ");
+        out.append(static_cast<unsigned long long>(this->network.getNumUsers()));
+        out.append("\n");
+    }
+    else if (name.empty()) {
+        out.append("ERROR EMPTY QUERY\n");
+    }
+    else {
+        out.append("ERROR UNKNOWN QUERY ");
+        out.append(name);
+        out.append("\n");
+    }
+}
+
+bool QueryServer::serve(int inFd, int outFd) const {
+    /*
+     *  Answers the queries read from inFd, one per line, until the end of its input. The answers to the whole queries
+     *  in each read are written together, once all of them are answered.
+     *
+     *  A line longer than MAX_QUERY_LENGTH is answered with ERROR QUERY TOO LONG as soon as it is known to be too
+     *  long, and the rest of it is thrown away as it arrives, so a client that never sends a newline can not make the
+     *  server hold on to all of its input.
+     *
+     *  Parameters:
+     *      int inFd:
+     *          The file descriptor to read the queries from (such as 0, for stdin)
+     *
+     *      int outFd:
+     *          The file descriptor to write the answers to (such as 1, for stdout)
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if every answer was written.
+     *          Otherwise, returns false.
+     */
+
+    string pending;         // the input that has been read, but not answered yet (the start of a query)
+    bool skipping = false;  // whether pending is the rest of a query that was too long (and was already answered)
+    PageBuffer answers;
+    char chunk[64 * 1024];
+    while (true) {
+        ssize_t numRead = read(inFd, chunk, sizeof(chunk));
+        if (numRead < 0 && errno == EINTR) continue;
+        if (numRead <= 0) break;
+        pending.append(chunk, numRead);
+
+        size_t queryBegin = 0;
+        size_t newline = 0;
+        while ((newline = pending.find('\n', queryBegin)) != string::npos) {
+            if (skipping) skipping = false;
+            else if (newline - queryBegin > MAX_QUERY_LENGTH) answers.append("ERROR QUERY TOO LONG\n");
+            else this->answer(string_view(pending).substr(queryBegin, newline - queryBegin), answers);
+            queryBegin = newline + 1;
+        }
+        pending.erase(0, queryBegin);
+        if (pending.size() > MAX_QUERY_LENGTH) {
+            if (!skipping) answers.append("ERROR QUERY TOO LONG\n");
+            skipping = true;
+            pending.clear();
+        }
+
+        if (answers.getSize() > 0) {
+            if (!answers.writeAll(outFd)) return false;
+            answers.clear();
+        }
+    }
+
+    // The last query does not need a newline
+    if (!skipping && pending.find_first_not_of(" \t\r") != string::npos) this->answer(pending, answers);
+    return answers.getSize() == 0 || answers.writeAll(outFd);
+}
+
+
+// -------------------------------------------- PRIVATE HELPER METHODS ---------------------------------------------- //
+
+bool QueryServer::nextNumber(string_view& query, uint64_t& value) {
+    /*
+     *  Reads the next word of a query as a number, and removes it from the query
+     *
+     *  Parameters:
+     *      string_view& query:
+     *          The rest of the query
+     *
+     *      uint64_t& value:
+     *          Set to the number, if the next word is one
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if the next word is a number that fits in 64 bits.
+     *          Otherwise, returns false (and neither the query nor value is changed).
+     */
+
+    const size_t begin = query.find_first_not_of(" \t\r");
+    if (begin == string_view::npos) return false;
+    const size_t end = min(query.find_first_of(" \t\r", begin), query.size());
+
+    uint64_t number = 0;
+    for (size_t i = begin; i < end; i++) {
+        const char digit = query[i];
+        if (digit < '0' || digit > '9' || number > (UINT64_MAX - (digit - '0')) / 10) return false;
+        number = 10 * number + (digit - '0');
+    }
+
+    value = number;
+    query.remove_prefix(end);
+    return true;
+}
+
+bool QueryServer::checkEnd(string_view query, PageBuffer& out) {
+    /*
+     *  Checks that nothing but whitespace is left of a query, once all of its words are read
+     *
+     *  Parameters:
+     *      string_view query:
+     *          The rest of the query
+     *
+     *      PageBuffer& out:
+     *          The buffer to add an ERROR answer to, if there is more to the query
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if the rest of the query is empty (or whitespace).
+     *          Otherwise, returns false.
+     */
+
+    if (query.find_first_not_of(" \t\r") == string_view::npos) return true;
+    out.append("ERROR TOO MANY ARGUMENTS\n");
+    return false;
+}
+
+bool QueryServer::nextUser(string_view& query, unsigned int& id, PageBuffer& out) const {
+    /*
+     *  Reads the next word of a query as the ID of a user in the input file, and finds their internal ID
+     *
+     *  Parameters:
+     *      string_view& query:
+     *          The rest of the query
+     *
+     *      unsigned int& id:
+     *          Set to the internal ID of the user, if there is one
+     *
+     *      PageBuffer& out:
+     *          The buffer to add an ERROR answer to, if the word is not the ID of a user
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if the word is the ID of a user.
+     *          Otherwise, returns false.
+     */
+
+    uint64_t externalId = 0;
+    if (!this->nextNumber(query, externalId)) {
+        out.append("ERROR MISSING OR INVALID USER ID\n");
+        return false;
+    }
+    if (!this->network.findUserId(externalId, id)) {
+        out.append("ERROR NO USER WITH ID ");
+        out.append(static_cast<unsigned long long>(externalId));
+        out.append("\n");
+        return false;
+    }
+    return true;
+}
+
+void QueryServer::appendUsers(const vector<unsigned int>& ids, PageBuffer& out) const {
+    /*
+     *  Adds the IDs in the input file of a list of users to the end of out, each after a space
+     *
+     *  Parameters:
+     *      const vector<unsigned int>& ids:
+     *          The internal IDs of the users
+     *
+     *      PageBuffer& out:
+     *          The buffer to add the IDs to
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    for (unsigned int id : ids) {
+        out.append(" ");
+        out.append(static_cast<unsigned long long>(this->network.getExternalId(id)));
+    }
+}
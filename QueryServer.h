@@ -0,0 +1,83 @@
+/** *************************************************************
+ *  Declaration of the QueryServer class                        *
+ *  @author Brandon Dale                                        *
+ *                                                              *
+ *  Answers lookups on a loaded social network (such as a       *
+ *  memory mapped snapshot), so that profiles can be rendered   *
+ *  on demand instead of creating every HTML file up front.     *
+ *  Queries are read one per line, and each is answered with a  *
+ *  single line (users are given by their IDs in the input      *
+ *  file):                                                      *
+ *                                                              *
+ *      follows ID [OFFSET [LIMIT]]   OK <length> <ID>...       *
+ *      followers ID [OFFSET [LIMIT]] OK <length> <ID>...       *
+ *      mutuals ID [OFFSET [LIMIT]]   OK <length> <ID>...       *
+ *      is-following ID ID            OK 1 (or OK 0)            *
+ *      degree ID                     OK <follows> <followers>  *
+ *                                       <mutuals>              *
+ *      users                         OK <number of users>      *
+ *                                                              *
+ *  A query that can not be answered (including one with extra  *
+ *  words, or a line longer than MAX_QUERY_LENGTH) gets         *
+ *  ERROR <reason>.                                             *
+ *                                                              *
+ *  @file QueryServer.h                                         *
+ *  @date October 14th, 2026                                    *
+ ***************************************************************/
+
+
+#ifndef CS315_PROJECT01_QUERYSERVER_H
+#define CS315_PROJECT01_QUERYSERVER_H
+
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "SocialNetwork.h"
+#include "PageBuffer.h"
+
+
+class QueryServer {
+public:
+    // ------------------------------------------------ Constructors ------------------------------------------------ //
+    // Answers queries on a network, which must outlive the server
+    explicit QueryServer(const SocialNetwork& network);
+
+
+    // ----------------------------------------------- Public Methods ----------------------------------------------- //
+    // Answers a single query (without its newline), adding the answer line to the end of out. Only reads the network,
+    // so many threads can answer queries at once (each with a buffer of its own).
+    void answer(std::string_view query, PageBuffer& out) const;
+
+    // Answers the queries read from inFd until the end of its input, writing the answers to outFd. Returns false if an
+    // answer could not be written.
+    bool serve(int inFd, int outFd) const;
+
+    // The number of users that a page of a list holds, if the query does not give a limit
+    static const std::size_t DEFAULT_LIMIT = 100;
+
+    // The longest query line (without its newline) that is answered, longer ones get ERROR QUERY TOO LONG
+    static const std::size_t MAX_QUERY_LENGTH = 4096;
+
+private:
+    // -------------------------------------------- Private Data Members -------------------------------------------- //
+    const SocialNetwork& network;
+
+    // -----------------------------------------  Private Helper Functions ------------------------------------------ //
+    // Reads the next word of a query as a number. Returns false if there is no next word, or it is not a number.
+    static bool nextNumber(std::string_view& query, uint64_t& value);
+
+    // Checks that nothing but whitespace is left of a query. If there is, adds an ERROR answer to out and returns
+    // false.
+    static bool checkEnd(std::string_view query, PageBuffer& out);
+
+    // Reads the next word of a query as the ID of a user, and sets id to their internal ID. If there is no such user,
+    // adds an ERROR answer to out and returns false.
+    bool nextUser(std::string_view& query, unsigned int& id, PageBuffer& out) const;
+
+    // Adds the external IDs of a list of users to out, each after a space
+    void appendUsers(const std::vector<unsigned int>& ids, PageBuffer& out) const;
+};
+
+
+#endif //CS315_PROJECT01_QUERYSERVER_H
@@ -13,23 +13,60 @@
 
 #include "SocialNetwork.h"
 #include "User.h"
-#include <fstream>
-#include <sstream>
+#include "MappedFile.h"
+#include "UserScanner.h"
+#include "ThreadPool.h"
+#include "PageBuffer.h"
+#include "IncrementalState.h"
+#include "NetworkSnapshot.h"
+#include "Stats.h"
+#include "LinkTable.h"
+#include "OutputLayout.h"
+#include "PageWriter.h"
+#include "PageQueue.h"
+#include "PageArchive.h"
+#include "SortedIntersection.h"
+#include "SuggestionFinder.h"
+#include "GraphAnalytics.h"
+#include "Profiler.h"
+#include <cstdio>
 #include <string>
 #include <iostream>
 #include <cassert>
-#include <limits>
 #include <algorithm>
+#include <numeric>
+#include <unordered_map>
+#include <utility>
 
 using namespace std;
 
 
+namespace {
+    // A user object as it was scanned, before the users are numbered. Its strings are already in a string pool, and its
+    // follows are the IDs in the file, stored in [followsBegin, followsEnd) of the follows of its chunk.
+    struct ParsedUser {
+        uint64_t id;
+        string_view name;
+        string_view location;
+        string_view pic_url;
+        size_t followsBegin;
+        size_t followsEnd;
+    };
+
+    // The users scanned from one chunk of the users array, with the follows of every user back to back
+    struct ParsedChunk {
+        vector<ParsedUser> users;
+        vector<uint64_t> follows;
+    };
+}
+
+
 // -------------------------------------------------- CONSTRUCTORS -------------------------------------------------- //
 
 SocialNetwork::SocialNetwork() {
     /*
      *  The default constructor of a SocialNetwork object. It initializes the number of users to 0.
-     *  The vectors, followerRelationships, users, and userNames are initializes implicitly to be empty.
+     *  The follows/followers indices and the vectors users and userNames are initialized implicitly to be empty.
      *
      *  Parameters:
      *      Takes no parameters
@@ -38,17 +75,30 @@ SocialNetwork::SocialNetwork() {
      *      No return value, creates a SocialNetwork object
      */
     numUsers = 0;
+    indicesCompressed = false;
+    strings = make_shared<StringPool>();
+    followsArena = make_shared<IdArena>();
 }
 
-SocialNetwork::SocialNetwork(const string& JSON_Filename) {
+SocialNetwork::SocialNetwork(const string& JSON_Filename, unsigned int numJobs) {
     /*
      *  A constructor for a SocialNetwork object.
      *
      *  Initializes all private data members of a SocialNetwork object given the string filename of a JSON file containing
-     *  an array of user information. This constructor parses through the JSON file extracting a strings which contain a
-     *  single user's information as a JSON array. It then creates a string stream using that user information string and
-     *  creates a User object with that string stream. Then, if needed, it sorts the user array by ID (smallest->biggest).
-     *  Then it creates the 2D array of follower relationships and the 1D array of userNames.
+     *  an array of user information. This constructor maps the JSON file into memory and scans it once, extracting the
+     *  fields of each user object as views into the file, and creates a User object from those fields. No intermediate
+     *  strings or string streams are created for a user. The users array is split at object boundaries into chunks that
+     *  are scanned in parallel. The IDs in the file may be any 64-bit values: each user is given a dense index in ID order
+     *  (index ID - 1 when the IDs are 1 to the number of users, or the position of their ID in a sorted table of IDs
+     *  otherwise), and is created straight in that slot of the user array, so the array ends up sorted by ID
+     *  (smallest->biggest). Duplicate IDs, and follows of IDs that are not in the file, are found. Then it creates the
+     *  sparse follows and followers indices and the 1D array of userNames.
+     *
+     *  Every internal structure uses the dense indices, and the IDs in the file only appear in the names of the pages and
+     *  in the links between them.
+     *
+     *  If the file is a binary snapshot (written by saveSnapshot) rather than a JSON file, the network is opened from the
+     *  snapshot instead (see loadSnapshot).
      *
      *  Since this is not going to be widely used, the constructor currently makes the following assumptions:
      *      1) It is a valid JSON file
@@ -61,100 +111,200 @@ SocialNetwork::SocialNetwork(const string& JSON_Filename) {
      *          A string containing the filename of a JSON array containing user information. Assumes that the location of
      *          this file is in the correct place (For example: in the cmake-build-debug directory for CLion).
      *
+     *      unsigned int numJobs:
+     *          The number of threads to parse the file with. 0 uses the hardware concurrency.
+     *
      *  Returns:
      *      No return value as it creates a SocialNetwork object.
      */
 
     numUsers = 0;
+    indicesCompressed = false;
+    strings = make_shared<StringPool>();
+    followsArena = make_shared<IdArena>();
 
-    // ------------------ Create the array of users ------------------ //
+    // Open the network from a snapshot if one is given
+    if (NetworkSnapshot::isSnapshotFile(JSON_Filename)) {
+        Stats::ScopedTimer timer(Stats::LOAD_SNAPSHOT);
+        this->loadSnapshot(JSON_Filename);
+        return;
+    }
 
-    // Open the user input file, and assert that it opened successfully.
-    ifstream inFS;
-    inFS.open(JSON_Filename);
-    assert(inFS.is_open());
+    // ------------------ Create the array of users ------------------ //
 
-    // Remove all characters before the start of the user array, marked by the first (and only) open bracket '[' and
-    // remove all newline and tab characters before the start of a user object array (marked by '{')
-    string userData;
-    inFS.ignore(numeric_limits<streamsize>::max(), '[');
+    // Map the user input file into memory, and assert that it opened successfully.
+    MappedFile inputFile(JSON_Filename);
+    assert(inputFile.isOpen());
 
-    // Create variables which track whether sorting of the Users array is needed. If the nextExpectedID does not match
-    // the id of the next user created, then it flags that the user array will need to be sorted.
-    bool userSortingNeeded = false;
-    unsigned int nextExpectedID = 1;
+    // Split the users array into chunks of whole user objects, and extract each chunk into its own vector of users on
+    // the thread pool. Each worker copies the strings into its own string pool, so no locking is needed. There are a
+    // few chunks per thread, so that a thread which finishes early can steal the chunks of another.
+    Stats::ScopedTimer parseTimer(Stats::PARSE);
+    ThreadPool pool(numJobs);
+    const unsigned int numChunks = pool.getNumThreads() == 1 ? 1 : 4 * pool.getNumThreads();
+    vector<string_view> chunks = UserScanner::splitUserArray(inputFile.getContents(), numChunks, pool);
+    if (chunks.empty()) {
+        // Scanning the whole file reports the missing users array
+        UserFields fields;
+        UserScanner(inputFile.getContents()).nextUser(fields);
+    }
 
-    // While there is still a user data array in the filestream (i.e. still a user to create)
-    while (inFS.peek() != ']') {
+    vector<ParsedChunk> chunkUsers(chunks.size());
+    vector<StringPool> workerStrings(pool.getNumThreads());
+    vector<UserFields> workerFields(pool.getNumThreads());
+    vector<size_t> workerFollows(pool.getNumThreads(), 0);
+    size_t bytesScanned = 0;
+    pool.parallelFor(0, chunks.size(), 1, [&](unsigned int worker, size_t chunk) {
+        StringPool& chunkStrings = workerStrings[worker];
+        UserFields& fields = workerFields[worker];
+        ParsedChunk& parsed = chunkUsers[chunk];
+        UserScanner scanner(inputFile.getContents(), chunks[chunk]);
 
-        // Remove anything up to (and including) the opening curly bracket
-        inFS.ignore(numeric_limits<streamsize>::max(), '{');
+        // While there is still a user object in the chunk (i.e. still a user to create)
+        while (scanner.nextUser(fields)) {
+            workerFollows[worker] += fields.follows.size();
 
-        // Extract the userData and turn it into a string stream
-        getline(inFS, userData, '}');
-        stringstream userDataSS;
-        userDataSS.str(userData);
+            // Add the fields of the user to the chunk. The strings are copied into the string pool (as the mapped file
+            // is released at the end of the constructor), where each distinct location and pic_url is only stored
+            // once. The follows are kept as the IDs in the file until every user is numbered.
+            size_t followsBegin = parsed.follows.size();
+            parsed.follows.insert(parsed.follows.end(), fields.follows.begin(), fields.follows.end());
+            parsed.users.push_back({fields.id, chunkStrings.store(fields.name), chunkStrings.intern(fields.location),
+                                    chunkStrings.intern(fields.pic_url), followsBegin, parsed.follows.size()});
+        }
+        if (chunk + 1 == chunks.size()) bytesScanned = scanner.getBytesScanned();
+    });
 
-        // Create a user object with that data, and insert it into the users array
-        User newUser(userDataSS);
-        assert(newUser.isValid());
-        this->users.push_back(newUser);
+    // Take over the strings of every worker, and count the users and follows of every chunk
+    for (StringPool& currStrings : workerStrings) strings->adopt(currStrings);
+    numUsers = 0;
+    for (const ParsedChunk& currChunk : chunkUsers) numUsers += currChunk.users.size();
+    size_t numFollows = 0;
+    for (size_t curFollows : workerFollows) numFollows += curFollows;
+    parseTimer.stop();
+    Stats::add(Stats::BYTES_PARSED, bytesScanned);
+    Stats::add(Stats::USERS, numUsers);
+    Stats::add(Stats::FOLLOWS, numFollows);
 
-        // Check if the Users array will need to be sorted
-        if (newUser.getId() != nextExpectedID) userSortingNeeded = true;
-        nextExpectedID++;
 
-        // Clear the string stream, update the number of users and ignore all characters before the start of the next user array
-        userDataSS.clear();
-        numUsers++;
-        inFS.ignore(); // remove either whitespace char or tab char
+    // ------------------ Number the users, and place each user by ID ------------------ //
+    // Every internal structure uses a dense 32-bit index for each user (index + 1 is the internal ID). When the IDs in
+    // the file are exactly 1 to numUsers, the index of a user is their ID - 1, and no table is needed. Otherwise, the
+    // IDs in the file are sorted into the externalIds table, and the index of a user is the position of their ID in
+    // it, so the users stay in ID order either way. An ID that appears more than once is reported.
+    Stats::ScopedTimer placeTimer(Stats::PLACE_USERS);
+    bool denseIds = true;
+    for (const ParsedChunk& currChunk : chunkUsers) {
+        for (const ParsedUser& parsedUser : currChunk.users) {
+            if (parsedUser.id == 0 || parsedUser.id > numUsers) denseIds = false;
+        }
     }
-    // Close the input filestream
-    inFS.close();
 
-
-    // ------------------ Sort the User Array ------------------ //
-    if (userSortingNeeded) {
-        sort(this->users.begin(), this->users.end());
+    uint64_t duplicateID = 0;
+    bool hasDuplicate = false;
+    if (denseIds) {
+        vector<bool> seen(numUsers, false);
+        for (const ParsedChunk& currChunk : chunkUsers) {
+            for (const ParsedUser& parsedUser : currChunk.users) {
+                if (seen[parsedUser.id - 1] && !hasDuplicate) {
+                    duplicateID = parsedUser.id;
+                    hasDuplicate = true;
+                }
+                seen[parsedUser.id - 1] = true;
+            }
+        }
+    }
+    else {
+        externalIds.reserve(numUsers);
+        for (const ParsedChunk& currChunk : chunkUsers) {
+            for (const ParsedUser& parsedUser : currChunk.users) externalIds.push_back(parsedUser.id);
+        }
+        sort(externalIds.begin(), externalIds.end());
+        auto duplicate = adjacent_find(externalIds.begin(), externalIds.end());
+        if (duplicate != externalIds.end()) {
+            duplicateID = *duplicate;
+            hasDuplicate = true;
+        }
+    }
+    if (hasDuplicate) {
+        cerr << "INVALID USERS FILE - USER ID " << duplicateID << " APPEARS MORE THAN ONCE" << endl;
+        exit(1);
     }
 
+    // Create each user straight in its slot of the users array (so the array is sorted by ID without sorting it), with
+    // its follows translated to internal IDs. The follows of every user are kept in one array in the follows arena (a
+    // single allocation, rather than one per user), where each chunk fills the part that starts at the number of
+    // follows of the chunks before it. Every user has their own slot, so the chunks are placed in parallel.
+    this->users.resize(numUsers);
+    unsigned int* allFollows = this->followsArena->allocate(numFollows);
+    vector<size_t> chunkFollowsBegin(chunkUsers.size() + 1, 0);
+    for (size_t chunk = 0; chunk < chunkUsers.size(); chunk++) {
+        chunkFollowsBegin[chunk + 1] = chunkFollowsBegin[chunk] + chunkUsers[chunk].follows.size();
+    }
+    assert(chunkFollowsBegin.back() == numFollows);
+    pool.parallelFor(0, chunkUsers.size(), 1, [&](unsigned int, size_t chunk) {
+        ParsedChunk& currChunk = chunkUsers[chunk];
+        unsigned int* chunkFollows = allFollows + chunkFollowsBegin[chunk];
+        for (const ParsedUser& parsedUser : currChunk.users) {
+            unsigned int currIndex = 0;
+            bool found = this->findUserIndex(parsedUser.id, currIndex);
+            assert(found);
 
-    // ------------------ Create the 2D follower relationship array and 1D array of names ------------------ //
-
-    // Reserve the userNames vector so that resizing does not occur during its creation
-    userNames.reserve(numUsers);
+            unsigned int* follows = chunkFollows + parsedUser.followsBegin;
+            for (size_t f = parsedUser.followsBegin; f < parsedUser.followsEnd; f++) {
+                unsigned int followedIndex = 0;
+                if (!this->findUserIndex(currChunk.follows[f], followedIndex)) {
+                    cerr << "INVALID USERS FILE - USER ID " << parsedUser.id << " FOLLOWS USER ID " << currChunk.follows[f]
+                         << ", WHICH IS NOT IN THE FILE" << endl;
+                    exit(1);
+                }
+                follows[f - parsedUser.followsBegin] = followedIndex + 1;
+            }
 
-    // Creates a 2D array of booleans where a row represents a single user and a column represents which other users they follow
-    for (int i = 0; i < numUsers; i++) {
+            this->users[currIndex] = User(currIndex + 1, parsedUser.name, parsedUser.location, parsedUser.pic_url,
+                                          IdSpan(follows, parsedUser.followsEnd - parsedUser.followsBegin));
+            assert(this->users[currIndex].isValid());
+        }
+        currChunk = ParsedChunk();
+    });
+    placeTimer.stop();
 
-        // Initialize a users row with all false and make a pointer to the current users
-        vector<bool> row(numUsers, false);
-        User* curUser = &users[i];
 
-        // For each followed user, change each element with an index of (followedUserID - 1) in the relationship's matrix to true
-        for (int j = 0; j < curUser->getFollowsSize(); j++) {
-            unsigned int followerIndex = curUser->getFollowsIdAt(j) - 1;
-            row[followerIndex] = true;
-        }
+    // ------------------ Create the follows/followers indices and 1D array of names ------------------ //
 
-        // Add the user follower row to the 2D array
-        followerRelationShips.push_back(row);
+    // Creates the compressed sparse row index of who each user follows, and the matching reverse index of who follows
+    // each user. Both use O(numUsers + numFollows) memory.
+    Stats::ScopedTimer buildTimer(Stats::BUILD_INDICES);
+    followsIndex = AdjacencyIndex(users);
+    followersIndex = followsIndex.transposed();
+    buildTimer.stop();
+    Stats::add(Stats::EDGES, followsIndex.getNumEdges());
 
-        // Add the username to the usernames vector
-        userNames.push_back(curUser->getName());
+    // Reserve the userNames vector so that resizing does not occur during its creation. The names are views of the same
+    // strings that the users hold, so they are not copied again.
+    Stats::ScopedTimer namesTimer(Stats::USER_NAMES);
+    userNames.reserve(numUsers);
+    for (const User& curUser : users) {
+        userNames.push_back(curUser.getName());
     }
 }
 
 
 // ------------------------------------------------ PUBLIC METHODS -------------------------------------------------- //
 
-void SocialNetwork::createAllHTMLFiles() {
+void SocialNetwork::createAllHTMLFiles(const OutputOptions& options, const vector<unsigned int>& changedIDs) const {
     /*
      *  Creates all the html files for the Social Network object (1 "index.html" file and N = numUsers "userN.html" files)
      *  Exports all files to the standard location for the compiler (ex: the cmake-build-debug directory in CLion).
      *
      *  Parameters:
-     *      Takes no parameters.
+     *      const OutputOptions& options:
+     *          The options that control how the files are created (such as the number of threads to use).
+     *
+     *      const vector<unsigned int>& changedIDs:
+     *          The IDs of users whose pages are known to have changed since the pages were last created (such as the
+     *          IDs returned by applyDelta). Only used by an incremental run, which re-creates them along with the
+     *          pages that it finds changed.
      *
      *  Returns:
      *      Returns nothing.
@@ -166,17 +316,620 @@ void SocialNetwork::createAllHTMLFiles() {
         exit(1);
     }
 
+    // The compressed indices only support the plain pages, and the incremental state only knows of the plain files
+    assert(!this->indicesCompressed || (!options.incremental && !options.rankIndex && options.numSuggestions == 0));
+    assert(!options.incremental || options.pageFormats == PageCompressor::PLAIN);
+
+
+    // Only re-create the files that changed, if asked to
+    if (options.incremental) {
+        this->createChangedHTMLFiles(options, changedIDs);
+        return;
+    }
+
+    // A full run makes any saved incremental state out of date, so it is removed (unless the pages go into an
+    // archive, which leaves the files that the state describes as they are)
+    if (options.archiveFilename.empty()) remove(IncrementalState::FILENAME);
+
+    // Render the link to every user once (in the layout of the pages), which every page then copies
+    Stats::ScopedTimer linksTimer(Stats::LINK_TABLE);
+    OutputLayout layout(options.shardLevels, options.pageSize);
+    NameTable names = this->getUserNames();
+    names.setLayout(&layout);
+    LinkTable links(names);
+    names.setLinks(links.getOffsets(), links.getData());
+    linksTimer.stop();
+
+    // Create all the files (or all the entries of the archive)
+    unique_ptr<PageArchive> archive;
+    if (!options.archiveFilename.empty()) {
+        archive = make_unique<PageArchive>(options.archiveFilename);
+        if (!archive->isOpen()) {
+            cerr << "COULD NOT CREATE THE ARCHIVE " << options.archiveFilename << endl;
+            exit(1);
+        }
+    }
+
+    // List the users of the index by their PageRank, if asked to
+    vector<unsigned int> rankOrder;
+    if (options.rankIndex) {
+        Stats::ScopedTimer analyticsTimer(Stats::ANALYTICS);
+        GraphAnalytics analytics(this->followsIndex, this->followersIndex, options.numJobs, options.userOrdering);
+        rankOrder = GraphAnalytics::rankOrder(analytics.pageRank(options.pageRankIterations));
+    }
 
-    // Create all the files
-    this->createIndexHTMLFile();
-    this->createAllUserHTMLPAGES();
+    createIndexHTMLFile(names, SIZE_MAX, archive.get(), options.numJobs, options.rankIndex ? &rankOrder : nullptr,
+                        options.pageFormats);
+    Stats::ScopedTimer timer(Stats::USER_PAGES);
+    this->createAllUserHTMLPAGES(names, options.numJobs, archive.get(), options.numSuggestions,
+                                 options.writeQueueBatches, options.pageFormats);
+    if (archive && !archive->finish()) {
+        cerr << "COULD NOT WRITE THE ARCHIVE " << options.archiveFilename << endl;
+        exit(1);
+    }
 }
 
 
-// ------------------------------------------------ PRIVATE METHODS ------------------------------------------------- //
+bool SocialNetwork::saveSnapshot(const string& filename) const {
+    /*
+     *  Saves a binary snapshot of the social network, which can later be opened (by passing its filename to the
+     *  constructor) without parsing the JSON file again. If the indices are compressed, they are saved compressed.
+     *
+     *  Parameters:
+     *      const string& filename:
+     *          The name of the snapshot file to write
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if the snapshot was saved.
+     *          Otherwise, returns false.
+     */
+
+    Stats::ScopedTimer timer(Stats::SAVE_SNAPSHOT);
+    if (this->indicesCompressed) {
+        return NetworkSnapshot::write(filename, this->users, this->externalIds, this->compressedFollows,
+                                      this->compressedFollowers);
+    }
+    return NetworkSnapshot::write(filename, this->users, this->externalIds, this->followsIndex, this->followersIndex);
+}
+
+bool SocialNetwork::writeAnalytics(const string& filename, unsigned int pageRankIterations, unsigned int numJobs,
+                                   UserOrdering::Method ordering) const {
+    /*
+     *  Runs the analytics of GraphAnalytics on the network, and writes them to a CSV file with a header line and one
+     *  line for each user, in ID order:
+     *
+     *      id,name,follows,followers,pagerank,weak_component,strong_component
+     *
+     *  where users are given by their IDs in the input file, follows and followers are counted without duplicates,
+     *  and each component is given by the ID of its smallest user. A summary of the analytics is printed to stdout.
+     *
+     *  Parameters:
+     *      const string& filename:
+     *          The name of the CSV file to write
+     *
+     *      unsigned int pageRankIterations:
+     *          The number of PageRank iterations to run
+     *
+     *      unsigned int numJobs:
+     *          The number of threads to run the analytics with. 0 uses the hardware concurrency.
+     *
+     *      UserOrdering::Method ordering:
+     *          The order to relabel the users in while the analytics run, which only changes how fast they are
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if the file was written.
+     *          Otherwise, returns false.
+     */
+
+    assert(!this->indicesCompressed);
+    Stats::ScopedTimer timer(Stats::ANALYTICS);
+    GraphAnalytics analytics(this->followsIndex, this->followersIndex, numJobs, ordering);
+    double lastChange = 0;
+    const vector<double> ranks = analytics.pageRank(pageRankIterations, GraphAnalytics::DEFAULT_DAMPING, &lastChange);
+    const vector<unsigned int> weak = analytics.weakComponents();
+    const vector<unsigned int> strong = analytics.strongComponents();
+
+    // Write a line for each user, quoting the name (with any quotes in it doubled). The lines are written out about a
+    // MB at a time, so the whole file is never held in memory.
+    const size_t flushSize = 1024 * 1024;
+    PageBuffer csv(flushSize + 1024);
+    bool started = false;
+    auto writeLines = [&]() {
+        if (!(started ? csv.appendToFile(filename) : csv.writeToFile(filename))) return false;
+        started = true;
+        csv.clear();
+        return true;
+    };
+    csv.append("id,name,follows,followers,pagerank,weak_component,strong_component\n");
+    for (unsigned int currIndex = 0; currIndex < this->numUsers; currIndex++) {
+        csv.append(static_cast<unsigned long long>(this->getExternalId(currIndex + 1)));
+        csv.append(",\"");
+        string_view name = this->userNames[currIndex];
+        for (size_t quote = name.find('"'); quote != string_view::npos; quote = name.find('"')) {
+            csv.append(name.substr(0, quote + 1));
+            csv.append("\"");
+            name.remove_prefix(quote + 1);
+        }
+        csv.append(name);
+        csv.append("\",");
+        csv.append(static_cast<unsigned long long>(this->followsIndex.getDegree(currIndex)));
+        csv.append(",");
+        csv.append(static_cast<unsigned long long>(this->followersIndex.getDegree(currIndex)));
+        char rank[32];
+        snprintf(rank, sizeof(rank), ",%.9g,", ranks[currIndex]);
+        csv.append(rank);
+        csv.append(static_cast<unsigned long long>(this->getExternalId(weak[currIndex] + 1)));
+        csv.append(",");
+        csv.append(static_cast<unsigned long long>(this->getExternalId(strong[currIndex] + 1)));
+        csv.append("\n");
+        if (csv.getSize() > flushSize && !writeLines()) return false;
+    }
+    if (!writeLines()) return false;
+
+    // Print the summary
+    size_t largestWeak = 0;
+    size_t largestStrong = 0;
+    const size_t numWeak = GraphAnalytics::countComponents(weak, largestWeak);
+    const size_t numStrong = GraphAnalytics::countComponents(strong, largestStrong);
+    cout << "Analytics of " << this->numUsers << " users and " << this->followsIndex.getNumEdges() << " follows\n"
+         << "  weakly connected components: " << numWeak << " (the largest has " << largestWeak << " users)\n"
+         << "  strongly connected components: " << numStrong << " (the largest has " << largestStrong << " users)\n"
+         << "  PageRank: " << pageRankIterations << " iterations (the ranks changed by " << lastChange
+         << " in total in the last one)\n";
+
+    // Print the histograms of the follows and followers, side by side
+    const vector<size_t> followsHistogram = GraphAnalytics::degreeHistogram(this->followsIndex);
+    const vector<size_t> followersHistogram = GraphAnalytics::degreeHistogram(this->followersIndex);
+    char line[96];
+    snprintf(line, sizeof(line), "  %-22s %12s %12s\n", "users by degree", "follows", "followers");
+    cout << line;
+    for (size_t bucket = 0; bucket < max(followsHistogram.size(), followersHistogram.size()); bucket++) {
+        const unsigned long long low = bucket == 0 ? 0 : 1ull << (bucket - 1);
+        const unsigned long long high = bucket == 0 ? 0 : (1ull << bucket) - 1;
+        const string degrees = low == high ? to_string(low) : to_string(low) + "-" + to_string(high);
+        snprintf(line, sizeof(line), "  %-22s %12zu %12zu\n", degrees.c_str(),
+                 bucket < followsHistogram.size() ? followsHistogram[bucket] : size_t(0),
+                 bucket < followersHistogram.size() ? followersHistogram[bucket] : size_t(0));
+        cout << line;
+    }
+    cout << flush;
+    return true;
+}
+
+
+void SocialNetwork::createIndexHTMLFile(const NameTable& userNames, size_t flushSize, PageArchive* archive,
+                                        unsigned int numJobs, const vector<unsigned int>* order,
+                                        unsigned int formats) {
+    /*
+     *  Creates an index.html file for a social network object.
+     *
+     *  The created index.html file contains links to all user profile pages. This method assumes that all of these pages
+     *  were created without error. However, an assertion is made that each user profile html file is made for each user.
+     *  Thus, if no errors are raised, it can be assumed that all files were created successfully.
+     *
+     *  If the layout of userNames has a page size and there are more users than it, the list is instead split over
+     *  numbered index pages (index.html, index_2.html, ...), each linking to the previous and next one. Every index
+     *  page is bounded by the page size, so they are rendered whole, in parallel, and flushSize is not needed.
+     *
+     *  A file is created for each of the formats, such as index.html.gz, with the same page compressed (in the pieces
+     *  of flushSize bytes that it is written in, so a large index is still never held in memory whole).
+     *
+     *  Parameters:
+     *      const NameTable& userNames:
+     *          The name (and ID in the input file) of every user in the social network, in ID order
+     *
+     *      size_t flushSize:
+     *          Once the rendered part of the file is larger than this, it is written out and the buffer is reused, so
+     *          the memory used stays bounded. By default the whole file is rendered and then written with one write.
+     *
+     *      PageArchive* archive:
+     *          The archive to add index.html to, or nullptr to create the file
+     *
+     *      unsigned int numJobs:
+     *          The number of threads to create the index pages with, if there is more than one. 0 uses the hardware
+     *          concurrency.
+     *
+     *      const vector<unsigned int>* order:
+     *          The 0-based index of every user, in the order to list them, or nullptr to list them by ID
+     *
+     *      unsigned int formats:
+     *          The formats (the bits of PageCompressor::Format) to create the file in
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    Stats::ScopedTimer timer(Stats::INDEX_PAGE);
+    const size_t numUsers = userNames.size();
+    const OutputLayout& layout = userNames.getLayout();
+    const size_t numPages = layout.getNumListPages(numUsers);
+    if (numPages > 1) {
+        createIndexHTMLPages(userNames, numPages, archive, numJobs, order, formats);
+        return;
+    }
+
+    // The file is rendered again for each format, so that each file is written (or added to the archive) whole
+    // before the next one is started
+    PageBuffer page(min(64 * numUsers, flushSize) + 1024);
+    PageBuffer compressed;
+    PageCompressor compressor;
+    for (PageCompressor::Format format : PageCompressor::FORMATS) {
+        if ((formats & format) == 0) continue;
+        const string filename = string("index.html") + PageCompressor::getExtension(format);
+        bool started = false;   // whether the beginning of the file was written out already
+        if (format != PageCompressor::PLAIN) compressor.begin(format);
+
+        // Render the whole file (or flushSize bytes of it at a time) into a single buffer, and write it (compressed in
+        // the same pieces, if the format is compressed)
+        page.clear();
+        auto writePage = [&](bool finish) {
+            const PageBuffer* contents = &page;
+            bool written = true;
+            if (format != PageCompressor::PLAIN) {
+                compressed.clear();
+                written = compressor.compress(page.getContents(), compressed, finish);
+                contents = &compressed;
+            }
+            if (archive != nullptr) {
+                written = written && (started || archive->beginEntry(filename)) && archive->writeToEntry(*contents);
+            }
+            else {
+                written = written && (started ? contents->appendToFile(filename) : contents->writeToFile(filename));
+            }
+            if (!written) {
+                cerr << "COULD NOT WRITE THE INDEX PAGE " << filename << endl;
+                exit(1);
+            }
+            started = true;
+            page.clear();
+        };
+
+        // Add the universal html information to the page
+        page.append("<!DOCTYPE html>\n"
+                    "<html>\n"
+                    "<head>\n"
+                    "<title>My Social Network</title>\n"
+                    "</head>\n"
+                    "<body>\n"
+                    "<h1>My Social Network: User List</h1>\n");
+
+        // Create an ordered list containing links to each user (copied from the link table of userNames, if it has
+        // one)
+        page.append("<ol>\n");
+        assert(order == nullptr || order->size() == numUsers);
+        for (unsigned int currUserID = 1; currUserID <= numUsers; currUserID++) {
+            userNames.appendRootLink(page, order != nullptr ? (*order)[currUserID - 1] : currUserID - 1);
+            if (page.getSize() > flushSize) writePage(false);
+        }
+
+        // Add the final closing tags for the html file
+        page.append("</ol>\n"
+                    "</body>\n"
+                    "</html>\n");
+
+        // Write the (rest of the) file with a single write
+        writePage(true);
+        if (archive != nullptr && !archive->endEntry()) {
+            cerr << "COULD NOT WRITE THE INDEX PAGE " << filename << endl;
+            exit(1);
+        }
+    }
+    Stats::add(Stats::PAGES_WRITTEN, 1);
+}
+
+unsigned int SocialNetwork::getNumUsers() const {
+    /*
+     *  Returns the number of users in the social network
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      unsigned int:
+     *          The number of users
+     */
+
+    return numUsers;
+}
+
+const User& SocialNetwork::getUser(unsigned int id) const {
+    /*
+     *  Returns the user with a certain ID
+     *  ASSERTS that the ID is valid
+     *
+     *  Parameters:
+     *      unsigned int id:
+     *          The ID of the user, from 1 to the number of users
+     *
+     *  Returns:
+     *      const User&:
+     *          The user, which is valid for as long as the social network is
+     */
+
+    assert(id > 0 && id <= numUsers);
+    return users[id - 1];
+}
+
+bool SocialNetwork::applyDelta(const NetworkDelta& delta, vector<unsigned int>& changedIDs, string& error) {
+    /*
+     *  Applies a batch of changes (follows, unfollows, new users and renames) to the network, in the order given.
+     *
+     *  Every change is checked before anything is changed, so an invalid delta leaves the network as it was. The new
+     *  users are added to the end of the users (so they get the next internal IDs, and the table of IDs in the input
+     *  file stays sorted). The follows and unfollows that change an edge are kept in order, and the follows list of each
+     *  user that they change is then rebuilt once (so a batch of k changes to a user with d follows is O(d log k + k),
+     *  not O(k * d)). The net change of each edge is kept, so an edge that is followed and unfollowed in the same delta
+     *  is not changed. New follows and followers indices are then built from the old ones and the net changes (see
+     *  AdjacencyIndex::withEdgeChanges), which copies the arrays of each index once, but does not rebuild them from the
+     *  follows lists. The mutuals are found from them as before.
+     *
+     *  The pages that change are the page of every user whose follows list changed, the pages of both users of every
+     *  edge that changed overall (their follows, followers and mutuals lists), the page of every new or renamed user,
+     *  and the page of every user that lists a renamed user. The index page changes if a user was added or renamed.
+     *  ASSERTS that the indices are not compressed
+     *
+     *  Parameters:
+     *      const NetworkDelta& delta:
+     *          The changes to apply
+     *
+     *      vector<unsigned int>& changedIDs:
+     *          Set to the sorted internal IDs of every user whose page changed
+     *
+     *      string& error:
+     *          Set to the reason that the delta could not be applied, if it could not
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if the delta was applied.
+     *          Otherwise, returns false.
+     */
+
+    assert(!this->indicesCompressed);
+    Stats::ScopedTimer deltaTimer(Stats::APPLY_DELTA);
+    const vector<NetworkDelta::Change>& changes = delta.getChanges();
+    changedIDs.clear();
+
+    // Check every change, keeping track of the users that the earlier changes add
+    const unsigned int oldNumUsers = numUsers;
+    uint64_t largestId = oldNumUsers == 0 ? 0 : this->getExternalId(oldNumUsers);
+    vector<const NetworkDelta::Change*> newUsers;
+    vector<uint64_t> newIds;    // sorted, as every new ID is larger than the ones before it
+    auto userExists = [&](uint64_t id) {
+        unsigned int index = 0;
+        return this->findUserIndex(id, index) || binary_search(newIds.begin(), newIds.end(), id);
+    };
+    for (const NetworkDelta::Change& change : changes) {
+        const string userText = "USER ID " + to_string(change.userId);
+        if (change.type == NetworkDelta::ADD_USER) {
+            if (userExists(change.userId)) error = userText + " ALREADY EXISTS";
+            else if (change.userId <= largestId) error = "THE NEW " + userText + " IS NOT LARGER THAN EVERY OTHER ID";
+            else if (oldNumUsers + newUsers.size() >= UINT32_MAX) error = "THERE ARE TOO MANY USERS TO ADD " + userText;
+        }
+        else if (!userExists(change.userId)) {
+            error = "THERE IS NO " + userText;
+        }
+        else if ((change.type == NetworkDelta::FOLLOW || change.type == NetworkDelta::UNFOLLOW) &&
+                 !userExists(change.otherId)) {
+            error = "THERE IS NO USER ID " + to_string(change.otherId);
+        }
+        if ((change.type == NetworkDelta::ADD_USER || change.type == NetworkDelta::RENAME) && change.name.empty() &&
+            error.empty()) {
+            error = "THE NAME OF " + userText + " IS EMPTY";
+        }
+        if (!error.empty()) return false;
+
+        if (change.type == NetworkDelta::ADD_USER) {
+            newUsers.push_back(&change);
+            newIds.push_back(change.userId);
+            largestId = change.userId;
+        }
+    }
+
+    // Add the new users. The IDs stay 1 to the number of users, while the new users continue them, and a table of IDs
+    // is created as soon as they do not.
+    for (const NetworkDelta::Change* added : newUsers) {
+        if (this->externalIds.empty() && added->userId != uint64_t(numUsers) + 1) {
+            this->externalIds.resize(numUsers);
+            iota(this->externalIds.begin(), this->externalIds.end(), uint64_t(1));
+        }
+        if (!this->externalIds.empty()) this->externalIds.push_back(added->userId);
+
+        numUsers++;
+        this->users.emplace_back(numUsers, this->strings->store(added->name), string_view(), string_view(),
+                                 IdSpan());
+        this->userNames.push_back(this->users.back().getName());
+    }
+
+    // Apply the changes in order. Each follow or unfollow that changes an edge is kept in edgeChanges, and
+    // lastEdgeChanges holds the last of them for each edge that changed, keyed by (from << 32 | to).
+    struct EdgeChange {
+        unsigned int from;
+        unsigned int to;
+        bool follow;
+    };
+    vector<EdgeChange> edgeChanges;
+    unordered_map<uint64_t, size_t> lastEdgeChanges;
+    auto hadEdge = [&](unsigned int from, unsigned int to) {
+        return from < oldNumUsers && to < oldNumUsers && this->followsIndex.hasEdge(from, to);
+    };
+    vector<unsigned int> changedIndices;
+    vector<unsigned int> renamedIndices;
+    for (const NetworkDelta::Change& change : changes) {
+        unsigned int userIndex = 0;
+        bool found = this->findUserIndex(change.userId, userIndex);
+        assert(found);
+
+        if (change.type == NetworkDelta::ADD_USER) {
+            changedIndices.push_back(userIndex);
+        }
+        else if (change.type == NetworkDelta::RENAME) {
+            this->users[userIndex].setName(this->strings->store(change.name));
+            this->userNames[userIndex] = this->users[userIndex].getName();
+            changedIndices.push_back(userIndex);
+            renamedIndices.push_back(userIndex);
+        }
+        else {
+            unsigned int otherIndex = 0;
+            found = this->findUserIndex(change.otherId, otherIndex);
+            assert(found);
+
+            const uint64_t edgeKey = uint64_t(userIndex) << 32 | otherIndex;
+            auto lastChange = lastEdgeChanges.find(edgeKey);
+            const bool hasEdge = lastChange != lastEdgeChanges.end() ? edgeChanges[lastChange->second].follow
+                                                                     : hadEdge(userIndex, otherIndex);
+            const bool follow = change.type == NetworkDelta::FOLLOW;
+            if (hasEdge == follow) continue;
+
+            lastEdgeChanges[edgeKey] = edgeChanges.size();
+            edgeChanges.push_back({userIndex, otherIndex, follow});
+        }
+    }
+
+    // Rebuild the follows list of each user whose follows changed once, rather than once per change. Every unfollow
+    // removes the user from the list (including where they were in it before the delta), and a user followed again
+    // afterwards goes to the end of the list, at the place of their last follow (as if each change was made in turn).
+    vector<size_t> changeOrder(edgeChanges.size());
+    iota(changeOrder.begin(), changeOrder.end(), size_t(0));
+    stable_sort(changeOrder.begin(), changeOrder.end(), [&](size_t a, size_t b) {
+        return edgeChanges[a].from < edgeChanges[b].from;
+    });
+    vector<unsigned int> removedIDs;
+    vector<unsigned int> addedIDs;
+    for (size_t first = 0; first < changeOrder.size();) {
+        const unsigned int from = edgeChanges[changeOrder[first]].from;
+        removedIDs.clear();
+        addedIDs.clear();
+        size_t last = first;
+        for (; last < changeOrder.size() && edgeChanges[changeOrder[last]].from == from; last++) {
+            const size_t changeIndex = changeOrder[last];
+            const EdgeChange& edgeChange = edgeChanges[changeIndex];
+            if (!edgeChange.follow) removedIDs.push_back(edgeChange.to + 1);
+            else if (lastEdgeChanges[uint64_t(from) << 32 | edgeChange.to] == changeIndex) {
+                addedIDs.push_back(edgeChange.to + 1);
+            }
+        }
+        sort(removedIDs.begin(), removedIDs.end());
+        this->users[from].changeFollows(removedIDs, addedIDs, *this->followsArena);
+        changedIndices.push_back(from);
+        first = last;
+    }
+
+    // Patch both indices with the edges that were added or removed overall
+    vector<pair<unsigned int, unsigned int>> addedEdges;
+    vector<pair<unsigned int, unsigned int>> removedEdges;
+    for (const auto& [edgeKey, lastChange] : lastEdgeChanges) {
+        const unsigned int from = edgeKey >> 32;
+        const unsigned int to = edgeKey & UINT32_MAX;
+        const bool exists = edgeChanges[lastChange].follow;
+        if (exists == hadEdge(from, to)) continue;
+        (exists ? addedEdges : removedEdges).emplace_back(from, to);
+        changedIndices.push_back(to);
+    }
+    auto reversed = [](vector<pair<unsigned int, unsigned int>> edges) {
+        for (auto& edge : edges) swap(edge.first, edge.second);
+        sort(edges.begin(), edges.end());
+        return edges;
+    };
+    sort(addedEdges.begin(), addedEdges.end());
+    sort(removedEdges.begin(), removedEdges.end());
+    this->followersIndex = this->followersIndex.withEdgeChanges(numUsers, reversed(addedEdges), reversed(removedEdges));
+    this->followsIndex = this->followsIndex.withEdgeChanges(numUsers, addedEdges, removedEdges);
+
+    // A renamed user is listed on the pages of the users they follow and the users that follow them
+    for (unsigned int renamedIndex : renamedIndices) {
+        changedIndices.insert(changedIndices.end(), this->followsIndex.rowBegin(renamedIndex),
+                              this->followsIndex.rowEnd(renamedIndex));
+        changedIndices.insert(changedIndices.end(), this->followersIndex.rowBegin(renamedIndex),
+                              this->followersIndex.rowEnd(renamedIndex));
+    }
+    sort(changedIndices.begin(), changedIndices.end());
+    changedIndices.erase(unique(changedIndices.begin(), changedIndices.end()), changedIndices.end());
+    changedIDs.reserve(changedIndices.size());
+    for (unsigned int changedIndex : changedIndices) changedIDs.push_back(changedIndex + 1);
+
+    Stats::add(Stats::DELTA_CHANGES, changes.size());
+    return true;
+}
+
+void SocialNetwork::compressIndices(unsigned int numJobs) {
+    /*
+     *  Replaces the follows and followers indices with compressed copies of them (see CompressedIndex), and frees the
+     *  CSR arrays. Does nothing if they are already compressed.
+     *
+     *  Parameters:
+     *      unsigned int numJobs:
+     *          The number of threads to compress the indices with. 0 uses the hardware concurrency.
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    if (this->indicesCompressed) return;
+    Stats::ScopedTimer timer(Stats::COMPRESS_INDICES);
+    this->compressedFollows = CompressedIndex(this->followsIndex, numJobs);
+    this->compressedFollowers = CompressedIndex(this->followersIndex, numJobs);
+    this->followsIndex = AdjacencyIndex();
+    this->followersIndex = AdjacencyIndex();
+    this->indicesCompressed = true;
+}
+
+void SocialNetwork::decompressIndices(unsigned int numJobs) {
+    /*
+     *  Replaces the compressed follows and followers indices with their CSR arrays. Does nothing if they are not
+     *  compressed.
+     *
+     *  Parameters:
+     *      unsigned int numJobs:
+     *          The number of threads to decompress the indices with. 0 uses the hardware concurrency.
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    if (!this->indicesCompressed) return;
+    Stats::ScopedTimer timer(Stats::COMPRESS_INDICES);
+    this->followsIndex = this->compressedFollows.decompressed(numJobs);
+    this->followersIndex = this->compressedFollowers.decompressed(numJobs);
+    this->compressedFollows = CompressedIndex();
+    this->compressedFollowers = CompressedIndex();
+    this->indicesCompressed = false;
+}
+
+bool SocialNetwork::hasCompressedIndices() const {
+    /*
+     *  Checks if the follows and followers indices are compressed
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if the indices are compressed.
+     *          Otherwise, returns false.
+     */
+
+    return this->indicesCompressed;
+}
+
+NameTable SocialNetwork::getUserNames() const {
+    /*
+     *  Returns a table of the name of every user, in ID order, along with the ID of each user in the input file
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      NameTable:
+     *          A view of the names and IDs, which is valid for as long as the social network is
+     */
+
+    return NameTable(userNames, externalIds.empty() ? nullptr : externalIds.data());
+}
 
 void SocialNetwork::getFollowerAndMutualsFromId(vector<unsigned int> &followers, vector<unsigned int> &mutuals,
-                                                const unsigned int& currID) {
+                                                const unsigned int& currID) const {
     /*
      *  Adds the ids of the users that are followers of and mutuals with a certain user (given by currID) to the pass
      *  by reference vectors
@@ -191,24 +944,114 @@ void SocialNetwork::getFollowerAndMutualsFromId(vector<unsigned int> &followers,
      *      const unsigned int& currID:
      *          The id of the user who is being checked for mutual
      *
+     *  Notes:
+     *      1) The followers come straight from the reverse (followers) index, which is built once for all users by
+     *         inverting every follows list. The mutuals are the intersection of the sorted follows and followers rows
+     *         (see SortedIntersection), which is at most O(followers + follows) for a user, and far less for a user
+     *         whose rows differ greatly in size. So creating every user page is O(N + E) in total.
+     *
      *  Returns:
      *      Returns Nothing
      */
 
-    for (unsigned int otherID = 1; otherID <= numUsers; otherID++) {
+    assert(currID > 0 && currID <= numUsers);
+    const unsigned int currIndex = currID - 1;
 
-        if (currID != otherID && this->isFollowing(otherID, currID)) {
-            followers.push_back(otherID);
+    // The followers of a user are the row of the reverse index, which is already sorted by ID (A user that follows
+    // themselves is not considered to be their own follower). The rows of compressed indices are decoded to the end of
+    // followers (the follows after the followers), and the follows are dropped again once the mutuals are found.
+    const size_t followersStart = followers.size();
+    const unsigned int* followersBegin;
+    const unsigned int* followersEnd;
+    const unsigned int* followsBegin;
+    size_t numFollows;
+    if (this->indicesCompressed) {
+        this->compressedFollowers.decodeRow(currIndex, followers);
+        const size_t followsStart = followers.size();
+        this->compressedFollows.decodeRow(currIndex, followers);
+        followersBegin = followers.data() + followersStart;
+        followersEnd = followers.data() + followsStart;
+        followsBegin = followersEnd;
+        numFollows = followers.size() - followsStart;
+    }
+    else {
+        followersBegin = this->followersIndex.rowBegin(currIndex);
+        followersEnd = this->followersIndex.rowEnd(currIndex);
+        followsBegin = this->followsIndex.rowBegin(currIndex);
+        numFollows = this->followsIndex.rowEnd(currIndex) - followsBegin;
+    }
 
-            if (this->isFollowing(currID, otherID)) {
-                mutuals.push_back(otherID);
-            }
+    // The mutuals of a user are the intersection of the sorted follows and followers rows. The intersection is written
+    // straight into the vector, then converted from indices to IDs (dropping the user, if they follow themselves).
+    const size_t numFollowers = followersEnd - followersBegin;
+    const size_t start = mutuals.size();
+    mutuals.resize(start + min(numFollows, numFollowers));
+    const size_t numMutuals = SortedIntersection::intersect(followsBegin, numFollows, followersBegin, numFollowers,
+                                                            mutuals.data() + start);
+    size_t kept = start;
+    for (size_t i = start; i < start + numMutuals; i++) {
+        if (mutuals[i] != currIndex) mutuals[kept++] = mutuals[i] + 1;
+    }
+    mutuals.resize(kept);
+
+    // Convert the followers to IDs, in place if they were decoded into the vector
+    if (this->indicesCompressed) {
+        kept = followersStart;
+        for (size_t i = followersStart; i < followersStart + numFollowers; i++) {
+            if (followers[i] != currIndex) followers[kept++] = followers[i] + 1;
+        }
+        followers.resize(kept);
+    }
+    else {
+        followers.reserve(followers.size() + numFollowers);
+        for (const unsigned int* it = followersBegin; it != followersEnd; it++) {
+            if (*it != currIndex) followers.push_back(*it + 1);
         }
     }
+}
+
+bool SocialNetwork::findUserId(uint64_t externalId, unsigned int& id) const {
+    /*
+     *  Finds the internal ID of the user with a certain ID in the input file
+     *
+     *  Parameters:
+     *      uint64_t externalId:
+     *          The ID of the user, as written in the input file
+     *
+     *      unsigned int& id:
+     *          Set to the internal ID of the user (from 1 to the number of users), if there is a user with that ID
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if there is a user with that ID.
+     *          Otherwise, returns false (and id is not changed).
+     */
 
+    unsigned int index = 0;
+    if (!this->findUserIndex(externalId, index)) return false;
+    id = index + 1;
+    return true;
 }
 
-bool SocialNetwork::isFollowing(const unsigned int &followerID, const unsigned int &followedID) {
+uint64_t SocialNetwork::getExternalId(unsigned int id) const {
+    /*
+     *  Returns the ID in the input file of the user with a certain internal ID
+     *  ASSERTS that the ID is valid
+     *
+     *  Parameters:
+     *      unsigned int id:
+     *          The internal ID of the user, from 1 to the number of users
+     *
+     *  Returns:
+     *      uint64_t:
+     *          The ID of the user in the input file
+     */
+
+    assert(id > 0 && id <= numUsers);
+    return externalIds.empty() ? id : externalIds[id - 1];
+}
+
+bool SocialNetwork::isFollowing(const unsigned int &followerID, const unsigned int &followedID) const {
     /*
      *  Check if the user with the id "followerID" is following the user with the id "followedID"
      *
@@ -219,6 +1062,10 @@ bool SocialNetwork::isFollowing(const unsigned int &followerID, const unsigned i
      *      const unsigned int &followedID:
      *          Represents the id of the user which is being checked to see if they are followed by the user with followerID
      *
+     *  Notes:
+     *      1) With compressed indices, only the block of the row of "followerID" that could hold "followedID" is
+     *         decoded (see CompressedIndex::hasEdge).
+     *
      *  Returns:
      *      A boolean representing whether user "followerID" follows user "followedID"
      */
@@ -226,60 +1073,183 @@ bool SocialNetwork::isFollowing(const unsigned int &followerID, const unsigned i
     // Make sure that both ID numbers are valid
     assert(followerID > 0 && followedID > 0);
 
-    return this->followerRelationShips[followerID - 1][followedID - 1];
+    if (this->indicesCompressed) return this->compressedFollows.hasEdge(followerID - 1, followedID - 1);
+    return this->followsIndex.hasEdge(followerID - 1, followedID - 1);
 }
 
-void SocialNetwork::createIndexHTMLFile() {
+size_t SocialNetwork::getUserList(unsigned int id, OutputLayout::UserList list, size_t offset, size_t limit,
+                                  vector<unsigned int>& ids) const {
     /*
-     *  Creates an index.html file for a social network object.
+     *  Adds a page of one list of a user to ids: the users at positions offset to offset + limit - 1 of the list (or
+     *  to the end of the list, if it is shorter). The lists are the same as on the user's HTML page.
+     *  ASSERTS that the ID is valid
      *
-     *  The created index.html file contains links to all user profile pages. This method assumes that all of these pages
-     *  were created without error. However, an assertion is made that each user profile html file is made for each user.
-     *  Thus, if no errors are raised, it can be assumed that all files were created successfully.
+     *  Parameters:
+     *      unsigned int id:
+     *          The internal ID of the user
+     *
+     *      OutputLayout::UserList list:
+     *          Which list of the user to look up
+     *
+     *      size_t offset:
+     *          The position in the list of the first user to add
+     *
+     *      size_t limit:
+     *          The largest number of users to add (0 only returns the length of the list)
+     *
+     *      vector<unsigned int>& ids:
+     *          The vector to add the internal IDs of the users to
+     *
+     *  Notes:
+     *      1) A page of follows or followers is copied straight from the user or the followers index, so it costs
+     *         O(limit) however long the list is (with compressed indices, the row of followers is decoded first). A
+     *         page of mutuals needs the whole intersection, which is found with SortedIntersection.
+     *
+     *  Returns:
+     *      size_t:
+     *          The number of users in the whole list
+     */
+
+    assert(id > 0 && id <= numUsers);
+    const unsigned int index = id - 1;
+
+    // Adds the part of a list that the page covers to ids, given a function that returns the user at a position
+    auto addPage = [&](size_t listSize, auto userAt) {
+        for (size_t i = offset; i < listSize && i - offset < limit; i++) ids.push_back(userAt(i));
+        return listSize;
+    };
+
+    if (list == OutputLayout::FOLLOWS) {
+        const IdSpan follows = this->users[index].getFollows();
+        return addPage(follows.size(), [&](size_t i) { return follows[i]; });
+    }
+
+    if (list == OutputLayout::FOLLOWERS) {
+        // The row is sorted, so the user (if they follow themselves) can be skipped without copying the row
+        vector<unsigned int> decodedRow;
+        if (this->indicesCompressed) this->compressedFollowers.decodeRow(index, decodedRow);
+        const unsigned int* followersBegin = this->indicesCompressed ? decodedRow.data()
+                                                                     : this->followersIndex.rowBegin(index);
+        const unsigned int* followersEnd = this->indicesCompressed ? decodedRow.data() + decodedRow.size()
+                                                                   : this->followersIndex.rowEnd(index);
+        const size_t selfPosition = lower_bound(followersBegin, followersEnd, index) - followersBegin;
+        const bool followsSelf = followersBegin + selfPosition != followersEnd && followersBegin[selfPosition] == index;
+        return addPage((followersEnd - followersBegin) - followsSelf, [&](size_t i) {
+            return followersBegin[i + (followsSelf && i >= selfPosition)] + 1;
+        });
+    }
+
+    assert(list == OutputLayout::MUTUALS);
+    vector<unsigned int> followers;
+    vector<unsigned int> mutuals;
+    this->getFollowerAndMutualsFromId(followers, mutuals, id);
+    return addPage(mutuals.size(), [&](size_t i) { return mutuals[i]; });
+}
+
+// ------------------------------------------------ PRIVATE METHODS ------------------------------------------------- //
+
+void SocialNetwork::loadSnapshot(const string& filename) {
+    /*
+     *  Opens the social network from a binary snapshot file.
+     *
+     *  The snapshot is memory mapped, and the follows and followers indices use the CSR arrays (or the compressed rows)
+     *  inside the mapping directly, so the relationships are neither parsed nor copied. The users and userNames are
+     *  created from the user records, and view the strings in the string table of the snapshot directly, so the strings
+     *  are not copied either. The string pool keeps the mapping alive for as long as the network.
      *
      *  Parameters:
-     *      Takes no parameters.
+     *      const string& filename:
+     *          The name of the snapshot file
      *
      *  Returns:
      *      Returns nothing.
      */
 
-    // Create the output file stream and make sure that it is open
-    ofstream out;
-    out.open("index.html");
-    assert(out.is_open());
-
-    // Add the universal html information to the file stream
-    out << "<!DOCTYPE html>" << endl;
-    out << "<html>" << endl;
-    out << "<head>" << endl;
-    out << "<title>My Social Network</title>" << endl;
-    out << "</head>" << endl;
-    out << "<body>" << endl;
-    out << "<h1>My Social Network: User List</h1>" << endl;
-
-    // Create an ordered list containing links to each user
-    out << "<ol>" << endl;
-    for (unsigned int currUserID = 1; currUserID <= numUsers; currUserID++) {
-        out << R"(<li><a href="user)" << currUserID << R"(.html">)";
-        out << userNames.at(currUserID - 1) << "</a></li>" << endl;
-    }
-    out << "</ol>" << endl;
-
-    // Add the final closing tags for the html file
-    out << "</body>" << endl;
-    out << "</html>" << endl;
-
-    // Close the file stream
-    out.close();
+    NetworkSnapshot snapshot(filename);
+    if (!snapshot.isValid()) {
+        cerr << "INVALID OR UNSUPPORTED SNAPSHOT FILE - " << filename << endl;
+        exit(1);
+    }
+
+    numUsers = snapshot.getNumUsers();
+    strings->keepAlive(snapshot.getStorage());
+    if (snapshot.hasCompressedIndices()) {
+        compressedFollows = snapshot.getCompressedFollowsIndex();
+        compressedFollowers = snapshot.getCompressedFollowersIndex();
+        indicesCompressed = true;
+    }
+    else {
+        followsIndex = snapshot.getFollowsIndex();
+        followersIndex = snapshot.getFollowersIndex();
+    }
+
+    externalIds = snapshot.getExternalIds();
+
+    users.reserve(numUsers);
+    userNames.reserve(numUsers);
+    for (unsigned int i = 0; i < numUsers; i++) {
+        users.push_back(snapshot.getUser(i));
+        userNames.push_back(users.back().getName());
+    }
 }
 
-void SocialNetwork::createAllUserHTMLPAGES() {
+
+bool SocialNetwork::findUserIndex(uint64_t id, unsigned int& index) const {
+    /*
+     *  Finds the dense 0-based index of the user with a certain ID in the input file
+     *
+     *  Parameters:
+     *      uint64_t id:
+     *          The ID of the user, as written in the input file
+     *
+     *      unsigned int& index:
+     *          Set to the index of the user, if there is a user with that ID
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if there is a user with that ID.
+     *          Otherwise, returns false (and index is not changed).
+     */
+
+    // The IDs are 1 to numUsers, so no table is kept
+    if (externalIds.empty()) {
+        if (id == 0 || id > numUsers) return false;
+        index = id - 1;
+        return true;
+    }
+
+    // Otherwise, the index is the position of the ID in the sorted table
+    auto found = lower_bound(externalIds.begin(), externalIds.end(), id);
+    if (found == externalIds.end() || *found != id) return false;
+    index = found - externalIds.begin();
+    return true;
+}
+
+void SocialNetwork::createAllUserHTMLPAGES(const NameTable& names, unsigned int numJobs, PageArchive* archive,
+                                           unsigned int numSuggestions, size_t writeQueueBatches,
+                                           unsigned int formats) const {
     /*
      *  Creates the user profile html file for each user in the Users array.
      *
      *  Parameters:
-     *      Takes no parameters.
+     *      const NameTable& names:
+     *          The names (and links) of every user, as returned by getUserNames
+     *
+     *      unsigned int numJobs:
+     *          The number of threads to create the pages with. 0 uses the hardware concurrency.
+     *
+     *      PageArchive* archive:
+     *          The archive to add the pages to, or nullptr to create a file for each page
+     *
+     *      unsigned int numSuggestions:
+     *          The largest number of suggested users on each page, or 0 to leave the Suggested list off the pages
+     *
+     *      size_t writeQueueBatches:
+     *          The number of batches of pages that can wait for the writer thread, or 0 to have every worker write
+     *          its own pages
+     *
+     *      unsigned int formats:
+     *          The formats (the bits of PageCompressor::Format) to write each page in
      *
      *  Returns:
      *      Returns nothing.
@@ -288,14 +1258,353 @@ void SocialNetwork::createAllUserHTMLPAGES() {
     // Make sure that there is at least one user in the users array
     assert(!this->users.empty());
 
+    vector<unsigned int> userIDs(numUsers);
     for (unsigned int currID = 1; currID <= numUsers; currID++) {
-        User& currUser = this->users.at(currID - 1);
+        userIDs[currID - 1] = currID;
+    }
+    this->createUserHTMLPages(userIDs, names, numJobs, archive, numSuggestions, writeQueueBatches, formats);
+}
+
+void SocialNetwork::createUserHTMLPages(const vector<unsigned int>& userIDs, const NameTable& names,
+                                        unsigned int numJobs, PageArchive* archive,
+                                        unsigned int numSuggestions, size_t writeQueueBatches,
+                                        unsigned int formats) const {
+    /*
+     *  Creates the user profile html files for the users with the given IDs.
+     *
+     *  The list of IDs is split between a work-stealing pool of numJobs threads. Each page only reads the shared name
+     *  and link tables and follows/followers indices, and every page is written to its own file, so no locking is
+     *  needed. Each worker keeps its own followers and mutuals vectors, page buffer and page writer, which are reused
+     *  for every page it creates, so each page costs a single open (relative to its open directory) and write call.
+     *  With an archive, each worker's writer instead collects its pages into a batch, and appends the batch to the
+     *  archive with a single write once it is large enough, so the workers rarely wait on each other. With suggestions,
+     *  each worker also keeps its own SuggestionFinder (and its array of scores), and finds the suggestions of each
+     *  user just before rendering their page, so the suggestions of every user are never held at once. When the run is
+     *  profiled, each page is timed, to find the slowest pages (see Profiler).
+     *
+     *  With a write queue, the workers only find the followers and mutuals of each user and render their pages, and
+     *  hand the pages in batches to a PageQueue, whose own thread writes them (to files, or to the archive). So the
+     *  open and write calls of one batch overlap the rendering of the next ones, and since the queue only holds
+     *  writeQueueBatches batches, the workers wait for the writer rather than the memory growing if it falls behind.
+     *
+     *  The pages of the compressed formats are compressed by the writer of each worker (each with its own zlib and
+     *  brotli streams), so the compression is split between the workers as well, and a queue is handed every file
+     *  already compressed.
+     *
+     *  Parameters:
+     *      const vector<unsigned int>& userIDs:
+     *          The IDs of the users to create pages for
+     *
+     *      const NameTable& names:
+     *          The names (and links) of every user, as returned by getUserNames
+     *
+     *      unsigned int numJobs:
+     *          The number of threads to create the pages with. 0 uses the hardware concurrency.
+     *
+     *      PageArchive* archive:
+     *          The archive to add the pages to, or nullptr to create a file for each page
+     *
+     *      unsigned int numSuggestions:
+     *          The largest number of suggested users on each page, or 0 to leave the Suggested list off the pages
+     *
+     *      size_t writeQueueBatches:
+     *          The number of batches of pages that can wait for the writer thread, or 0 to have every worker write
+     *          its own pages
+     *
+     *      unsigned int formats:
+     *          The formats (the bits of PageCompressor::Format) to write each page in
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    if (userIDs.empty()) return;
+
+    // When the pages are spread over directories, order them by directory, so that the pages of each directory are
+    // created together (the writer of each worker keeps the directory open between them), and create each directory
+    // before its first page (an archive has no directories to create)
+    const OutputLayout& layout = names.getLayout();
+    vector<unsigned int> orderedIDs;
+    if (layout.getShardLevels() > 0 && archive == nullptr) {
+        orderedIDs = userIDs;
+        stable_sort(orderedIDs.begin(), orderedIDs.end(), [&](unsigned int a, unsigned int b) {
+            return layout.getDirectoryKey(names.getId(a - 1)) < layout.getDirectoryKey(names.getId(b - 1));
+        });
+        for (size_t i = 0; i < orderedIDs.size(); i++) {
+            uint64_t currKey = layout.getDirectoryKey(names.getId(orderedIDs[i] - 1));
+            if (i > 0 && currKey == layout.getDirectoryKey(names.getId(orderedIDs[i - 1] - 1))) continue;
+            if (!layout.createPageDirectory(names.getId(orderedIDs[i] - 1))) {
+                cerr << "COULD NOT CREATE THE DIRECTORY " << layout.getPageDirectory(names.getId(orderedIDs[i] - 1))
+                     << endl;
+                exit(1);
+            }
+        }
+    }
+    const vector<unsigned int>& pageIDs = orderedIDs.empty() ? userIDs : orderedIDs;
+
+    ThreadPool pool(numJobs);
+    vector<vector<unsigned int>> followersIDs(pool.getNumThreads());
+    vector<vector<unsigned int>> mutualsIDs(pool.getNumThreads());
+    vector<PageBuffer> pages(pool.getNumThreads());
+    vector<PageWriter> writers(pool.getNumThreads());
+    unique_ptr<PageQueue> queue;
+    if (writeQueueBatches > 0) queue = make_unique<PageQueue>(layout, archive, writeQueueBatches);
+    for (PageWriter& writer : writers) {
+        if (queue) writer.setQueue(queue.get());
+        else writer.setArchive(archive);
+        writer.setFormats(formats);
+    }
+    vector<SuggestionFinder> finders;
+    vector<vector<unsigned int>> suggestedIDs(pool.getNumThreads());
+    if (numSuggestions > 0) {
+        finders.reserve(pool.getNumThreads());
+        for (unsigned int worker = 0; worker < pool.getNumThreads(); worker++) {
+            finders.emplace_back(this->followsIndex, numSuggestions);
+        }
+    }
+
+    // Pages are handed out in small blocks, so that workers with popular users can have work stolen from them
+    pool.parallelFor(0, pageIDs.size(), 64, [&](unsigned int worker, size_t i) {
+        Profiler::PageTimer pageTimer;
+        unsigned int currID = pageIDs[i];
+        const User& currUser = this->users[currID - 1];
+
+        followersIDs[worker].clear();
+        mutualsIDs[worker].clear();
+        this->getFollowerAndMutualsFromId(followersIDs[worker], mutualsIDs[worker], currID);
+        if (!finders.empty()) finders[worker].findSuggestions(currID - 1, suggestedIDs[worker]);
+
+        currUser.generateUserHTMLProfilePage(pages[worker], names, followersIDs[worker], mutualsIDs[worker],
+                                             &writers[worker], finders.empty() ? nullptr : &suggestedIDs[worker]);
+        pageTimer.stop(names.getId(currID - 1), currUser.getFollows().size(), followersIDs[worker].size(),
+                       mutualsIDs[worker].size());
+    });
+
+    // Write the pages that are left in the batch of each worker (and wait for the queue to write them)
+    for (PageWriter& writer : writers) {
+        if (!writer.flush()) {
+            cerr << "COULD NOT WRITE THE USER PAGES TO THE ARCHIVE" << endl;
+            exit(1);
+        }
+    }
+    if (queue) queue->finish();
+}
+
+void SocialNetwork::createChangedHTMLFiles(const OutputOptions& options,
+                                           const vector<unsigned int>& knownChangedIDs) const {
+    /*
+     *  Re-creates only the HTML files that changed since the previous incremental run.
+     *
+     *  The state of the previous run is loaded from the state file, and compared with the state of this network to
+     *  find which user pages changed (see IncrementalState::findChangedPages). Only those pages, the pages that are
+     *  already known to have changed (such as by a delta), and the index page if a name changed or users were added or
+     *  removed, are re-created. The pages of users that no longer exist are removed. If there is no previous state,
+     *  every file is created. The new state is then saved for the next run.
+     *
+     *  Parameters:
+     *      const OutputOptions& options:
+     *          The options that control how the files are created (such as the number of threads to use).
+     *
+     *      const vector<unsigned int>& knownChangedIDs:
+     *          The IDs of users whose pages are known to have changed, which are re-created even if the previous state
+     *          does not show it
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    // Find which pages changed since the previous run
+    Stats::ScopedTimer diffTimer(Stats::INCREMENTAL_DIFF);
+    IncrementalState previous;
+    bool hasPrevious = previous.load(IncrementalState::FILENAME);
+    OutputLayout layout(options.shardLevels, options.pageSize);
+    IncrementalState current(this->users, this->externalIds, this->followsIndex, layout);
+
+    vector<bool> changedUsers;
+    bool indexChanged = current.findChangedPages(previous, this->followersIndex, changedUsers) || !hasPrevious;
+    for (unsigned int knownID : knownChangedIDs) {
+        assert(knownID > 0 && knownID <= numUsers);
+        changedUsers[knownID - 1] = true;
+    }
+
+    vector<unsigned int> changedIDs;
+    for (unsigned int currIndex = 0; currIndex < numUsers; currIndex++) {
+        if (changedUsers[currIndex]) changedIDs.push_back(currIndex + 1);
+    }
+    diffTimer.stop();
+
+    // Render the link to every user once (in the layout of the pages), if any page needs to be re-created
+    Stats::ScopedTimer linksTimer(Stats::LINK_TABLE);
+    NameTable names = this->getUserNames();
+    names.setLayout(&layout);
+    unique_ptr<LinkTable> links;
+    if (indexChanged || !changedIDs.empty()) {
+        links = make_unique<LinkTable>(names);
+        names.setLinks(links->getOffsets(), links->getData());
+    }
+    linksTimer.stop();
 
-        vector<unsigned int> followersIDs;
-        vector<unsigned int> mutualsIDs;
+    // Remove the pages of users that no longer exist (or every previous page and its directories, if the pages have
+    // moved to a different layout). The continuation pages of a changed user are removed too, as their lists may now
+    // fit on fewer pages. This is done before any page is re-created, as the layouts may share some paths.
+    const OutputLayout previousLayout = previous.getLayout();
+    const bool layoutChanged = !previousLayout.isSameLayout(layout);
+    const bool hadListPages = previousLayout.getListPageSize() > 0;
+    for (unsigned int previousIndex = 0; previousIndex < previous.getNumUsers(); previousIndex++) {
+        uint64_t previousID = previous.getId(previousIndex);
+        unsigned int currIndex = 0;
+        if (layoutChanged || !this->findUserIndex(previousID, currIndex)) {
+            remove(previousLayout.getPagePath(previousID).c_str());
+            if (hadListPages) previousLayout.removeListPages(previousID);
+            previousLayout.removePageDirectory(previousID);
+        }
+        else if (hadListPages && changedUsers[currIndex]) {
+            previousLayout.removeListPages(previousID);
+        }
+    }
+    if (hadListPages && indexChanged) previousLayout.removeIndexPages();
 
-        this->getFollowerAndMutualsFromId(followersIDs, mutualsIDs, currID);
+    // Re-create the changed files
+    if (indexChanged) createIndexHTMLFile(names, SIZE_MAX, nullptr, options.numJobs);
+    Stats::ScopedTimer pagesTimer(Stats::USER_PAGES);
+    this->createUserHTMLPages(changedIDs, names, options.numJobs, nullptr, 0, options.writeQueueBatches);
+    pagesTimer.stop();
 
-        currUser.generateUserHTMLProfilePage(this->userNames, followersIDs, mutualsIDs);
+    // Save the state for the next run
+    Stats::ScopedTimer saveTimer(Stats::SAVE_STATE);
+    if (!current.save(IncrementalState::FILENAME)) {
+        cerr << "COULD NOT SAVE THE INCREMENTAL STATE FILE " << IncrementalState::FILENAME << endl;
+        exit(1);
     }
+    saveTimer.stop();
+
+    cout << "Re-created " << changedIDs.size() << " of " << numUsers << " user pages"
+         << (indexChanged ? " and index.html" : "") << endl;
+}
+
+void SocialNetwork::createIndexHTMLPages(const NameTable& userNames, size_t numPages, PageArchive* archive,
+                                         unsigned int numJobs, const vector<unsigned int>* order,
+                                         unsigned int formats) {
+    /*
+     *  Creates the numbered index pages of a social network whose users do not fit on a single index page (see
+     *  createIndexHTMLFile). Page K lists the users K * pageSize - pageSize + 1 to K * pageSize (numbered so that the
+     *  numbers continue from the previous page), and links to the pages before and after it.
+     *
+     *  The pages only read the name and link tables, and each is written to its own file, so they are split between a
+     *  pool of numJobs threads, each rendering into its own buffer (and compressing the page with its own compressor,
+     *  for each compressed format).
+     *
+     *  Parameters:
+     *      const NameTable& userNames:
+     *          The name (and ID in the input file) of every user in the social network, in ID order
+     *
+     *      size_t numPages:
+     *          The number of index pages, more than 1
+     *
+     *      PageArchive* archive:
+     *          The archive to add the index pages to, or nullptr to create the files
+     *
+     *      unsigned int numJobs:
+     *          The number of threads to create the pages with. 0 uses the hardware concurrency.
+     *
+     *      const vector<unsigned int>* order:
+     *          The 0-based index of every user, in the order to list them, or nullptr to list them by ID
+     *
+     *      unsigned int formats:
+     *          The formats (the bits of PageCompressor::Format) to create the pages in
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    const size_t numUsers = userNames.size();
+    const OutputLayout& layout = userNames.getLayout();
+    const size_t pageSize = layout.getListPageSize();
+
+    ThreadPool pool(numJobs);
+    vector<PageBuffer> pages(pool.getNumThreads(), PageBuffer(64 * pageSize + 1024));
+    vector<PageBuffer> entries(pool.getNumThreads());
+    vector<PageBuffer> compressedPages(pool.getNumThreads());
+    vector<PageCompressor> compressors(pool.getNumThreads());
+    pool.parallelFor(0, numPages, 1, [&](unsigned int worker, size_t i) {
+        const size_t pageNumber = i + 1;
+        const size_t first = i * pageSize;
+        const size_t last = min(first + pageSize, numUsers);
+        PageBuffer& page = pages[worker];
+        page.clear();
+
+        // Add the universal html information to the page (and which page of the index it is, after the first)
+        page.append("<!DOCTYPE html>\n"
+                    "<html>\n"
+                    "<head>\n"
+                    "<title>My Social Network");
+        if (pageNumber > 1) {
+            page.append(" (page ");
+            page.append(pageNumber);
+            page.append(" of ");
+            page.append(numPages);
+            page.append(")");
+        }
+        page.append("</title>\n"
+                    "</head>\n"
+                    "<body>\n"
+                    "<h1>My Social Network: User List</h1>\n");
+
+        // Create an ordered list containing links to the users of this page, numbered from the first of them
+        if (first == 0) {
+            page.append("<ol>\n");
+        }
+        else {
+            page.append(R"(<ol start=")");
+            page.append(first + 1);
+            page.append(R"(">)" "\n");
+        }
+        for (size_t currIndex = first; currIndex < last; currIndex++) {
+            userNames.appendRootLink(page, order != nullptr ? (*order)[currIndex] : currIndex);
+        }
+        page.append("</ol>\n");
+
+        // Link to the previous and next index pages
+        page.append("<p>");
+        if (pageNumber > 1) {
+            page.append(R"(<a href=")");
+            page.append(layout.getIndexFilename(pageNumber - 1));
+            page.append(R"(">Previous</a>)");
+        }
+        if (pageNumber > 1 && pageNumber < numPages) page.append(" ");
+        if (pageNumber < numPages) {
+            page.append(R"(<a href=")");
+            page.append(layout.getIndexFilename(pageNumber + 1));
+            page.append(R"(">Next</a>)");
+        }
+        page.append("</p>\n");
+
+        // Add the final closing tags for the html file, and write it
+        page.append("</body>\n"
+                    "</html>\n");
+
+        for (PageCompressor::Format format : PageCompressor::FORMATS) {
+            if ((formats & format) == 0) continue;
+            const string filename = layout.getIndexFilename(pageNumber) + PageCompressor::getExtension(format);
+            const PageBuffer* contents = &page;
+            bool written = true;
+            if (format != PageCompressor::PLAIN) {
+                written = compressors[worker].compressPage(format, page.getContents(), compressedPages[worker]);
+                contents = &compressedPages[worker];
+            }
+            if (archive != nullptr) {
+                entries[worker].clear();
+                archive->appendEntry(entries[worker], filename, contents->getContents());
+                written = written && archive->write(entries[worker]);
+            }
+            else {
+                written = written && contents->writeToFile(filename);
+            }
+            if (!written) {
+                cerr << "COULD NOT WRITE THE INDEX PAGE " << filename << endl;
+                exit(1);
+            }
+        }
+    });
+    Stats::add(Stats::PAGES_WRITTEN, numPages);
 }
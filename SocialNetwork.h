@@ -16,7 +16,18 @@
 #define CS315_PROJECT01_SOCIALNETWORK_H
 
 #include <vector>
+#include <memory>
+#include <string_view>
+#include <cstdint>
 #include "User.h"
+#include "AdjacencyIndex.h"
+#include "CompressedIndex.h"
+#include "OutputOptions.h"
+#include "StringPool.h"
+#include "IdArena.h"
+#include "PageArchive.h"
+#include "OutputLayout.h"
+#include "NetworkDelta.h"
 
 
 class SocialNetwork {
@@ -26,34 +37,135 @@ public:
     SocialNetwork();
 
     // Creates a social network object given a "special" JSON file which
-    // contains the information on the users of the network
-    explicit SocialNetwork(const std::string& JSON_Filename);
+    // contains the information on the users of the network (or a snapshot saved by saveSnapshot).
+    // The file is parsed with numJobs threads (0 uses the hardware concurrency).
+    explicit SocialNetwork(const std::string& JSON_Filename, unsigned int numJobs = 0);
 
 
     // ----------------------------------------------- Public Methods ----------------------------------------------- //
-    // Creates all HTML files for the social network
-    void createAllHTMLFiles();
+    // Creates all HTML files for the social network. An incremental run also re-creates the pages of changedIDs (such
+    // as the users changed by applyDelta), along with the pages that it finds changed.
+    void createAllHTMLFiles(const OutputOptions& options = OutputOptions(),
+                            const std::vector<unsigned int>& changedIDs = {}) const;
+
+    // Saves a binary snapshot of the social network, which opens without re-parsing. Returns false if it failed.
+    bool saveSnapshot(const std::string& filename) const;
+
+    // Writes the analytics of the network (see GraphAnalytics) to a CSV file with a line for each user (their ID,
+    // name, number of follows and followers, PageRank, and the ID of the smallest user in their weakly and strongly
+    // connected components), using numJobs threads, and prints a summary of them (the number and largest size of the
+    // components, and histograms of the follows and followers of the users) to stdout. The analytics run on the users
+    // relabeled by ordering (see UserOrdering). Returns false if the file could not be written.
+    bool writeAnalytics(const std::string& filename, unsigned int pageRankIterations, unsigned int numJobs = 0,
+                        UserOrdering::Method ordering = UserOrdering::ID) const;
+
+    // Applies a batch of changes to the network, building the new follows and followers indices from the old ones and
+    // the net changes (one copy of each) instead of from the follows lists. Sets changedIDs to the sorted IDs of every
+    // user whose page changed. Returns false (setting error to the reason, and leaving the network unchanged) if a
+    // change refers to a user that does not exist, or adds a user whose ID is not larger than every ID already in the
+    // network.
+    bool applyDelta(const NetworkDelta& delta, std::vector<unsigned int>& changedIDs, std::string& error);
+
+    // Compresses the follows and followers indices (see CompressedIndex) with numJobs threads, so they take a fraction
+    // of the memory, and each row is decoded when it is read. Pages, lookups and snapshots work on the compressed
+    // indices, but the analytics, suggestions, incremental runs and deltas need them to be decompressed first.
+    void compressIndices(unsigned int numJobs = 0);
+
+    // Decompresses the follows and followers indices back into CSR arrays with numJobs threads
+    void decompressIndices(unsigned int numJobs = 0);
+
+    // Checks if the follows and followers indices are compressed
+    bool hasCompressedIndices() const;
+
+    // Creates an index.html file linking to every user in userNames (in archive, if it is not nullptr). Once more than
+    // flushSize bytes are rendered they are written out, so a very large index does not have to be held in memory (the
+    // default writes it all at once). If the layout of userNames has a page size, the index is instead split over
+    // numbered pages, which are created with numJobs threads. If order is not nullptr, the users are listed in that
+    // order (of their 0-based indices) instead of by ID. A file is created for each of formats (the bits of
+    // PageCompressor::Format), such as index.html.gz.
+    static void createIndexHTMLFile(const NameTable& userNames, std::size_t flushSize = SIZE_MAX,
+                                    PageArchive* archive = nullptr, unsigned int numJobs = 0,
+                                    const std::vector<unsigned int>* order = nullptr,
+                                    unsigned int formats = PageCompressor::PLAIN);
+
+    // Returns the number of users in the social network
+    unsigned int getNumUsers() const;
+
+    // Returns the user with a certain internal ID (from 1 to the number of users, in the order of the IDs in the file)
+    const User& getUser(unsigned int id) const;
+
+    // Returns a table of the name of every user, in ID order, which also maps each user to their ID in the input file
+    NameTable getUserNames() const;
 
-private:
-    // -------------------------------------------- Private Data Members -------------------------------------------- //
-    unsigned int numUsers;
-    std::vector<std::vector<bool>> followerRelationShips;
-    std::vector<User> users;
-    std::vector<std::string> userNames;
-
-    // -----------------------------------------  Private Helper Functions ------------------------------------------ //
     // Adds the ids of the users that are followers of and mutuals with a certain user (given by currID) to the pass
     // by reference vectors
-    void getFollowerAndMutualsFromId(std::vector<unsigned int>& followers, std::vector<unsigned int>& mutuals, const unsigned int& currID);
+    void getFollowerAndMutualsFromId(std::vector<unsigned int>& followers, std::vector<unsigned int>& mutuals, const unsigned int& currID) const;
+
+    // The lookups below only read the network, so any number of threads can use them at once (such as the workers of a
+    // query server). IDs are internal IDs, except where noted.
+
+    // Finds the internal ID of the user with a certain ID in the input file. Returns false if there is no such user.
+    bool findUserId(uint64_t externalId, unsigned int& id) const;
+
+    // Returns the ID in the input file of the user with a certain internal ID
+    uint64_t getExternalId(unsigned int id) const;
 
     // Check if the user with the id "followerID" is following the user with the id "followedID"
-    bool isFollowing(const unsigned int& followerID, const unsigned int& otherUserID);
+    bool isFollowing(const unsigned int& followerID, const unsigned int& otherUserID) const;
+
+    // Adds up to limit users of one list of a user (follows in the order of the input file, followers and mutuals in ID
+    // order), starting at position offset of the list, to ids. Returns the length of the whole list.
+    std::size_t getUserList(unsigned int id, OutputLayout::UserList list, std::size_t offset, std::size_t limit,
+                            std::vector<unsigned int>& ids) const;
 
-    // Creates an index.html file for a social network object.
-    void createIndexHTMLFile();
 
-    // Creates the user profile html file for each user in the Users array.
-    void createAllUserHTMLPAGES();
+private:
+    // -------------------------------------------- Private Data Members -------------------------------------------- //
+    unsigned int numUsers;
+    AdjacencyIndex followsIndex;           // row i holds the users that user (i + 1) follows
+    AdjacencyIndex followersIndex;         // row i holds the users that follow user (i + 1)
+    CompressedIndex compressedFollows;     // the same indices compressed, which are used instead if indicesCompressed
+    CompressedIndex compressedFollowers;
+    bool indicesCompressed;
+    std::shared_ptr<StringPool> strings;   // owns every name, location and pic_url that the users view
+    std::shared_ptr<IdArena> followsArena; // owns the follows lists of the users (unless they view a snapshot)
+    std::vector<User> users;
+    std::vector<std::string_view> userNames;
+    std::vector<uint64_t> externalIds;     // the sorted ID in the input file of each user, or empty if they are 1 to N
+
+    // -----------------------------------------  Private Helper Functions ------------------------------------------ //
+    // Opens the social network from a binary snapshot file
+    void loadSnapshot(const std::string& filename);
+
+    // Finds the 0-based index of the user with a certain ID in the input file. Returns false if there is no such user.
+    bool findUserIndex(uint64_t id, unsigned int& index) const;
+
+    // Creates the user profile html file for each user in the Users array, using numJobs threads (in archive, if it
+    // is not nullptr), each with up to numSuggestions suggested users (if it is not 0). If writeQueueBatches is not 0,
+    // the pages are written by a thread of their own, through a PageQueue of that many batches. Each page is written in
+    // each of formats (the bits of PageCompressor::Format).
+    void createAllUserHTMLPAGES(const NameTable& names, unsigned int numJobs, PageArchive* archive = nullptr,
+                                unsigned int numSuggestions = 0, std::size_t writeQueueBatches = 0,
+                                unsigned int formats = PageCompressor::PLAIN) const;
+
+    // Creates the user profile html files for the users with the given IDs, using numJobs threads (in archive, if it
+    // is not nullptr), each with up to numSuggestions suggested users (if it is not 0). If writeQueueBatches is not 0,
+    // the pages are written by a thread of their own, through a PageQueue of that many batches. Each page is written in
+    // each of formats (the bits of PageCompressor::Format).
+    void createUserHTMLPages(const std::vector<unsigned int>& userIDs, const NameTable& names,
+                             unsigned int numJobs, PageArchive* archive = nullptr,
+                             unsigned int numSuggestions = 0, std::size_t writeQueueBatches = 0,
+                             unsigned int formats = PageCompressor::PLAIN) const;
+
+    // Re-creates only the HTML files that changed since the previous incremental run (and the pages of
+    // knownChangedIDs), and saves the new state.
+    void createChangedHTMLFiles(const OutputOptions& options, const std::vector<unsigned int>& knownChangedIDs) const;
+
+    // Creates the numPages numbered index pages of userNames (in archive, if it is not nullptr), using numJobs threads,
+    // listing the users in order (or by ID, if it is nullptr), in each of formats
+    static void createIndexHTMLPages(const NameTable& userNames, std::size_t numPages, PageArchive* archive,
+                                     unsigned int numJobs, const std::vector<unsigned int>* order,
+                                     unsigned int formats);
 };
 
 
@@ -0,0 +1,340 @@
+/** ****************************************************************
+ *  Implementation of the SortedIntersection class                 *
+ *  @author Brandon Dale                                           *
+ *                                                                 *
+ *  The SIMD kernels are compiled for their instruction set with a *
+ *  target attribute, and chosen when the program first calls      *
+ *  simd, by asking the CPU what it supports. So the rest of the   *
+ *  program is still built for (and runs on) any x86-64 CPU.       *
+ *                                                                 *
+ *  A block step compares every value of a block of a with every   *
+ *  value of a block of b (by comparing a against each rotation of *
+ *  b), packs the values of a that matched to the front with a     *
+ *  shuffle from a table, and then moves past whichever block ends *
+ *  with the smaller value (or both, if they end with the same).   *
+ *                                                                 *
+ *  @file SortedIntersection.cpp                                   *
+ *  @date October 14th, 2026                                       *
+ ******************************************************************/
+
+
+#include "SortedIntersection.h"
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SORTED_INTERSECTION_X86 1
+#endif
+
+using namespace std;
+
+
+#ifdef SORTED_INTERSECTION_X86
+
+// The kernels that simd can use, best first
+enum class SimdKernel {
+    AVX2,
+    SSE41,
+    NONE
+};
+
+// Returns the best kernel that this CPU supports (looked up once)
+static SimdKernel getSimdKernel() {
+    static const SimdKernel kernel = []() {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt")) return SimdKernel::AVX2;
+        if (__builtin_cpu_supports("sse4.1") && __builtin_cpu_supports("popcnt")) return SimdKernel::SSE41;
+        return SimdKernel::NONE;
+    }();
+    return kernel;
+}
+
+// Intersects blocks of 4 values with SSE4.1, then merges what is left. a must be the smaller set (see simd).
+__attribute__((target("sse4.1,popcnt")))
+static size_t intersectSSE41(const unsigned int* a, size_t aSize, const unsigned int* b, size_t bSize,
+                             unsigned int* out) {
+    // The byte shuffle that packs the 32-bit lanes set in a 4-bit mask to the front, for every mask
+    static const auto packShuffles = []() {
+        struct { alignas(16) uint8_t bytes[16][16]; } table = {};
+        for (unsigned int mask = 0; mask < 16; mask++) {
+            unsigned int next = 0;
+            for (unsigned int lane = 0; lane < 4; lane++) {
+                if (!(mask & (1u << lane))) continue;
+                for (unsigned int byte = 0; byte < 4; byte++) table.bytes[mask][4 * next + byte] = 4 * lane + byte;
+                next++;
+            }
+            for (unsigned int byte = 4 * next; byte < 16; byte++) table.bytes[mask][byte] = 0x80;
+        }
+        return table;
+    }();
+
+    size_t i = 0;
+    size_t j = 0;
+    size_t count = 0;
+    while (i + 4 <= aSize && j + 4 <= bSize && count + 4 <= aSize) {
+        __m128i blockA = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i blockB = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j));
+
+        __m128i matches = _mm_cmpeq_epi32(blockA, blockB);
+        matches = _mm_or_si128(matches, _mm_cmpeq_epi32(blockA, _mm_shuffle_epi32(blockB, _MM_SHUFFLE(0, 3, 2, 1))));
+        matches = _mm_or_si128(matches, _mm_cmpeq_epi32(blockA, _mm_shuffle_epi32(blockB, _MM_SHUFFLE(1, 0, 3, 2))));
+        matches = _mm_or_si128(matches, _mm_cmpeq_epi32(blockA, _mm_shuffle_epi32(blockB, _MM_SHUFFLE(2, 1, 0, 3))));
+        unsigned int mask = _mm_movemask_ps(_mm_castsi128_ps(matches));
+
+        __m128i shuffle = _mm_load_si128(reinterpret_cast<const __m128i*>(packShuffles.bytes[mask]));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + count), _mm_shuffle_epi8(blockA, shuffle));
+        count += _mm_popcnt_u32(mask);
+
+        const unsigned int lastA = a[i + 3];
+        const unsigned int lastB = b[j + 3];
+        if (lastA <= lastB) i += 4;
+        if (lastB <= lastA) j += 4;
+    }
+
+    return count + SortedIntersection::merge(a + i, aSize - i, b + j, bSize - j, out + count);
+}
+
+// Intersects blocks of 8 values with AVX2, then merges what is left. a must be the smaller set (see simd).
+__attribute__((target("avx2,popcnt")))
+static size_t intersectAVX2(const unsigned int* a, size_t aSize, const unsigned int* b, size_t bSize,
+                            unsigned int* out) {
+    // The lane permutation that packs the 32-bit lanes set in an 8-bit mask to the front, for every mask
+    static const auto packPermutations = []() {
+        struct { alignas(32) uint32_t lanes[256][8]; } table = {};
+        for (unsigned int mask = 0; mask < 256; mask++) {
+            unsigned int next = 0;
+            for (unsigned int lane = 0; lane < 8; lane++) {
+                if (mask & (1u << lane)) table.lanes[mask][next++] = lane;
+            }
+        }
+        return table;
+    }();
+
+    // The permutations that rotate the lanes of a block by 1 to 7
+    __m256i rotations[7];
+    for (int r = 1; r <= 7; r++) {
+        rotations[r - 1] = _mm256_setr_epi32(r % 8, (r + 1) % 8, (r + 2) % 8, (r + 3) % 8, (r + 4) % 8, (r + 5) % 8,
+                                             (r + 6) % 8, (r + 7) % 8);
+    }
+
+    size_t i = 0;
+    size_t j = 0;
+    size_t count = 0;
+    while (i + 8 <= aSize && j + 8 <= bSize && count + 8 <= aSize) {
+        __m256i blockA = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i blockB = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + j));
+
+        __m256i matches = _mm256_cmpeq_epi32(blockA, blockB);
+        for (const __m256i& rotation : rotations) {
+            __m256i rotatedB = _mm256_permutevar8x32_epi32(blockB, rotation);
+            matches = _mm256_or_si256(matches, _mm256_cmpeq_epi32(blockA, rotatedB));
+        }
+        unsigned int mask = _mm256_movemask_ps(_mm256_castsi256_ps(matches));
+
+        __m256i permutation = _mm256_load_si256(reinterpret_cast<const __m256i*>(packPermutations.lanes[mask]));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + count), _mm256_permutevar8x32_epi32(blockA, permutation));
+        count += _mm_popcnt_u32(mask);
+
+        const unsigned int lastA = a[i + 7];
+        const unsigned int lastB = b[j + 7];
+        if (lastA <= lastB) i += 8;
+        if (lastB <= lastA) j += 8;
+    }
+
+    return count + SortedIntersection::merge(a + i, aSize - i, b + j, bSize - j, out + count);
+}
+
+#endif
+
+
+// ------------------------------------------------ PUBLIC METHODS -------------------------------------------------- //
+
+size_t SortedIntersection::intersect(const unsigned int* a, size_t aSize, const unsigned int* b, size_t bSize,
+                                     unsigned int* out) {
+    /*
+     *  Writes the values that are in both sorted sets to out, with the kernel that suits the sizes of the sets best.
+     *
+     *  Notes:
+     *      1) Galloping costs about log(larger / smaller) comparisons per value of the smaller set, instead of
+     *         larger / smaller for a merge, so it wins once the sizes are skewed (such as a user who follows a few
+     *         users, but is followed by millions). Below GALLOP_RATIO, its branches cost more than they save.
+     *      2) The SIMD kernels do a fixed amount of work per block, so they only pay off once the sets are long
+     *         enough to fill a good number of blocks.
+     *
+     *  Parameters:
+     *      const unsigned int* a, size_t aSize:
+     *          The first set, sorted in increasing order with no repeated values
+     *
+     *      const unsigned int* b, size_t bSize:
+     *          The second set, sorted in increasing order with no repeated values
+     *
+     *      unsigned int* out:
+     *          Where the values in both sets are written, with room for min(aSize, bSize) values
+     *
+     *  Returns:
+     *      size_t:
+     *          The number of values written to out
+     */
+
+    if (aSize > bSize) {
+        swap(a, b);
+        swap(aSize, bSize);
+    }
+    if (aSize == 0) return 0;
+
+    if (bSize / aSize >= GALLOP_RATIO) return gallop(a, aSize, b, bSize, out);
+    if (aSize >= SIMD_MIN_SIZE) return simd(a, aSize, b, bSize, out);
+    return merge(a, aSize, b, bSize, out);
+}
+
+size_t SortedIntersection::merge(const unsigned int* a, size_t aSize, const unsigned int* b, size_t bSize,
+                                 unsigned int* out) {
+    /*
+     *  Writes the values that are in both sorted sets to out, by walking both sets at once
+     *
+     *  Parameters:
+     *      const unsigned int* a, size_t aSize:
+     *          The first set, sorted in increasing order with no repeated values
+     *
+     *      const unsigned int* b, size_t bSize:
+     *          The second set, sorted in increasing order with no repeated values
+     *
+     *      unsigned int* out:
+     *          Where the values in both sets are written, with room for min(aSize, bSize) values
+     *
+     *  Returns:
+     *      size_t:
+     *          The number of values written to out
+     */
+
+    const unsigned int* aEnd = a + aSize;
+    const unsigned int* bEnd = b + bSize;
+    size_t count = 0;
+    while (a != aEnd && b != bEnd) {
+        if (*a < *b) {
+            a++;
+        }
+        else if (*b < *a) {
+            b++;
+        }
+        else {
+            out[count++] = *a;
+            a++;
+            b++;
+        }
+    }
+    return count;
+}
+
+size_t SortedIntersection::gallop(const unsigned int* a, size_t aSize, const unsigned int* b, size_t bSize,
+                                  unsigned int* out) {
+    /*
+     *  Writes the values that are in both sorted sets to out. For each value of the smaller set, the larger set is
+     *  searched from where the previous value was found: first in steps that double in size until a larger value is
+     *  passed, then with a binary search of the last step.
+     *
+     *  Parameters:
+     *      const unsigned int* a, size_t aSize:
+     *          The first set, sorted in increasing order with no repeated values
+     *
+     *      const unsigned int* b, size_t bSize:
+     *          The second set, sorted in increasing order with no repeated values
+     *
+     *      unsigned int* out:
+     *          Where the values in both sets are written, with room for min(aSize, bSize) values
+     *
+     *  Returns:
+     *      size_t:
+     *          The number of values written to out
+     */
+
+    if (aSize > bSize) {
+        swap(a, b);
+        swap(aSize, bSize);
+    }
+
+    size_t count = 0;
+    size_t position = 0;    // every value of b before this is smaller than the next value of a
+    for (size_t i = 0; i < aSize && position < bSize; i++) {
+        const unsigned int value = a[i];
+
+        // Find a step that ends past the value, then search within it
+        size_t step = 1;
+        while (position + step < bSize && b[position + step] < value) step *= 2;
+        const unsigned int* found = lower_bound(b + position + step / 2, b + min(position + step + 1, bSize), value);
+
+        position = found - b;
+        if (position < bSize && *found == value) out[count++] = value;
+    }
+    return count;
+}
+
+size_t SortedIntersection::simd(const unsigned int* a, size_t aSize, const unsigned int* b, size_t bSize,
+                                unsigned int* out) {
+    /*
+     *  Writes the values that are in both sorted sets to out, comparing a block of each set at a time with the widest
+     *  SIMD instructions that the CPU has (see getSimdName), and merging the values left after the last whole blocks.
+     *
+     *  Each block step stores a whole block to out, only some of which is kept, so the block steps stop once a whole
+     *  block would no longer fit in the room for the smaller set, and the rest is merged. The values already found are
+     *  all smaller than the next value of each set, so the merge does not find them again.
+     *
+     *  Parameters:
+     *      const unsigned int* a, size_t aSize:
+     *          The first set, sorted in increasing order with no repeated values
+     *
+     *      const unsigned int* b, size_t bSize:
+     *          The second set, sorted in increasing order with no repeated values
+     *
+     *      unsigned int* out:
+     *          Where the values in both sets are written, with room for min(aSize, bSize) values
+     *
+     *  Returns:
+     *      size_t:
+     *          The number of values written to out
+     */
+
+    if (aSize > bSize) {
+        swap(a, b);
+        swap(aSize, bSize);
+    }
+
+#ifdef SORTED_INTERSECTION_X86
+    switch (getSimdKernel()) {
+        case SimdKernel::AVX2:
+            return intersectAVX2(a, aSize, b, bSize, out);
+        case SimdKernel::SSE41:
+            return intersectSSE41(a, aSize, b, bSize, out);
+        case SimdKernel::NONE:
+            break;
+    }
+#endif
+    return merge(a, aSize, b, bSize, out);
+}
+
+const char* SortedIntersection::getSimdName() {
+    /*
+     *  Returns the instruction set that simd uses on this CPU
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      const char*:
+     *          "avx2", "sse4.1", or "none" (in which case simd is a merge)
+     */
+
+#ifdef SORTED_INTERSECTION_X86
+    switch (getSimdKernel()) {
+        case SimdKernel::AVX2:
+            return "avx2";
+        case SimdKernel::SSE41:
+            return "sse4.1";
+        case SimdKernel::NONE:
+            break;
+    }
+#endif
+    return "none";
+}
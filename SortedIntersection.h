@@ -0,0 +1,60 @@
+/** *************************************************************
+ *  Declaration of the SortedIntersection class                 *
+ *  @author Brandon Dale                                        *
+ *                                                              *
+ *  Intersection kernels for sorted sets of IDs (such as the    *
+ *  follows and followers rows of a user, whose intersection is *
+ *  their mutuals). intersect picks a kernel by the sizes of    *
+ *  the sets: a plain merge for small sets, galloping (an       *
+ *  exponential search of the larger set) when one set is much  *
+ *  smaller than the other, and a SIMD block compare for large  *
+ *  sets of similar size, so the work stays close to linear in  *
+ *  the smaller set for the hubs of a power-law network.        *
+ *                                                              *
+ *  @file SortedIntersection.h                                  *
+ *  @date October 14th, 2026                                    *
+ ***************************************************************/
+
+
+#ifndef CS315_PROJECT01_SORTEDINTERSECTION_H
+#define CS315_PROJECT01_SORTEDINTERSECTION_H
+
+#include <cstddef>
+
+
+class SortedIntersection {
+public:
+    // ----------------------------------------------- Public Methods ----------------------------------------------- //
+    // Every kernel takes two sets sorted in increasing order with no repeated values, and writes the values that are
+    // in both (in increasing order) to out, which must have room for as many values as the smaller set. Each returns
+    // the number of values written.
+
+    // Picks the fastest kernel for the sizes of the sets
+    static std::size_t intersect(const unsigned int* a, std::size_t aSize, const unsigned int* b, std::size_t bSize,
+                                 unsigned int* out);
+
+    // Walks both sets at once. O(aSize + bSize).
+    static std::size_t merge(const unsigned int* a, std::size_t aSize, const unsigned int* b, std::size_t bSize,
+                             unsigned int* out);
+
+    // Searches the larger set for each value of the smaller one, from where the previous value was found.
+    // O(smaller * log(larger / smaller)).
+    static std::size_t gallop(const unsigned int* a, std::size_t aSize, const unsigned int* b, std::size_t bSize,
+                              unsigned int* out);
+
+    // Compares blocks of 8 (AVX2) or 4 (SSE4.1) values of each set at once (a merge, if the CPU has neither)
+    static std::size_t simd(const unsigned int* a, std::size_t aSize, const unsigned int* b, std::size_t bSize,
+                            unsigned int* out);
+
+    // Returns the instruction set that simd uses on this CPU ("avx2", "sse4.1" or "none")
+    static const char* getSimdName();
+
+    // intersect gallops once the larger set is this many times the size of the smaller one
+    static const std::size_t GALLOP_RATIO = 32;
+
+    // intersect uses simd once the smaller set has at least this many values
+    static const std::size_t SIMD_MIN_SIZE = 32;
+};
+
+
+#endif //CS315_PROJECT01_SORTEDINTERSECTION_H
@@ -0,0 +1,250 @@
+/** ****************************************************************
+ *  Implementation of the Stats class                              *
+ *  @author Brandon Dale                                           *
+ *                                                                 *
+ *  The stats are kept in static atomics, so measuring them only   *
+ *  costs a relaxed atomic add (and a clock read for each timer),  *
+ *  and a disabled timer or counter costs a single load.           *
+ *                                                                 *
+ *  @file Stats.cpp                                                *
+ *  @date October 14th, 2026                                       *
+ ******************************************************************/
+
+
+#include "Stats.h"
+#include "Profiler.h"
+#include <atomic>
+#include <cstdio>
+
+using namespace std;
+
+
+namespace {
+    atomic<bool> enabled(false);
+    atomic<uint64_t> stageNanoseconds[Stats::NUM_STAGES];
+    atomic<uint64_t> stageCalls[Stats::NUM_STAGES];
+    atomic<uint64_t> counters[Stats::NUM_COUNTERS];
+
+    const char* const STAGE_NAMES[Stats::NUM_STAGES] = {
+        "parse", "place_users", "build_indices", "user_names", "load_snapshot", "save_snapshot", "apply_delta",
+        "incremental_diff", "save_state", "partition", "name_table", "link_table",
+        "reorder", "analytics", "compress_indices", "index_page", "user_pages", "total"
+    };
+    const char* const COUNTER_NAMES[Stats::NUM_COUNTERS] = {
+        "bytes_parsed", "users", "follows", "edges", "pages_written", "bytes_written", "delta_changes",
+        "page_queue_waits"
+    };
+}
+
+
+// -------------------------------------------------- SCOPED TIMER -------------------------------------------------- //
+
+Stats::ScopedTimer::ScopedTimer(Stage stage) {
+    /*
+     *  Starts timing a stage, if stats are enabled. If the run is profiled, the thread is put in the stage (so that its
+     *  allocations are counted against it) until the timer is stopped.
+     *
+     *  Parameters:
+     *      Stage stage:
+     *          The stage to add the time to when the timer is destroyed
+     *
+     *  Returns:
+     *      No return value, creates a ScopedTimer object
+     */
+
+    this->stage = stage;
+    this->running = enabled.load(memory_order_relaxed);
+    this->profiled = running && Profiler::isEnabled();
+    this->previousStage = -1;
+    if (profiled) {
+        previousStage = Profiler::getThreadStage();
+        Profiler::setThreadStage(stage);
+    }
+    if (running) start = chrono::steady_clock::now();
+}
+
+Stats::ScopedTimer::~ScopedTimer() {
+    /*
+     *  Adds the time since the timer was created to its stage (unless the timer was already stopped).
+     */
+
+    stop();
+}
+
+void Stats::ScopedTimer::stop() {
+    /*
+     *  Adds the time since the timer was created to its stage, before the end of its scope (and, if the run is
+     *  profiled, adds the stage to the trace, and puts the thread back in its previous stage). Does nothing if the
+     *  timer was already stopped.
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    if (!running) return;
+    const chrono::steady_clock::time_point end = chrono::steady_clock::now();
+    addTime(stage, end - start);
+    running = false;
+    if (profiled) {
+        Profiler::setThreadStage(previousStage);
+        Profiler::addStageEvent(stage, start, end);
+    }
+}
+
+
+// ------------------------------------------------ PUBLIC METHODS -------------------------------------------------- //
+
+void Stats::enable() {
+    /*
+     *  Starts measuring stats. Until this is called, timers and counters do nothing.
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    enabled.store(true, memory_order_relaxed);
+}
+
+bool Stats::isEnabled() {
+    /*
+     *  Checks if stats are being measured
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if enable was called.
+     *          Otherwise, returns false.
+     */
+
+    return enabled.load(memory_order_relaxed);
+}
+
+void Stats::addTime(Stage stage, chrono::steady_clock::duration time) {
+    /*
+     *  Adds time to a stage, and counts it as one more call of that stage. Does nothing if stats are not enabled.
+     *
+     *  Parameters:
+     *      Stage stage:
+     *          The stage that the time was spent in
+     *
+     *      chrono::steady_clock::duration time:
+     *          The time spent
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    if (!enabled.load(memory_order_relaxed)) return;
+    uint64_t nanoseconds = chrono::duration_cast<chrono::nanoseconds>(time).count();
+    stageNanoseconds[stage].fetch_add(nanoseconds, memory_order_relaxed);
+    stageCalls[stage].fetch_add(1, memory_order_relaxed);
+}
+
+void Stats::add(Counter counter, uint64_t amount) {
+    /*
+     *  Adds an amount to a counter. Does nothing if stats are not enabled.
+     *
+     *  Parameters:
+     *      Counter counter:
+     *          The counter to add to
+     *
+     *      uint64_t amount:
+     *          The amount to add
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    if (!enabled.load(memory_order_relaxed)) return;
+    counters[counter].fetch_add(amount, memory_order_relaxed);
+}
+
+const char* Stats::getStageName(Stage stage) {
+    /*
+     *  Returns the name of a stage, as it is printed in the table and JSON of the stats
+     *
+     *  Parameters:
+     *      Stage stage:
+     *          The stage
+     *
+     *  Returns:
+     *      const char*:
+     *          The name of the stage, such as "build_indices"
+     */
+
+    return STAGE_NAMES[stage];
+}
+
+void Stats::printTable(ostream& out) {
+    /*
+     *  Prints the time and number of calls of every stage that ran, and the value of every counter, as a table.
+     *
+     *  Parameters:
+     *      ostream& out:
+     *          The stream to print to
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    char line[128];
+    snprintf(line, sizeof(line), "%-20s %12s %8s\n", "stage", "seconds", "calls");
+    out << line;
+    for (int stage = 0; stage < NUM_STAGES; stage++) {
+        uint64_t calls = stageCalls[stage].load(memory_order_relaxed);
+        if (calls == 0) continue;
+        snprintf(line, sizeof(line), "%-20s %12.6f %8llu\n", STAGE_NAMES[stage],
+                 stageNanoseconds[stage].load(memory_order_relaxed) / 1e9, static_cast<unsigned long long>(calls));
+        out << line;
+    }
+
+    snprintf(line, sizeof(line), "\n%-20s %21s\n", "counter", "value");
+    out << line;
+    for (int counter = 0; counter < NUM_COUNTERS; counter++) {
+        snprintf(line, sizeof(line), "%-20s %21llu\n", COUNTER_NAMES[counter],
+                 static_cast<unsigned long long>(counters[counter].load(memory_order_relaxed)));
+        out << line;
+    }
+}
+
+void Stats::printJSON(ostream& out) {
+    /*
+     *  Prints the time and number of calls of every stage that ran, and the value of every counter, as a single line
+     *  JSON object, such as:
+     *      {"stages":{"parse":{"seconds":0.1,"calls":1}},"counters":{"bytes_parsed":1234}}
+     *
+     *  Parameters:
+     *      ostream& out:
+     *          The stream to print to
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    char value[64];
+    out << R"({"stages":{)";
+    bool first = true;
+    for (int stage = 0; stage < NUM_STAGES; stage++) {
+        uint64_t calls = stageCalls[stage].load(memory_order_relaxed);
+        if (calls == 0) continue;
+        snprintf(value, sizeof(value), "%.9f", stageNanoseconds[stage].load(memory_order_relaxed) / 1e9);
+        out << (first ? "" : ",") << '"' << STAGE_NAMES[stage] << R"(":{"seconds":)" << value
+            << R"(,"calls":)" << calls << '}';
+        first = false;
+    }
+
+    out << R"(},"counters":{)";
+    for (int counter = 0; counter < NUM_COUNTERS; counter++) {
+        out << (counter == 0 ? "" : ",") << '"' << COUNTER_NAMES[counter] << R"(":)"
+            << counters[counter].load(memory_order_relaxed);
+    }
+    out << "}}\n";
+}
@@ -0,0 +1,104 @@
+/** *************************************************************
+ *  Declaration of the Stats class                              *
+ *  @author Brandon Dale                                        *
+ *                                                              *
+ *  Low overhead instrumentation of a run: the time spent in    *
+ *  each stage (measured by scoped timers), and counters of the *
+ *  work done (bytes parsed, edges, pages and bytes written).   *
+ *  Nothing is measured unless it is enabled, and the counters  *
+ *  are atomics, so they can be added to from any thread.       *
+ *                                                              *
+ *  @file Stats.h                                               *
+ *  @date October 14th, 2026                                    *
+ ***************************************************************/
+
+
+#ifndef CS315_PROJECT01_STATS_H
+#define CS315_PROJECT01_STATS_H
+
+#include <ostream>
+#include <chrono>
+#include <cstdint>
+
+
+class Stats {
+public:
+    // The stages of a run that are timed
+    enum Stage {
+        PARSE,              // scanning the JSON file into users
+        PLACE_USERS,        // moving each user to its slot in the users array, by ID
+        BUILD_INDICES,      // building the follows and followers indices
+        USER_NAMES,         // building the table of names
+        LOAD_SNAPSHOT,      // opening a snapshot
+        SAVE_SNAPSHOT,      // saving a snapshot
+        APPLY_DELTA,        // applying a delta file of follows, unfollows, new users and renames to the network
+        INCREMENTAL_DIFF,   // loading the previous incremental state and finding the changed pages
+        SAVE_STATE,         // saving the incremental state
+        PARTITION,          // counting and partitioning the users into shard files (streaming mode)
+        NAME_TABLE,         // writing the name table (streaming mode)
+        LINK_TABLE,         // rendering the link to every user's page once
+        REORDER,            // relabeling the users of the analytics for locality
+        ANALYTICS,          // finding the PageRank, components and degree histograms of the network
+        COMPRESS_INDICES,   // compressing (or decompressing) the follows and followers indices
+        INDEX_PAGE,         // creating index.html
+        USER_PAGES,         // creating the user pages
+        TOTAL,              // the whole run
+        NUM_STAGES
+    };
+
+    // The counters of the work done in a run
+    enum Counter {
+        BYTES_PARSED,
+        USERS,
+        FOLLOWS,            // the total length of every follows list
+        EDGES,              // the number of (de-duplicated) edges in the follows index
+        PAGES_WRITTEN,
+        BYTES_WRITTEN,
+        DELTA_CHANGES,      // the number of changes applied from delta files
+        PAGE_QUEUE_WAITS,   // the number of times a worker waited for the writer of a full page queue
+        NUM_COUNTERS
+    };
+
+    // Times a stage from its creation to its destruction, or until stop is called (if stats are enabled). When the run
+    // is profiled, the thread is in the stage until then, and the stage is added to the trace (see Profiler).
+    class ScopedTimer {
+    public:
+        explicit ScopedTimer(Stage stage);
+        ~ScopedTimer();
+        void stop();
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    private:
+        Stage stage;
+        bool running;
+        bool profiled;          // whether the thread was put in the stage by the profiler
+        int previousStage;      // the stage that the thread was in before, which it is put back in once stopped
+        std::chrono::steady_clock::time_point start;
+    };
+
+    // ----------------------------------------------- Public Methods ----------------------------------------------- //
+    // Starts measuring. Until this is called, the timers and counters do nothing.
+    static void enable();
+
+    // Checks if stats are being measured
+    static bool isEnabled();
+
+    // Adds time to a stage
+    static void addTime(Stage stage, std::chrono::steady_clock::duration time);
+
+    // Adds an amount to a counter
+    static void add(Counter counter, uint64_t amount);
+
+    // Returns the name of a stage, as it is printed (such as "build_indices")
+    static const char* getStageName(Stage stage);
+
+    // Prints every stage that ran, and every counter, as a table
+    static void printTable(std::ostream& out);
+
+    // Prints every stage that ran, and every counter, as a JSON object
+    static void printJSON(std::ostream& out);
+};
+
+
+#endif //CS315_PROJECT01_STATS_H
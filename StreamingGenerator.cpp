@@ -0,0 +1,591 @@
+/** ****************************************************************
+ *  Implementation of the StreamingGenerator class                 *
+ *  @author Brandon Dale                                           *
+ *                                                                 *
+ *  The input is scanned twice: once to count the users (which     *
+ *  decides the number of shards), and once to partition them.     *
+ *  Each shard is then read back on its own: its reverse edges     *
+ *  are bucket sorted by the followed user (an external           *
+ *  distribution sort, since the buckets were split by shard when  *
+ *  they were written), and its pages are created in parallel.     *
+ *                                                                 *
+ *  @file StreamingGenerator.cpp                                   *
+ *  @date October 14th, 2026                                       *
+ ******************************************************************/
+
+
+#include "StreamingGenerator.h"
+#include "SocialNetwork.h"
+#include "IncrementalState.h"
+#include "MappedFile.h"
+#include "UserScanner.h"
+#include "PageBuffer.h"
+#include "User.h"
+#include "PageWriter.h"
+#include "PageArchive.h"
+#include "SortedIntersection.h"
+#include "Stats.h"
+#include "Profiler.h"
+#include <cstdio>
+#include <cassert>
+#include <iostream>
+#include <algorithm>
+#include <memory>
+#include <sys/stat.h>
+#include <dirent.h>
+#include <unistd.h>
+
+using namespace std;
+
+const char* const StreamingGenerator::SHARD_DIRECTORY = ".social_network_shards";
+
+
+// -------------------------------------------------- CONSTRUCTORS -------------------------------------------------- //
+
+StreamingGenerator::StreamingGenerator(const string& JSON_Filename, const OutputOptions& options) {
+    /*
+     *  Prepares to create the HTML files of the users in a "special" JSON file, without holding the whole network in
+     *  memory. Nothing is read until createAllHTMLFiles is called.
+     *
+     *  Parameters:
+     *      const string& JSON_Filename:
+     *          The name of the JSON file that contains the users of the network
+     *
+     *      const OutputOptions& options:
+     *          The options to create the files with. options.memoryBudget is the number of bytes of memory to stay
+     *          within, and must be greater than 0.
+     *
+     *  Returns:
+     *      No return value, creates a StreamingGenerator object
+     */
+
+    assert(options.memoryBudget > 0);
+
+    this->inputFilename = JSON_Filename;
+    this->options = options;
+    this->layout = OutputLayout(options.shardLevels, options.pageSize);
+    numUsers = 0;
+    numFollows = 0;
+    numStringBytes = 0;
+    numShards = 0;
+    usersPerShard = 0;
+    shardBufferSize = 0;
+}
+
+
+// ------------------------------------------------ PUBLIC METHODS -------------------------------------------------- //
+
+void StreamingGenerator::createAllHTMLFiles() {
+    /*
+     *  Creates the index.html file and the user profile html file of every user.
+     *
+     *  The users are first partitioned into shard files (in SHARD_DIRECTORY, which is removed again at the end), and
+     *  the names are written to a name table. The index page is then created from the mapped name table, and the user
+     *  pages one shard at a time.
+     *
+     *  Parameters:
+     *      Takes no parameters.
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    // The state of an earlier incremental run does not describe these files (unless they go into an archive)
+    if (options.archiveFilename.empty()) remove(IncrementalState::FILENAME);
+
+    // Start from an empty shard directory
+    removeShardFiles();
+    if (mkdir(SHARD_DIRECTORY, 0755) != 0) fail("COULD NOT CREATE THE SHARD DIRECTORY " + string(SHARD_DIRECTORY));
+
+    // Partition the users into shards. The input is only mapped while it is scanned.
+    {
+        Stats::ScopedTimer timer(Stats::PARTITION);
+        MappedFile inputFile(inputFilename);
+        if (!inputFile.isOpen()) fail("COULD NOT OPEN THE USERS FILE " + inputFilename);
+        countUsers(inputFile.getContents());
+        partitionUsers(inputFile.getContents());
+        Stats::add(Stats::BYTES_PARSED, 2 * inputFile.getSize());
+        Stats::add(Stats::USERS, numUsers);
+        Stats::add(Stats::FOLLOWS, numFollows);
+    }
+    {
+        Stats::ScopedTimer timer(Stats::NAME_TABLE);
+        createNameTable();
+    }
+
+    // Map the name and link tables, which are paged in as the names and links are used
+    MappedFile nameOffsetsFile(string(SHARD_DIRECTORY) + "/name_offsets.bin");
+    MappedFile nameDataFile(string(SHARD_DIRECTORY) + "/names.bin");
+    MappedFile linkOffsetsFile(string(SHARD_DIRECTORY) + "/link_offsets.bin");
+    MappedFile linkDataFile(string(SHARD_DIRECTORY) + "/links.bin");
+    if (!nameOffsetsFile.isOpen() || !nameDataFile.isOpen() || !linkOffsetsFile.isOpen() || !linkDataFile.isOpen()) {
+        fail("COULD NOT OPEN THE NAME TABLE");
+    }
+    NameTable names(numUsers, reinterpret_cast<const uint64_t*>(nameOffsetsFile.getContents().data()),
+                    nameDataFile.getContents().data());
+    names.setLayout(&layout);
+    names.setLinks(reinterpret_cast<const uint64_t*>(linkOffsetsFile.getContents().data()),
+                   linkDataFile.getContents().data());
+
+    // Create the archive, or every directory of the layout that has a page in it. The IDs are 1 to numUsers, and the
+    // directory of a page only depends on the last digits of the ID, so the first 100^levels IDs cover every directory.
+    unique_ptr<PageArchive> archive;
+    if (!options.archiveFilename.empty()) {
+        archive = make_unique<PageArchive>(options.archiveFilename);
+        if (!archive->isOpen()) fail("COULD NOT CREATE THE ARCHIVE " + options.archiveFilename);
+    }
+    for (unsigned int currID = 1; currID <= numUsers && !archive; currID++) {
+        if (currID > 1 && layout.getDirectoryKey(currID) == layout.getDirectoryKey(1)) break;
+        if (!layout.createPageDirectory(currID)) {
+            fail("COULD NOT CREATE THE DIRECTORY " + layout.getPageDirectory(currID));
+        }
+    }
+
+    // Create the index page in pieces of at most a quarter of the budget, then the pages of each shard
+    SocialNetwork::createIndexHTMLFile(names, options.memoryBudget / 4, archive.get(), options.numJobs, nullptr,
+                                      options.pageFormats);
+    // With a write queue, one queue is shared by every shard, so the pages of a shard are still being written while
+    // the next shard is loaded
+    ThreadPool pool(options.numJobs);
+    unique_ptr<PageQueue> queue;
+    if (options.writeQueueBatches > 0) queue = make_unique<PageQueue>(layout, archive.get(), options.writeQueueBatches);
+    for (unsigned int shard = 0; shard < numShards; shard++) {
+        Stats::ScopedTimer timer(Stats::USER_PAGES);
+        createShardPages(shard, names, pool, archive.get(), queue.get());
+    }
+    if (queue) {
+        Stats::ScopedTimer timer(Stats::USER_PAGES);
+        queue->finish();
+    }
+    if (archive && !archive->finish()) fail("COULD NOT WRITE THE ARCHIVE " + options.archiveFilename);
+
+    removeShardFiles();
+}
+
+unsigned int StreamingGenerator::getNumShards() const {
+    /*
+     *  Returns the number of shards that the users were partitioned into (0 before createAllHTMLFiles is called)
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      unsigned int:
+     *          The number of shards
+     */
+
+    return numShards;
+}
+
+
+// -------------------------------------------- PRIVATE HELPER METHODS ---------------------------------------------- //
+
+void StreamingGenerator::countUsers(string_view contents) {
+    /*
+     *  Counts the users, the follows and the bytes of the strings in the input, and chooses the number of shards so
+     *  that a single shard fits in half of the memory budget.
+     *
+     *  Notes:
+     *      1) A shard in memory holds its user records, a User object per user, and its reverse edges (which are bucket
+     *         sorted into a CSR array). So a shard with n users and e follows uses roughly 128 * n + 24 * e bytes, plus
+     *         the bytes of its strings.
+     *      2) The other half of the budget is left for the write buffers of the shard files, the page buffers, and the
+     *         parts of the mapped files that are paged in.
+     *
+     *  Parameters:
+     *      string_view contents:
+     *          The contents of the input file
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    UserScanner scanner(contents);
+    UserFields fields;
+    while (scanner.nextUser(fields)) {
+        numUsers++;
+        numFollows += fields.follows.size();
+        numStringBytes += fields.name.size() + fields.location.size() + fields.pic_url.size();
+        fields.follows.clear();
+    }
+    if (numUsers == 0) fail("THE USERS FILE HAS NO USERS");
+
+    size_t estimatedBytes = 128 * static_cast<size_t>(numUsers) + 24 * numFollows + numStringBytes;
+    size_t shardBudget = max<size_t>(options.memoryBudget / 2, 1);
+    numShards = static_cast<unsigned int>(min<size_t>((estimatedBytes + shardBudget - 1) / shardBudget, numUsers));
+    numShards = max(numShards, 1u);
+    usersPerShard = (numUsers + numShards - 1) / numShards;
+    numShards = (numUsers + usersPerShard - 1) / usersPerShard;
+
+    // Each shard has two files that are written through their own buffer, which share a quarter of the budget
+    shardBufferSize = options.memoryBudget / (8 * static_cast<size_t>(numShards));
+    shardBufferSize = min<size_t>(max<size_t>(shardBufferSize, 4096), 1 << 20);
+}
+
+void StreamingGenerator::partitionUsers(string_view contents) const {
+    /*
+     *  Scans the input a second time, writing each user to the users shard of their ID, and each follow (as a reverse
+     *  edge) to the followers shard of the followed user. Every shard file is written through a buffer, which is
+     *  appended to the file whenever it fills up.
+     *
+     *  Parameters:
+     *      string_view contents:
+     *          The contents of the input file
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    vector<PageBuffer> userShards;
+    vector<PageBuffer> followerShards;
+    userShards.reserve(numShards);
+    followerShards.reserve(numShards);
+    for (unsigned int shard = 0; shard < numShards; shard++) {
+        userShards.emplace_back(shardBufferSize);
+        followerShards.emplace_back(shardBufferSize);
+    }
+
+    auto flush = [](PageBuffer& buffer, const char* kind, unsigned int shard) {
+        if (!buffer.appendToFile(getShardFilename(kind, shard))) {
+            fail("COULD NOT WRITE THE SHARD FILE " + getShardFilename(kind, shard));
+        }
+        buffer.clear();
+    };
+    auto appendBytes = [](PageBuffer& buffer, const void* data, size_t size) {
+        buffer.append(string_view(static_cast<const char*>(data), size));
+    };
+
+    UserScanner scanner(contents);
+    UserFields fields;
+    const char padding[4] = {};
+    while (scanner.nextUser(fields)) {
+        if (fields.id == 0 || fields.id > numUsers) {
+            fail("USER ID " + to_string(fields.id) + " IS NOT BETWEEN 1 AND THE NUMBER OF USERS (THE STREAMING MODE "
+                 "NEEDS THE IDS TO BE 1 TO THE NUMBER OF USERS)");
+        }
+        if (fields.name.empty()) fail("USER " + to_string(fields.id) + " HAS NO NAME");
+
+        // Write the user record into the users shard of the user
+        const uint32_t currID = fields.id;
+        unsigned int shard = (currID - 1) / usersPerShard;
+        PageBuffer& users = userShards[shard];
+        UserRecord record{};
+        record.id = currID;
+        record.nameLength = fields.name.size();
+        record.locationLength = fields.location.size();
+        record.picUrlLength = fields.pic_url.size();
+        record.numFollows = fields.follows.size();
+        appendBytes(users, &record, sizeof(UserRecord));
+
+        // Write the follows into the record, and a reverse edge for each follow into the followers shard of the
+        // followed user
+        for (uint64_t followedID : fields.follows) {
+            if (followedID == 0 || followedID > numUsers) {
+                fail("USER " + to_string(currID) + " FOLLOWS USER ID " + to_string(followedID) +
+                     ", WHICH IS NOT BETWEEN 1 AND THE NUMBER OF USERS");
+            }
+            const uint32_t followedID32 = followedID;
+            appendBytes(users, &followedID32, sizeof(uint32_t));
+
+            unsigned int followedShard = (followedID32 - 1) / usersPerShard;
+            ReverseEdge edge{followedID32, currID};
+            appendBytes(followerShards[followedShard], &edge, sizeof(ReverseEdge));
+            if (followerShards[followedShard].getSize() >= shardBufferSize) {
+                flush(followerShards[followedShard], "followers", followedShard);
+            }
+        }
+
+        users.append(fields.name);
+        users.append(fields.location);
+        users.append(fields.pic_url);
+        size_t stringsLength = record.nameLength + record.locationLength + record.picUrlLength;
+        appendBytes(users, padding, (4 - stringsLength % 4) % 4);
+        if (users.getSize() >= shardBufferSize) flush(users, "users", shard);
+        fields.follows.clear();
+    }
+
+    // Write the rest of every buffer (creating every file, even the empty ones)
+    for (unsigned int shard = 0; shard < numShards; shard++) {
+        flush(userShards[shard], "users", shard);
+        flush(followerShards[shard], "followers", shard);
+    }
+}
+
+void StreamingGenerator::createNameTable() const {
+    /*
+     *  Writes the name of every user to the name table, which is made of two files: names.bin holds the names back to
+     *  back in ID order, and name_offsets.bin holds numUsers + 1 offsets into it (see NameTable). The rendered link to
+     *  every user is written to links.bin and link_offsets.bin in the same way, so that pages copy each link from the
+     *  mapped file rather than formatting it (see NameTable::setLinks).
+     *
+     *  The users shards are read one at a time. Since the shards split the users by ID range, putting the users of each
+     *  shard in ID order puts every user in ID order. This is also where every ID is checked to appear exactly once.
+     *
+     *  Parameters:
+     *      Takes no parameters.
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    const string offsetsFilename = string(SHARD_DIRECTORY) + "/name_offsets.bin";
+    const string namesFilename = string(SHARD_DIRECTORY) + "/names.bin";
+    const string linkOffsetsFilename = string(SHARD_DIRECTORY) + "/link_offsets.bin";
+    const string linksFilename = string(SHARD_DIRECTORY) + "/links.bin";
+    PageBuffer offsets(shardBufferSize);
+    PageBuffer names(shardBufferSize);
+    PageBuffer linkOffsets(shardBufferSize);
+    PageBuffer links(shardBufferSize);
+    auto flush = [](PageBuffer& buffer, const string& filename) {
+        if (!buffer.appendToFile(filename)) fail("COULD NOT WRITE THE NAME TABLE " + filename);
+        buffer.clear();
+    };
+
+    uint64_t offset = 0;
+    uint64_t linkOffset = 0;
+    offsets.append(string_view(reinterpret_cast<const char*>(&offset), sizeof(uint64_t)));
+    linkOffsets.append(string_view(reinterpret_cast<const char*>(&linkOffset), sizeof(uint64_t)));
+
+    vector<const UserRecord*> shardUsers;
+    for (unsigned int shard = 0; shard < numShards; shard++) {
+        MappedFile usersFile(getShardFilename("users", shard));
+        if (!usersFile.isOpen()) fail("COULD NOT OPEN THE SHARD FILE " + getShardFilename("users", shard));
+
+        // Place each user of the shard by their ID
+        unsigned int firstID = shard * usersPerShard + 1;
+        unsigned int shardSize = min(usersPerShard, numUsers - firstID + 1);
+        shardUsers.assign(shardSize, nullptr);
+        const char* it = usersFile.getContents().data();
+        const char* end = it + usersFile.getSize();
+        while (it < end) {
+            const UserRecord* record = reinterpret_cast<const UserRecord*>(it);
+            if (shardUsers[record->id - firstID] != nullptr) {
+                fail("USER ID " + to_string(record->id) + " APPEARS MORE THAN ONCE");
+            }
+            shardUsers[record->id - firstID] = record;
+
+            size_t stringsLength = record->nameLength + record->locationLength + record->picUrlLength;
+            it += sizeof(UserRecord) + record->numFollows * sizeof(uint32_t) + (stringsLength + 3) / 4 * 4;
+        }
+
+        // Add the names in ID order
+        for (unsigned int i = 0; i < shardSize; i++) {
+            const UserRecord* record = shardUsers[i];
+            if (record == nullptr) fail("USER ID " + to_string(firstID + i) + " IS MISSING");
+
+            const char* name = reinterpret_cast<const char*>(record + 1) + record->numFollows * sizeof(uint32_t);
+            names.append(string_view(name, record->nameLength));
+            offset += record->nameLength;
+            offsets.append(string_view(reinterpret_cast<const char*>(&offset), sizeof(uint64_t)));
+
+            size_t linksSize = links.getSize();
+            layout.appendLink(links, record->id, string_view(name, record->nameLength), false);
+            linkOffset += links.getSize() - linksSize;
+            linkOffsets.append(string_view(reinterpret_cast<const char*>(&linkOffset), sizeof(uint64_t)));
+
+            if (names.getSize() >= shardBufferSize) flush(names, namesFilename);
+            if (offsets.getSize() >= shardBufferSize) flush(offsets, offsetsFilename);
+            if (links.getSize() >= shardBufferSize) flush(links, linksFilename);
+            if (linkOffsets.getSize() >= shardBufferSize) flush(linkOffsets, linkOffsetsFilename);
+        }
+    }
+
+    flush(names, namesFilename);
+    flush(offsets, offsetsFilename);
+    flush(links, linksFilename);
+    flush(linkOffsets, linkOffsetsFilename);
+}
+
+void StreamingGenerator::createShardPages(unsigned int shard, const NameTable& names, ThreadPool& pool,
+                                          PageArchive* archive, PageQueue* queue) const {
+    /*
+     *  Creates the user profile html file of every user in a shard.
+     *
+     *  The reverse edges of the shard are bucket sorted by the followed user into a CSR array of followers, where each
+     *  row is then sorted and de-duplicated. That gives the same followers (and, merged with the sorted follows list,
+     *  the same mutuals) as the followers index of SocialNetwork. The user records view the mapped users shard file, so
+     *  nothing about a user is copied.
+     *
+     *  Parameters:
+     *      unsigned int shard:
+     *          The shard to create the pages for
+     *
+     *      const NameTable& names:
+     *          The name of every user in the network
+     *
+     *      ThreadPool& pool:
+     *          The pool to create the pages with
+     *
+     *      PageArchive* archive:
+     *          The archive to add the pages to, or nullptr to create a file for each page
+     *
+     *      PageQueue* queue:
+     *          The queue to hand the pages to (which writes them to the archive, if there is one), or nullptr for the
+     *          workers to write them
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    const unsigned int firstID = shard * usersPerShard + 1;
+    const unsigned int shardSize = min(usersPerShard, numUsers - firstID + 1);
+
+    // Create the users of the shard, in ID order (every ID was checked to appear once by createNameTable)
+    MappedFile usersFile(getShardFilename("users", shard));
+    if (!usersFile.isOpen()) fail("COULD NOT OPEN THE SHARD FILE " + getShardFilename("users", shard));
+    vector<User> users(shardSize);
+    const char* it = usersFile.getContents().data();
+    const char* end = it + usersFile.getSize();
+    while (it < end) {
+        const UserRecord* record = reinterpret_cast<const UserRecord*>(it);
+        const unsigned int* follows = reinterpret_cast<const unsigned int*>(record + 1);
+        const char* strings = reinterpret_cast<const char*>(follows + record->numFollows);
+
+        users[record->id - firstID] = User(record->id,
+                                           string_view(strings, record->nameLength),
+                                           string_view(strings + record->nameLength, record->locationLength),
+                                           string_view(strings + record->nameLength + record->locationLength,
+                                                       record->picUrlLength),
+                                           IdSpan(follows, record->numFollows));
+
+        size_t stringsLength = record->nameLength + record->locationLength + record->picUrlLength;
+        it += sizeof(UserRecord) + record->numFollows * sizeof(uint32_t) + (stringsLength + 3) / 4 * 4;
+    }
+
+    // Bucket sort the reverse edges of the shard by the followed user
+    vector<size_t> followerOffsets(shardSize + 1, 0);
+    vector<unsigned int> followerIDs;
+    {
+        MappedFile followersFile(getShardFilename("followers", shard));
+        if (!followersFile.isOpen()) fail("COULD NOT OPEN THE SHARD FILE " + getShardFilename("followers", shard));
+        const ReverseEdge* edges = reinterpret_cast<const ReverseEdge*>(followersFile.getContents().data());
+        const size_t numEdges = followersFile.getSize() / sizeof(ReverseEdge);
+
+        for (size_t e = 0; e < numEdges; e++) followerOffsets[edges[e].to - firstID + 1]++;
+        for (unsigned int i = 0; i < shardSize; i++) followerOffsets[i + 1] += followerOffsets[i];
+        followerIDs.resize(numEdges);
+        vector<size_t> next(followerOffsets.begin(), followerOffsets.end() - 1);
+        for (size_t e = 0; e < numEdges; e++) followerIDs[next[edges[e].to - firstID]++] = edges[e].from;
+    }
+
+    // Sort each row and remove any duplicate follows, compacting the rows in place
+    size_t compactedEnd = 0;
+    for (unsigned int i = 0; i < shardSize; i++) {
+        auto rowBegin = followerIDs.begin() + followerOffsets[i];
+        auto rowEnd = followerIDs.begin() + followerOffsets[i + 1];
+        sort(rowBegin, rowEnd);
+        rowEnd = unique(rowBegin, rowEnd);
+
+        followerOffsets[i] = compactedEnd;
+        compactedEnd = move(rowBegin, rowEnd, followerIDs.begin() + compactedEnd) - followerIDs.begin();
+    }
+    followerOffsets[shardSize] = compactedEnd;
+    Stats::add(Stats::EDGES, compactedEnd);
+
+    // Create the pages of the shard, each worker reusing its own vectors and page buffer (and, with an archive, its own
+    // batch of pages). The pages are in ID order, which visits a different directory every page, so without an archive
+    // each page is simply opened by its path (unless it is also compressed, which the writers do).
+    const unsigned int numWorkers = pool.getNumThreads();
+    vector<vector<unsigned int>> followersIDs(numWorkers);
+    vector<vector<unsigned int>> mutualsIDs(numWorkers);
+    vector<vector<unsigned int>> followsRows(numWorkers);
+    vector<PageBuffer> pages(numWorkers);
+    vector<PageWriter> writers(numWorkers);
+    for (PageWriter& writer : writers) {
+        if (queue != nullptr) writer.setQueue(queue);
+        else writer.setArchive(archive);
+        writer.setFormats(options.pageFormats);
+    }
+    const bool useWriters = archive != nullptr || queue != nullptr || options.pageFormats != PageCompressor::PLAIN;
+    pool.parallelFor(0, shardSize, 64, [&](unsigned int worker, size_t i) {
+        Profiler::PageTimer pageTimer;
+        const User& currUser = users[i];
+        const unsigned int currID = firstID + i;
+        vector<unsigned int>& followers = followersIDs[worker];
+        vector<unsigned int>& mutuals = mutualsIDs[worker];
+        vector<unsigned int>& followsRow = followsRows[worker];
+
+        // A user that follows themselves is not considered to be their own follower
+        followers.clear();
+        for (size_t j = followerOffsets[i]; j < followerOffsets[i + 1]; j++) {
+            if (followerIDs[j] != currID) followers.push_back(followerIDs[j]);
+        }
+
+        // The mutuals are the intersection of the sorted follows list and the followers
+        followsRow.assign(currUser.getFollows().begin(), currUser.getFollows().end());
+        sort(followsRow.begin(), followsRow.end());
+        followsRow.erase(unique(followsRow.begin(), followsRow.end()), followsRow.end());
+        mutuals.resize(min(followsRow.size(), followers.size()));
+        mutuals.resize(SortedIntersection::intersect(followsRow.data(), followsRow.size(), followers.data(),
+                                                     followers.size(), mutuals.data()));
+
+        currUser.generateUserHTMLProfilePage(pages[worker], names, followers, mutuals,
+                                             useWriters ? &writers[worker] : nullptr);
+        pageTimer.stop(currID, currUser.getFollows().size(), followers.size(), mutuals.size());
+    });
+
+    for (PageWriter& writer : writers) {
+        if (!writer.flush()) fail("COULD NOT WRITE THE USER PAGES TO THE ARCHIVE " + options.archiveFilename);
+    }
+}
+
+string StreamingGenerator::getShardFilename(const char* kind, unsigned int shard) {
+    /*
+     *  Returns the filename of a shard file
+     *
+     *  Parameters:
+     *      const char* kind:
+     *          "users" for the file of user records, or "followers" for the file of reverse edges
+     *
+     *      unsigned int shard:
+     *          The number of the shard
+     *
+     *  Returns:
+     *      string:
+     *          The filename, inside SHARD_DIRECTORY
+     */
+
+    return string(SHARD_DIRECTORY) + "/" + kind + "_" + to_string(shard) + ".bin";
+}
+
+void StreamingGenerator::removeShardFiles() {
+    /*
+     *  Removes every file in SHARD_DIRECTORY (including ones left behind by an earlier run that was interrupted), and
+     *  then the directory itself.
+     *
+     *  Parameters:
+     *      Takes no parameters.
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    DIR* directory = opendir(SHARD_DIRECTORY);
+    if (directory == nullptr) return;
+
+    while (dirent* entry = readdir(directory)) {
+        string filename = entry->d_name;
+        if (filename == "." || filename == "..") continue;
+        unlink((string(SHARD_DIRECTORY) + "/" + filename).c_str());
+    }
+    closedir(directory);
+    rmdir(SHARD_DIRECTORY);
+}
+
+void StreamingGenerator::fail(const string& reason) {
+    /*
+     *  Reports an error in the input (or in writing the shard files), removes the shard files that were written so far
+     *  and terminates the program.
+     *
+     *  Parameters:
+     *      const string& reason:
+     *          A short description of the error
+     *
+     *  Returns:
+     *      Does not return.
+     */
+
+    cerr << "ERROR -- " << reason << " -- TERMINATING" << endl;
+    removeShardFiles();
+    exit(1);
+}
@@ -0,0 +1,106 @@
+/** *************************************************************
+ *  Declaration of the StreamingGenerator class                 *
+ *  @author Brandon Dale                                        *
+ *                                                              *
+ *  Creates the HTML files of a social network that does not    *
+ *  fit in memory. The users are partitioned by ID range into   *
+ *  shard files on disk, with the reverse (follower) edges of   *
+ *  each shard bucketed next to them, and the pages are then    *
+ *  created one shard at a time. The names are kept in a table  *
+ *  on disk that is memory mapped, so only a single shard is    *
+ *  ever held in memory, which keeps the memory used within a   *
+ *  budget. The files created are the same as the ones created  *
+ *  by SocialNetwork.                                           *
+ *                                                              *
+ *  @file StreamingGenerator.h                                  *
+ *  @date October 14th, 2026                                    *
+ ***************************************************************/
+
+
+#ifndef CS315_PROJECT01_STREAMINGGENERATOR_H
+#define CS315_PROJECT01_STREAMINGGENERATOR_H
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "OutputOptions.h"
+#include "OutputLayout.h"
+#include "NameTable.h"
+#include "ThreadPool.h"
+#include "PageArchive.h"
+#include "PageQueue.h"
+
+
+class StreamingGenerator {
+public:
+    // ------------------------------------------------ Constructors ------------------------------------------------ //
+    // Prepares to create the HTML files of the users in JSON_Filename, within options.memoryBudget bytes of memory
+    StreamingGenerator(const std::string& JSON_Filename, const OutputOptions& options);
+
+
+    // ----------------------------------------------- Public Methods ----------------------------------------------- //
+    // Creates index.html and the page of every user, one shard at a time
+    void createAllHTMLFiles();
+
+    // Returns the number of shards that the users were partitioned into
+    unsigned int getNumShards() const;
+
+private:
+    // The record of a single user in a users shard file. It is followed by the follows list, then the characters of the
+    // name, location and pic_url, padded to a multiple of 4 bytes.
+    struct UserRecord {
+        uint32_t id;
+        uint32_t nameLength;
+        uint32_t locationLength;
+        uint32_t picUrlLength;
+        uint32_t numFollows;
+    };
+
+    // A reverse edge in a followers shard file: the user with the ID "from" follows the user with the ID "to"
+    struct ReverseEdge {
+        uint32_t to;
+        uint32_t from;
+    };
+
+    // -------------------------------------------- Private Data Members -------------------------------------------- //
+    std::string inputFilename;
+    OutputOptions options;
+    OutputLayout layout;                // the layout of the pages (from options.shardLevels and options.pageSize)
+    unsigned int numUsers;
+    std::size_t numFollows;
+    std::size_t numStringBytes;
+    unsigned int numShards;
+    unsigned int usersPerShard;
+    std::size_t shardBufferSize;     // the size of the write buffer of each shard file
+
+    static const char* const SHARD_DIRECTORY;
+
+    // -----------------------------------------  Private Helper Functions ------------------------------------------ //
+    // Counts the users, follows and string bytes of the input, and chooses the number of shards from them
+    void countUsers(std::string_view contents);
+
+    // Writes every user to the users shard of their ID, and every follow to the followers shard of the followed user
+    void partitionUsers(std::string_view contents) const;
+
+    // Writes the names of every user, in ID order, to the name table files
+    void createNameTable() const;
+
+    // Creates the page of every user in a shard, using the mapped name table for the names of the linked users (in
+    // archive, if it is not nullptr). If queue is not nullptr, the pages are handed to it to write.
+    void createShardPages(unsigned int shard, const NameTable& names, ThreadPool& pool, PageArchive* archive,
+                          PageQueue* queue) const;
+
+    // Returns the filename of a shard file (kind is "users" or "followers")
+    static std::string getShardFilename(const char* kind, unsigned int shard);
+
+    // Removes every shard file, and the shard directory
+    static void removeShardFiles();
+
+    // Reports an error in the input, removes the shard files and terminates the program
+    [[noreturn]] static void fail(const std::string& reason);
+};
+
+
+#endif //CS315_PROJECT01_STREAMINGGENERATOR_H
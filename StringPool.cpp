@@ -0,0 +1,185 @@
+/** ****************************************************************
+ *  Implementation of the StringPool class                         *
+ *  @author Brandon Dale                                           *
+ *                                                                 *
+ *  Strings are copied into 1 MB blocks. A block is never resized  *
+ *  or freed before the pool, so every view stays valid for the    *
+ *  lifetime of the pool.                                          *
+ *                                                                 *
+ *  @file StringPool.cpp                                           *
+ *  @date October 14th, 2026                                       *
+ ******************************************************************/
+
+
+#include "StringPool.h"
+#include <cstring>
+#include <iterator>
+
+using namespace std;
+
+
+// -------------------------------------------------- CONSTRUCTORS -------------------------------------------------- //
+
+StringPool::StringPool() {
+    /*
+     *  Creates an empty pool. No block is allocated until the first string is added.
+     *
+     *  Parameters:
+     *      Takes no parameters
+     *
+     *  Returns:
+     *      No return value, creates a StringPool object
+     */
+
+    blockUsed = 0;
+    blockCapacity = 0;
+    numBytes = 0;
+    numStored = 0;
+}
+
+
+// ------------------------------------------------ PUBLIC METHODS -------------------------------------------------- //
+
+string_view StringPool::intern(string_view str) {
+    /*
+     *  Returns a view of the pool's copy of str.
+     *
+     *  If an equal string was added before, the view of that copy is returned, so equal strings always share the same
+     *  storage. Otherwise, str is copied into the current block (a new block is started if it does not fit). A string
+     *  larger than a whole block gets a block of its own.
+     *
+     *  Parameters:
+     *      string_view str:
+     *          The string to intern. It does not need to stay alive after this call.
+     *
+     *  Returns:
+     *      string_view:
+     *          A view of the interned copy, valid for the lifetime of the pool
+     */
+
+    if (str.empty()) return string_view();
+
+    auto existing = strings.find(str);
+    if (existing != strings.end()) return *existing;
+
+    string_view interned = store(str);
+    strings.insert(interned);
+    return interned;
+}
+
+string_view StringPool::store(string_view str) {
+    /*
+     *  Returns a view of a new copy of str in the pool. Unlike intern, this does not look for (or remember) an equal
+     *  string, which saves a lookup table entry for strings that are rarely repeated, such as names.
+     *
+     *  The string is copied into the current block (a new block is started if it does not fit). A string larger than a
+     *  whole block gets a block of its own.
+     *
+     *  Parameters:
+     *      string_view str:
+     *          The string to store. It does not need to stay alive after this call.
+     *
+     *  Returns:
+     *      string_view:
+     *          A view of the copy, valid for the lifetime of the pool
+     */
+
+    if (str.empty()) return string_view();
+
+    // Start a new block if the string does not fit in the current one
+    if (blocks.empty() || blockCapacity - blockUsed < str.size()) {
+        blockCapacity = str.size() > BLOCK_SIZE ? str.size() : BLOCK_SIZE;
+        blocks.push_back(make_unique<char[]>(blockCapacity));
+        blockUsed = 0;
+    }
+
+    char* copy = blocks.back().get() + blockUsed;
+    memcpy(copy, str.data(), str.size());
+    blockUsed += str.size();
+    numBytes += str.size();
+    numStored++;
+
+    return string_view(copy, str.size());
+}
+
+void StringPool::keepAlive(shared_ptr<const void> storage) {
+    /*
+     *  Keeps external storage alive for as long as the pool. This lets users hold views directly into memory that the
+     *  pool does not own (such as the string table of a mapped snapshot) without copying it into the pool.
+     *
+     *  Parameters:
+     *      shared_ptr<const void> storage:
+     *          The owner of the external memory
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    externalStorage.push_back(move(storage));
+}
+
+void StringPool::adopt(StringPool& other) {
+    /*
+     *  Takes over every block and external storage of another pool, which is left empty. The views handed out by the
+     *  other pool point into those blocks, so they stay valid for the lifetime of this pool.
+     *
+     *  The strings of the other pool are not added to the lookup table, so an equal string interned later is copied
+     *  again. This lets a pool be filled by each thread on its own, with no locking, and then be merged at the cost of
+     *  at most one copy of each distinct string per thread.
+     *
+     *  Parameters:
+     *      StringPool& other:
+     *          The pool to take the strings of
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    if (&other == this) return;
+
+    // The current block stays the last one, so that new strings keep filling it
+    blocks.insert(blocks.end() - (blocks.empty() ? 0 : 1), make_move_iterator(other.blocks.begin()),
+                  make_move_iterator(other.blocks.end()));
+    externalStorage.insert(externalStorage.end(), make_move_iterator(other.externalStorage.begin()),
+                           make_move_iterator(other.externalStorage.end()));
+    numBytes += other.numBytes;
+    numStored += other.numStored;
+
+    other.blocks.clear();
+    other.externalStorage.clear();
+    other.strings.clear();
+    other.blockUsed = 0;
+    other.blockCapacity = 0;
+    other.numBytes = 0;
+    other.numStored = 0;
+}
+
+size_t StringPool::getNumStrings() const {
+    /*
+     *  Returns the number of strings in the pool (every interned string once, plus every stored string)
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      size_t:
+     *          The number of strings that were copied into the pool
+     */
+
+    return numStored;
+}
+
+size_t StringPool::getNumBytes() const {
+    /*
+     *  Returns the number of bytes of string data stored in the pool
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      size_t:
+     *          The total length of every distinct string in the pool
+     */
+
+    return numBytes;
+}
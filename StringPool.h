@@ -0,0 +1,72 @@
+/** *************************************************************
+ *  Declaration of the StringPool class                         *
+ *  @author Brandon Dale                                        *
+ *                                                              *
+ *  An interning arena for the strings of a social network.     *
+ *  Each distinct string is stored exactly once, in large       *
+ *  blocks that never move, and is handed out as a string_view. *
+ *  So a repeated location, or the default picture url, costs   *
+ *  a single copy no matter how many users share it.            *
+ *                                                              *
+ *  @file StringPool.h                                          *
+ *  @date October 14th, 2026                                    *
+ ***************************************************************/
+
+
+#ifndef CS315_PROJECT01_STRINGPOOL_H
+#define CS315_PROJECT01_STRINGPOOL_H
+
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <unordered_set>
+#include <cstddef>
+
+
+class StringPool {
+public:
+    // ------------------------------------------------ Constructors ------------------------------------------------ //
+    // Creates an empty pool
+    StringPool();
+
+    // The views handed out point into the pool, so it can not be copied
+    StringPool(const StringPool&) = delete;
+    StringPool& operator=(const StringPool&) = delete;
+
+
+    // ----------------------------------------------- Public Methods ----------------------------------------------- //
+    // Returns a view of the pool's copy of str, adding str to the pool if it is not already in it
+    std::string_view intern(std::string_view str);
+
+    // Returns a view of a new copy of str in the pool, without looking for an equal string (for strings that are rarely
+    // repeated, such as names, where the lookup table would cost more than it saves)
+    std::string_view store(std::string_view str);
+
+    // Keeps external storage (such as a mapped snapshot) alive for as long as the pool, for views that point into it
+    void keepAlive(std::shared_ptr<const void> storage);
+
+    // Takes over the strings of another pool (such as one filled by another thread), so its views stay valid for the
+    // lifetime of this pool. Strings that are in both pools are not merged.
+    void adopt(StringPool& other);
+
+    // Returns the number of strings in the pool
+    std::size_t getNumStrings() const;
+
+    // Returns the number of bytes of string data stored in the pool
+    std::size_t getNumBytes() const;
+
+private:
+    // -------------------------------------------- Private Data Members -------------------------------------------- //
+    std::vector<std::unique_ptr<char[]>> blocks;
+    std::size_t blockUsed;                          // the number of bytes used in the last block
+    std::size_t blockCapacity;                      // the size of the last block
+    std::size_t numBytes;
+    std::size_t numStored;
+    std::unordered_set<std::string_view> strings;   // views of every interned string
+    std::vector<std::shared_ptr<const void>> externalStorage;
+
+    static const std::size_t BLOCK_SIZE = 1 << 20;
+};
+
+
+#endif //CS315_PROJECT01_STRINGPOOL_H
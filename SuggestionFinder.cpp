@@ -0,0 +1,109 @@
+/** ****************************************************************
+ *  Implementation of the SuggestionFinder class                   *
+ *  @author Brandon Dale                                           *
+ *                                                                 *
+ *  @file SuggestionFinder.cpp                                     *
+ *  @date October 14th, 2026                                       *
+ ******************************************************************/
+
+
+#include "SuggestionFinder.h"
+#include <algorithm>
+
+using namespace std;
+
+
+// -------------------------------------------------- CONSTRUCTORS -------------------------------------------------- //
+
+SuggestionFinder::SuggestionFinder(const AdjacencyIndex& followsIndex, unsigned int maxSuggestions,
+                                   unsigned int hubDegreeCap)
+    : followsIndex(followsIndex), maxSuggestions(maxSuggestions), hubDegreeCap(hubDegreeCap) {
+    /*
+     *  Creates a finder of suggestions. The array of scores (one per user) is only allocated once the first user's
+     *  suggestions are found.
+     *
+     *  Parameters:
+     *      const AdjacencyIndex& followsIndex:
+     *          The follows index of the network, which must outlive the finder
+     *
+     *      unsigned int maxSuggestions:
+     *          The largest number of suggestions to find for each user
+     *
+     *      unsigned int hubDegreeCap:
+     *          The largest number of follows that a user suggesting others can have (and the largest number of the
+     *          users that each user follows that are looked through)
+     *
+     *  Returns:
+     *      No return value, creates a SuggestionFinder object
+     */
+}
+
+
+// ------------------------------------------------ PUBLIC METHODS -------------------------------------------------- //
+
+void SuggestionFinder::findSuggestions(unsigned int index, vector<unsigned int>& suggestions) {
+    /*
+     *  Finds the best suggestions for a user. The score of a suggested user is the number of the users that the user
+     *  follows who follow them. Users with greater scores are better, and ties are broken by the smaller ID.
+     *
+     *  The user and everyone they already follow are marked as excluded in the scores. Then the follows row of each
+     *  user they follow (who is not a hub) is added to the scores, remembering each user whose score becomes 1. The
+     *  best of those are kept in a heap of maxSuggestions users, and every score that was touched is reset to 0, so
+     *  finding the suggestions of a user costs O(rows looked through) rather than O(number of users).
+     *
+     *  Parameters:
+     *      unsigned int index:
+     *          The 0-based index of the user
+     *
+     *      vector<unsigned int>& suggestions:
+     *          Set to the IDs (index + 1) of the best suggestions, best first
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    suggestions.clear();
+    if (maxSuggestions == 0) return;
+    if (scores.empty()) scores.assign(followsIndex.getNumVertices(), 0);
+
+    const unsigned int* followsBegin = followsIndex.rowBegin(index);
+    const unsigned int* followsEnd = followsIndex.rowEnd(index);
+    scores[index] = EXCLUDED;
+    for (const unsigned int* it = followsBegin; it != followsEnd; it++) scores[*it] = EXCLUDED;
+
+    // Count how many of the users that the user follows follow each other user
+    const unsigned int* expandEnd = followsBegin + min<size_t>(followsEnd - followsBegin, hubDegreeCap);
+    for (const unsigned int* it = followsBegin; it != expandEnd; it++) {
+        if (followsIndex.getDegree(*it) > hubDegreeCap) continue;
+        for (const unsigned int* other = followsIndex.rowBegin(*it); other != followsIndex.rowEnd(*it); other++) {
+            unsigned int& score = scores[*other];
+            if (score == EXCLUDED) continue;
+            if (score++ == 0) candidates.push_back(*other);
+        }
+    }
+
+    // Keep the best candidates in a heap whose top is the worst of them, so each candidate is compared with it
+    auto isBetter = [this](unsigned int a, unsigned int b) {
+        return scores[a] > scores[b] || (scores[a] == scores[b] && a < b);
+    };
+    best.clear();
+    for (unsigned int candidate : candidates) {
+        if (best.size() < maxSuggestions) {
+            best.push_back(candidate);
+            push_heap(best.begin(), best.end(), isBetter);
+        }
+        else if (isBetter(candidate, best.front())) {
+            pop_heap(best.begin(), best.end(), isBetter);
+            best.back() = candidate;
+            push_heap(best.begin(), best.end(), isBetter);
+        }
+    }
+    sort_heap(best.begin(), best.end(), isBetter);
+    for (unsigned int suggested : best) suggestions.push_back(suggested + 1);
+
+    // Reset every score that was touched
+    for (unsigned int candidate : candidates) scores[candidate] = 0;
+    candidates.clear();
+    scores[index] = 0;
+    for (const unsigned int* it = followsBegin; it != followsEnd; it++) scores[*it] = 0;
+}
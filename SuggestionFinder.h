@@ -0,0 +1,56 @@
+/** *************************************************************
+ *  Declaration of the SuggestionFinder class                   *
+ *  @author Brandon Dale                                        *
+ *                                                              *
+ *  Finds the "Suggested" users of a user page: the users that  *
+ *  are followed by the most of the users that a user follows   *
+ *  (friends of friends), who the user does not follow yet.     *
+ *  Scores are counted in a dense array indexed by user, so no  *
+ *  hashing is needed, and only the entries that were touched   *
+ *  are reset after each user. Each thread that creates pages   *
+ *  keeps a finder of its own.                                  *
+ *                                                              *
+ *  @file SuggestionFinder.h                                    *
+ *  @date October 14th, 2026                                    *
+ ***************************************************************/
+
+
+#ifndef CS315_PROJECT01_SUGGESTIONFINDER_H
+#define CS315_PROJECT01_SUGGESTIONFINDER_H
+
+#include <vector>
+#include "AdjacencyIndex.h"
+
+
+class SuggestionFinder {
+public:
+    // ------------------------------------------------ Constructors ------------------------------------------------ //
+    // Finds up to maxSuggestions suggestions per user from a follows index, which must outlive the finder. A user who
+    // follows more than hubDegreeCap users is not used to suggest anyone, and each user only looks through the first
+    // hubDegreeCap users that they follow, so the work per user is at most hubDegreeCap * hubDegreeCap.
+    SuggestionFinder(const AdjacencyIndex& followsIndex, unsigned int maxSuggestions,
+                     unsigned int hubDegreeCap = DEFAULT_HUB_DEGREE_CAP);
+
+
+    // ----------------------------------------------- Public Methods ----------------------------------------------- //
+    // Sets suggestions to the IDs (index + 1) of the best suggestions for the user with a 0-based index, best first
+    void findSuggestions(unsigned int index, std::vector<unsigned int>& suggestions);
+
+    // The hub degree cap, if none is given
+    static const unsigned int DEFAULT_HUB_DEGREE_CAP = 1000;
+
+private:
+    // -------------------------------------------- Private Data Members -------------------------------------------- //
+    const AdjacencyIndex& followsIndex;
+    unsigned int maxSuggestions;
+    unsigned int hubDegreeCap;
+    std::vector<unsigned int> scores;       // the score of every user, or EXCLUDED (allocated on first use)
+    std::vector<unsigned int> candidates;   // the users whose score is not 0, for the current user
+    std::vector<unsigned int> best;         // a heap of the best candidates so far, with the worst on top
+
+    // Marks the user and the users they follow, who can not be suggested to them
+    static const unsigned int EXCLUDED = ~0u;
+};
+
+
+#endif //CS315_PROJECT01_SUGGESTIONFINDER_H
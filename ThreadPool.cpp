@@ -0,0 +1,281 @@
+/** ****************************************************************
+ *  Implementation of the ThreadPool class                         *
+ *  @author Brandon Dale                                           *
+ *                                                                 *
+ *  Each parallel for loop splits its range of indices evenly      *
+ *  between the workers. A worker takes blocks of grainSize        *
+ *  indices from the front of its own range, and once it is empty  *
+ *  it steals the back half of another worker's range.             *
+ *                                                                 *
+ *  @file ThreadPool.cpp                                           *
+ *  @date October 14th, 2026                                       *
+ ******************************************************************/
+
+
+#include "ThreadPool.h"
+#include "Profiler.h"
+#include <algorithm>
+
+using namespace std;
+
+
+// -------------------------------------------------- CONSTRUCTORS -------------------------------------------------- //
+
+ThreadPool::ThreadPool(unsigned int numThreads) {
+    /*
+     *  Creates a pool of worker threads. The thread that calls parallelFor also runs tasks, so only (numThreads - 1)
+     *  extra threads are created.
+     *
+     *  Parameters:
+     *      unsigned int numThreads:
+     *          The number of threads to run tasks on. If it is 0, the hardware concurrency is used instead.
+     *
+     *  Returns:
+     *      No return value, creates a ThreadPool object
+     */
+
+    this->numThreads = (numThreads == 0) ? getDefaultNumThreads() : numThreads;
+    currentTask = nullptr;
+    currentGrainSize = 1;
+    currentStage = -1;
+    jobNumber = 0;
+    workersRunning = 0;
+    stopping = false;
+
+    for (unsigned int worker = 0; worker < this->numThreads; worker++) {
+        ranges.push_back(make_unique<WorkRange>());
+    }
+
+    // Worker 0 is always the calling thread
+    for (unsigned int worker = 1; worker < this->numThreads; worker++) {
+        threads.emplace_back(&ThreadPool::workerLoop, this, worker);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    /*
+     *  Destructor, tells every worker thread to stop and then waits for them to finish.
+     */
+
+    {
+        lock_guard<mutex> guard(jobLock);
+        stopping = true;
+    }
+    jobStarted.notify_all();
+
+    for (thread& t : threads) {
+        t.join();
+    }
+}
+
+
+// ------------------------------------------------ PUBLIC METHODS -------------------------------------------------- //
+
+unsigned int ThreadPool::getNumThreads() const {
+    /*
+     *  Returns the number of threads that run a parallel for loop (including the calling thread)
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      unsigned int:
+     *          The number of threads in the pool
+     */
+
+    return numThreads;
+}
+
+void ThreadPool::parallelFor(size_t first, size_t last, size_t grainSize,
+                             const function<void(unsigned int, size_t)>& task) {
+    /*
+     *  Runs task(worker, i) for every i in [first, last), and returns once every task is done.
+     *
+     *  The range is first split evenly between the workers. Each worker then runs blocks of grainSize indices of its own
+     *  range, and steals from the other workers once its own range is empty. Tasks with the same worker number never
+     *  run at the same time, so the worker number can be used to index per-thread data (such as output buffers).
+     *
+     *  Parameters:
+     *      size_t first:
+     *          The first index to run a task for
+     *
+     *      size_t last:
+     *          One past the last index to run a task for
+     *
+     *      size_t grainSize:
+     *          The number of indices that a worker takes at a time. Larger values lower the scheduling overhead, smaller
+     *          values balance the work better.
+     *
+     *      const function<void(unsigned int, size_t)>& task:
+     *          The task to run for each index. Is passed the worker number and the index.
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    if (first >= last) return;
+
+    // Split the range as evenly as possible between all the workers
+    size_t count = last - first;
+    for (unsigned int worker = 0; worker < numThreads; worker++) {
+        lock_guard<mutex> guard(ranges[worker]->lock);
+        ranges[worker]->begin = first + count * worker / numThreads;
+        ranges[worker]->end = first + count * (worker + 1) / numThreads;
+    }
+
+    // Start the job on every worker thread, and run the calling thread's share of it
+    {
+        lock_guard<mutex> guard(jobLock);
+        currentTask = &task;
+        currentGrainSize = max<size_t>(grainSize, 1);
+        currentStage = Profiler::getThreadStage();
+        workersRunning = numThreads - 1;
+        jobNumber++;
+    }
+    jobStarted.notify_all();
+
+    runTasks(0);
+
+    // Wait for the other workers to finish their tasks
+    unique_lock<mutex> guard(jobLock);
+    jobFinished.wait(guard, [this]() { return workersRunning == 0; });
+    currentTask = nullptr;
+}
+
+unsigned int ThreadPool::getDefaultNumThreads() {
+    /*
+     *  Returns the number of threads to use when none is specified.
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      unsigned int:
+     *          The hardware concurrency, or 1 if it can not be determined
+     */
+
+    unsigned int hardwareThreads = thread::hardware_concurrency();
+    return (hardwareThreads == 0) ? 1 : hardwareThreads;
+}
+
+
+// -------------------------------------------- PRIVATE HELPER METHODS ---------------------------------------------- //
+
+void ThreadPool::workerLoop(unsigned int worker) {
+    /*
+     *  The main loop of a worker thread. Waits for a new job to start, runs its share of the job, and then reports that
+     *  it is finished. Returns once the pool is being destroyed.
+     *
+     *  Parameters:
+     *      unsigned int worker:
+     *          The worker number of this thread
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    unsigned long long lastJob = 0;
+    int stage = -1;
+    while (true) {
+        {
+            unique_lock<mutex> guard(jobLock);
+            jobStarted.wait(guard, [this, lastJob]() { return stopping || jobNumber != lastJob; });
+            if (stopping) return;
+            lastJob = jobNumber;
+            stage = currentStage;
+        }
+
+        // The worker is in the stage of the job while it runs it, so a profiled run counts its allocations there
+        Profiler::setThreadStage(stage);
+        runTasks(worker);
+        Profiler::setThreadStage(-1);
+
+        lock_guard<mutex> guard(jobLock);
+        workersRunning--;
+        if (workersRunning == 0) jobFinished.notify_all();
+    }
+}
+
+void ThreadPool::runTasks(unsigned int worker) {
+    /*
+     *  Runs tasks until there is no work left in any range.
+     *
+     *  Parameters:
+     *      unsigned int worker:
+     *          The worker number of the calling thread
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    size_t begin;
+    size_t end;
+    while (takeWork(worker, begin, end)) {
+        for (size_t i = begin; i < end; i++) {
+            (*currentTask)(worker, i);
+        }
+    }
+}
+
+bool ThreadPool::takeWork(unsigned int worker, size_t& begin, size_t& end) {
+    /*
+     *  Takes the next block of (at most grainSize) indices for a worker.
+     *
+     *  The block is taken from the front of the worker's own range. If that range is empty, the back half of the first
+     *  non-empty range of another worker is stolen: the first block of it is returned, and the rest becomes the worker's
+     *  own range.
+     *
+     *  Parameters:
+     *      unsigned int worker:
+     *          The worker number of the calling thread
+     *
+     *      size_t& begin:
+     *          Is set to the first index of the block
+     *
+     *      size_t& end:
+     *          Is set to one past the last index of the block
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if a block was taken.
+     *          Returns false if there is no work left in any range.
+     */
+
+    // Take work from the worker's own range first
+    WorkRange& own = *ranges[worker];
+    {
+        lock_guard<mutex> guard(own.lock);
+        if (own.begin < own.end) {
+            begin = own.begin;
+            end = min(own.end, own.begin + currentGrainSize);
+            own.begin = end;
+            return true;
+        }
+    }
+
+    // Otherwise, steal the back half of another worker's range
+    for (unsigned int offset = 1; offset < numThreads; offset++) {
+        WorkRange& victim = *ranges[(worker + offset) % numThreads];
+        size_t stolenBegin;
+        size_t stolenEnd;
+        {
+            lock_guard<mutex> guard(victim.lock);
+            if (victim.begin >= victim.end) continue;
+
+            size_t remaining = victim.end - victim.begin;
+            stolenBegin = (remaining <= currentGrainSize) ? victim.begin : victim.end - remaining / 2;
+            stolenEnd = victim.end;
+            victim.end = stolenBegin;
+        }
+
+        begin = stolenBegin;
+        end = min(stolenEnd, stolenBegin + currentGrainSize);
+
+        lock_guard<mutex> guard(own.lock);
+        own.begin = end;
+        own.end = stolenEnd;
+        return true;
+    }
+
+    return false;
+}
@@ -0,0 +1,90 @@
+/** *************************************************************
+ *  Declaration of the ThreadPool class                         *
+ *  @author Brandon Dale                                        *
+ *                                                              *
+ *  A fixed size pool of worker threads which run parallel for  *
+ *  loops over a range of indices. The range is split evenly    *
+ *  between the workers, and a worker that runs out of work     *
+ *  steals half of the remaining range of another worker, so    *
+ *  uneven work (such as users with many followers) is still    *
+ *  balanced between all threads.                               *
+ *                                                              *
+ *  @file ThreadPool.h                                          *
+ *  @date October 14th, 2026                                    *
+ ***************************************************************/
+
+
+#ifndef CS315_PROJECT01_THREADPOOL_H
+#define CS315_PROJECT01_THREADPOOL_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <cstddef>
+
+
+class ThreadPool {
+public:
+    // ------------------------------------------------ Constructors ------------------------------------------------ //
+    // Creates a pool with numThreads threads (including the calling thread). 0 uses the hardware concurrency.
+    explicit ThreadPool(unsigned int numThreads = 0);
+
+    // The worker threads belong to a single pool, so it can not be copied
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Stops and joins all the worker threads
+    ~ThreadPool();
+
+
+    // ----------------------------------------------- Public Methods ----------------------------------------------- //
+    // Returns the number of threads that run a parallel for loop (including the calling thread)
+    unsigned int getNumThreads() const;
+
+    // Runs task(worker, i) for every i in [first, last), and returns once every task is done.
+    // worker is in [0, getNumThreads()), and no two tasks with the same worker run at the same time.
+    void parallelFor(std::size_t first, std::size_t last, std::size_t grainSize,
+                     const std::function<void(unsigned int worker, std::size_t i)>& task);
+
+    // Returns the number of threads to use when none is specified (the hardware concurrency, at least 1)
+    static unsigned int getDefaultNumThreads();
+
+private:
+    // The range of indices that has not been started yet by a single worker
+    struct WorkRange {
+        std::mutex lock;
+        std::size_t begin = 0;
+        std::size_t end = 0;
+    };
+
+    // -------------------------------------------- Private Data Members -------------------------------------------- //
+    unsigned int numThreads;
+    std::vector<std::thread> threads;
+    std::vector<std::unique_ptr<WorkRange>> ranges;
+
+    std::mutex jobLock;
+    std::condition_variable jobStarted;
+    std::condition_variable jobFinished;
+    const std::function<void(unsigned int, std::size_t)>* currentTask;
+    std::size_t currentGrainSize;
+    int currentStage;               // the profiler stage (see Profiler) of the thread that started the job
+    unsigned long long jobNumber;
+    unsigned int workersRunning;
+    bool stopping;
+
+    // -----------------------------------------  Private Helper Functions ------------------------------------------ //
+    // The main loop of a worker thread, waits for a job and then runs its share of it
+    void workerLoop(unsigned int worker);
+
+    // Runs tasks from the workers own range, stealing from other ranges once it is empty
+    void runTasks(unsigned int worker);
+
+    // Takes the next block of indices for a worker. Returns false once there is no work left anywhere.
+    bool takeWork(unsigned int worker, std::size_t& begin, std::size_t& end);
+};
+
+
+#endif //CS315_PROJECT01_THREADPOOL_H
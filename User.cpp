@@ -2,9 +2,8 @@
  *  Implementation of the User class                                     *
  *  @author Brandon Dale                                                 *
  *                                                                       *
- *  The primary use is to create a User given a string stream reference  *
- *  containing a JSON File array with the information for a SINGLE user  *
- *  (Everything between, but not including, the curly brackets).         *
+ *  The primary use is to hold the information for a SINGLE user of a   *
+ *  social network, as scanned from a JSON file by the UserScanner.      *
  *  The other main use is to create the individual HTML file for         *
  *  the profile page of the user object.                                 *
  *                                                                       *
@@ -14,19 +13,24 @@
 
 
 #include "User.h"
+#include "Stats.h"
 #include <cassert>
 #include <iostream>
-#include <fstream>
 #include <utility>
-#include <limits>
+#include <algorithm>
+#include <stdexcept>
 
 using namespace std;
 
+
+// The title of each list of a user page, in the order of OutputLayout::UserList
+static const char* const LIST_TITLES[OutputLayout::NUM_USER_LISTS] = {"Follows", "Followers", "Mutuals", "Suggested"};
+
 // -------------------------------------------------- CONSTRUCTORS -------------------------------------------------- //
 User::User() {
     /*  Default Constructor
      *  DO NOT USE WITH AN ACTUAL USER - Sets all values to empty strings
-     *  Note: The vector<string> follows data member is not set to anything here
+     *  Note: The follows span is left empty
      *
      *  Parameters:
      *      Takes no parameters.
@@ -37,13 +41,10 @@ User::User() {
     */
 
     id = 0;
-    name = "";
-    location = "";
-    pic_url = "";
 }
 
 
-User::User(unsigned int id, string name, string location, string pic_url, vector<unsigned int> follows) {
+User::User(unsigned int id, string_view name, string_view location, string_view pic_url, IdSpan follows) {
     /*
      *  A constructor for a User object, given all the user data values.
      *
@@ -51,22 +52,28 @@ User::User(unsigned int id, string name, string location, string pic_url, vector
      *      NO OTHER USER HAS THIS SAME ID.
      *          No error checking is done to ensure that two users do not have the same id
      *      The user's name is a non-empty string
+     *      The strings outlive the user object.
+     *          They are not copied. They are normally views into the StringPool of the SocialNetwork that the user
+     *          belongs to (so repeated strings are only stored once), or into the string table of a mapped snapshot.
+     *      The follows outlive the user object.
+     *          They are not copied either. They are normally a list in the IdArena of the SocialNetwork that the user
+     *          belongs to, or the follows list of the user in a mapped snapshot.
      *
      *  Parameters:
      *      unsigned int id:
      *          Represents a user's id number. ID MUST BE GREATER THAN 0 TO BE VALID
      *
-     *      string name:
+     *      string_view name:
      *          Represents a user's name. No error checking is done to ensure that it is not empty
      *
-     *      string location:
+     *      string_view location:
      *          Represents a user's location. Can be assigned to be empty
      *
-     *      string pic_url:
+     *      string_view pic_url:
      *          Represents a user's picture url. Can be assigned to be empty
      *          If this parameter is empty, it assigns it to be the default picture
      *
-     *      vector<unsigned int> follows:
+     *      IdSpan follows:
      *          Represents a 1D array of user IDs, represents the ids of the users that the current user follows
      *
      *  Returns:
@@ -75,60 +82,16 @@ User::User(unsigned int id, string name, string location, string pic_url, vector
      */
 
     this->id = id;
-    this->name = move(name);
-    this->location = move(location);
-    this->pic_url = move(pic_url);
-    this->follows = move(follows);
+    this->name = name;
+    this->location = location;
+    this->pic_url = pic_url;
+    this->follows = follows;
 
     // Set any default attributes if they are empty
     this->setDefaultAttributesWhenEmpty();
 }
 
 
-User::User(stringstream &ss) {
-    /*
-     *  Creates a user object given a pass-by-reference string stream of a JSON object array.
-     *
-     *  It makes the following assumptions:
-     *      1) The file "scraping" started and stopped at the correct points
-     *             - Meaning it took everything after (not including) the opening { and everything before (not including)
-     *               the closing }
-     *      2) The data contains at least the following data members, and that they are valid
-     *             a) id_str
-     *             b) name
-     *      3) There are no unexpected data types, if there are, an assertion will fail in the setAttribute method.
-     *
-     *  Parameters:
-     *      string stream& ss:
-     *          A string stream containing all the user's data in the following pattern ("attributeTitle" : "attributeData")
-     *          Is passed by reference only to avoid copying. The string stream is not used outside this constructor
-     *
-     *  Returns:
-     *      Returns nothing.
-     *
-     */
-
-    // While there are still attributes in the user JSON array
-    // NOTE: There are 3 cases for what the peek in the while statement below will output
-    //           1) The first item (which is guaranteed): peek will return a newline character
-    //           2) The "middle" items:                  peek will return a comma
-    //           3) The "last" item:                     peek will return a tab character
-
-    while (ss.good() && ss.peek() != '\t') {
-        // Get the attributes title and data and set it
-        string title = getAttributeTitle(ss);
-        string data = getAttributeData(ss);
-        setAttribute(title, data);
-
-        // Remove any whitespace before the next character. So peek can determine if user input is complete
-        ss.ignore();
-    }
-    ss.clear();
-
-    // Set any default attributes (currently only sets a default picture url)
-    this->setDefaultAttributesWhenEmpty();
-}
-
 // ---------------------------------------------- OPERATOR OVERLOADING ---------------------------------------------- //
 
 bool User::operator==(const User &other) const {
@@ -333,7 +296,7 @@ unsigned int User::getId() const {
     return this->id;
 }
 
-string User::getName() const {
+string_view User::getName() const {
     /*
      *  Returns the value of the user's name
      *  ASSERTS that the user is valid before returning anything
@@ -342,7 +305,7 @@ string User::getName() const {
      *      No parameters.
      *
      *  Returns:
-     *      string:
+     *      string_view:
      *          Returns the name of the current user object.
      *
      */
@@ -351,7 +314,7 @@ string User::getName() const {
     return this->name;
 }
 
-string User::getLocation() const {
+string_view User::getLocation() const {
     /*
      *  Returns the value of the user's location
      *  ASSERTS that the user is valid before returning anything
@@ -362,7 +325,7 @@ string User::getLocation() const {
      *      No parameters.
      *
      *  Returns:
-     *      string:
+     *      string_view:
      *          Returns the location of the current user object.
      *
      */
@@ -371,7 +334,7 @@ string User::getLocation() const {
     return this->location;
 }
 
-string User::getPicUrl() const {
+string_view User::getPicUrl() const {
     /*
      *  Returns the value of the user's pic_url
      *  ASSERTS that the user is valid before returning anything
@@ -383,7 +346,7 @@ string User::getPicUrl() const {
      *      No parameters.
      *
      *  Returns:
-     *      string:
+     *      string_view:
      *          Returns the pic_url of the current user object.
      *
      */
@@ -392,17 +355,21 @@ string User::getPicUrl() const {
     return this->pic_url;
 }
 
-vector<unsigned int> User::getFollows() const {
+IdSpan User::getFollows() const {
     /*
-     *  Returns a vector of unsigned ints which is a copy of the current user's follows vector
+     *  Returns a view of the current user's follows
      *  ASSERTS that the user is valid before returning anything
      *
+     *  The follows are not copied, and the elements can be read directly, without the user and index checks that
+     *  getFollowsIdAt does for each element. The view is valid for as long as the storage of the follows (see the
+     *  constructor), and until the follows of the user are changed.
+     *
      *  Parameters:
      *      No parameters.
      *
      *  Returns:
-     *      vector<unsigned int>:
-     *          A copy of the user's follows vector.
+     *      IdSpan:
+     *          The user's follows.
      *
      */
 
@@ -412,7 +379,7 @@ vector<unsigned int> User::getFollows() const {
 
 unsigned int User::getFollowsSize() const {
     /*
-     *  Returns the number of users that the current user follows (the size of the follows vector)
+     *  Returns the number of users that the current user follows (the size of the follows list)
      *  ASSERTS that the user is valid before returning anything
      *
      *  Parameters:
@@ -420,7 +387,7 @@ unsigned int User::getFollowsSize() const {
      *
      *  Returns:
      *      unsigned int:
-     *          The size of the follows vector
+     *          The size of the follows list
      *
      */
 
@@ -433,311 +400,371 @@ unsigned int User::getFollowsIdAt(const int &i) const {
      *  Returns the ID number of the user that the current user follows at a certain ID INDEX
      *
      *  ASSERTS that the user is valid before returning anything
-     *  While no direct error checking is done on the index parameter "i", the vector library should check if it is valid
-     *  and throw an error if it is not valid.
+     *  Throws an out_of_range error if the index parameter "i" is not valid (as the vector library did when the follows
+     *  were a vector).
      *
      *  Parameters:
      *      const unt& i:
-     *          The index value of a user in the follows vector
+     *          The index value of a user in the follows list
      *
      *  Returns:
      *      unsigned int:
-     *          The id of a user in the current user's follows vector
+     *          The id of a user in the current user's follows list
      *
      */
 
     assert(this->isValid());
-    return this->follows.at(i);
+    if (i < 0 || size_t(i) >= this->follows.size()) throw out_of_range("User::getFollowsIdAt");
+    return this->follows[i];
 }
 
-void User::generateUserHTMLProfilePage(const vector<string> &userNames, const vector<unsigned int> &followersIDs, const vector<unsigned int> &mutualIds) {
+void User::setName(string_view newName) {
     /*
-     *  Generates the HTML user page file for the current user object.
+     *  Changes the name of the user. The string is not copied, so it must outlive the user.
+     *  ASSERTS that the new name is not empty (so the user stays valid)
      *
      *  Parameters:
-     *      const vector<string>& userNames:
-     *          Holds all users names in the social network object that this user belongs to.
-     *          Used so that each user doesn't have access to every other user's information, on the name.
-     *      const vector<unsigned int>& followersIDs:
-     *          Holds all the user IDs for the users that follow the current user.
-     *      const vector<unsigned int>& mutualsIds:
-     *          Holds all the user IDs for the users that are mutuals with the current user.
+     *      string_view newName:
+     *          The new name of the user
      *
      *  Returns:
      *      Returns nothing.
-     *
      */
 
-    // Make sure that it is a valid user object
-    assert(this->isValid());
-
-    // Open the filestream
-    string filename = "user" + to_string(id) + ".html";
-    ofstream out;
-    out.open(filename);
-    assert(out.is_open());
-
-    // Create the HTML Page header
-    out << "<!DOCTYPE html>" << endl << "<html>" << endl << "<head>" << endl;
-    out << "<title>" << name << " Profile</title>" << endl << "</head>" << endl;
-
-    // Start the HTML Body
-    out << "<body>" << endl;
-    out << R"(<h2><a href="index.html">Social Network</a></h2>)" << endl;   // A button that links back to the index page for ease of testing
-
-    // Insert the users name and location
-    out << "<h1>" << name;
-    if (!this->location.empty()) out << " in " << location;
-    out << "</h1>" << endl;
-
-    // Insert the users profile picture (if it is specified)
-    if (!this->pic_url.empty())     out << R"(<img alt="Profile pic" src=")" << pic_url << R"(" />)" << endl;
-
-
-    // Create the unordered lists for follows, followers, and mutual users.
-    // ---------------- FOLLOWS ---------------- //
-    addHTMLUnorderedUserList(out, userNames, this->follows, "Follows");
-
-    // ---------------- FOLLOWERS ---------------- //
-    addHTMLUnorderedUserList(out, userNames, followersIDs, "Followers");
-
-    // ---------------- MUTUALS ---------------- //
-    addHTMLUnorderedUserList(out, userNames, mutualIds, "Mutuals");
-
-
-    // Add the closing tags and close the output file stream.
-    out << "</body>" << endl << "</html>";
-    out.close();
+    assert(!newName.empty());
+    this->name = newName;
 }
 
-
-// -------------------------------------------- PRIVATE HELPER METHODS ---------------------------------------------- //
-
-string User::getAttributeTitle(stringstream &inputLine) {
+void User::changeFollows(const vector<unsigned int>& removedIDs, const vector<unsigned int>& addedIDs,
+                         IdArena& arena) {
     /*
-     *  Returns a string of an attributes title in a string stream inputLine.
-     *
-     *  Note: The inputLine does not only contain a single line. It is a reference to the json array string stream
-     *        that contains all the user's data. Is named inputLine to make things easier to read
+     *  Removes every occurrence of some users from the follows list (keeping the order of the other follows), and then
+     *  adds other users to the end of it (the order that their follows appear in on the user's page)
+     *  ASSERTS that the ids of the added users are greater than 0
      *
-     *  Assumes the following:
-     *      1) The data in the line takes the following form
-     *             "title" : "data"
-     *      2) The first substring between the first pair of double quotation marks contains the title of an attribute
+     *  The follows may be shared with other storage, such as a mapped snapshot, so they are never changed in place. The
+     *  new list is copied into the arena, and the old list is left as it was (it is freed with its storage). All of the
+     *  changes of a batch are made with a single copy, so a batch of k changes to a list of d follows is O(d log k + k)
+     *  rather than O(k * d).
      *
      *  Parameters:
-     *      string stream& inputLine:
-     *          Contains a json array containing a user's data.
+     *      const vector<unsigned int>& removedIDs:
+     *          The sorted ids of the users that the current user no longer follows
      *
-     *  Returns:
-     *      string title:
-     *          Contains a non-escaped string with the title of an attribute.
+     *      const vector<unsigned int>& addedIDs:
+     *          The ids of the users that the current user now follows, in the order to add them
+     *
+     *      IdArena& arena:
+     *          The arena to store the new list in, which must outlive the user
      *
+     *  Returns:
+     *      Returns nothing.
      */
 
-    string title;
-
-    // Remove all characters up to (and including) the first occurring double quotation mark
-    inputLine.ignore(numeric_limits<streamsize>::max(), '"');
-
-    // Save the substring up to (BUT NOT INCLUDING) the second occurring double quotation mark
-    getline(inputLine, title, '"');
-
-    return title;
+    auto isRemoved = [&](unsigned int id) { return binary_search(removedIDs.begin(), removedIDs.end(), id); };
+    const size_t numKept = this->follows.size() - count_if(this->follows.begin(), this->follows.end(), isRemoved);
+    if (numKept == this->follows.size() && addedIDs.empty()) return;
 
+    unsigned int* followsCopy = arena.allocate(numKept + addedIDs.size());
+    unsigned int* copyEnd = remove_copy_if(this->follows.begin(), this->follows.end(), followsCopy, isRemoved);
+    for (unsigned int followedID : addedIDs) {
+        assert(followedID > 0);
+        *copyEnd++ = followedID;
+    }
+    this->follows = IdSpan(followsCopy, numKept + addedIDs.size());
 }
 
-std::string User::getAttributeData(stringstream &inputLine) {
+void User::generateUserHTMLProfilePage(PageBuffer& page, const NameTable& userNames,
+                                       const vector<unsigned int> &followersIDs, const vector<unsigned int> &mutualIds,
+                                       PageWriter* writer, const vector<unsigned int>* suggestedIds) const {
     /*
-     *  Extracts and returns the data string for a certain attribute, given a reference to the string stream containing
-     *  the json array object with a single user's information
+     *  Generates the HTML user page file for the current user object.
      *
-     *  Notes:
-     *      1) The inputLine does not only contain a single line. It is a reference to the json array string stream
-     *         that contains all the user's data. Is named inputLine to make things easier to read
-     *      2) If the data that is extracted is the follows vector, it will return a string of all id strings with the
-     *         double quotes still included. These will be processed out during the setAttribute method.
-     *
-     *  Assumes the following:
-     *      1) The data in the line takes the following form (not including parenthesis)
-     *             ("title" : "data")
-     *         Though, at the time that this method is run, it should be in this form (not including parenthesis)
-     *             ( : "data" )
-     *      2) The second substring between the second pair of double quotation marks contains the data of an attribute
+     *  The page is rendered into the page buffer, and then written to "userN.html" with a single write call, where N is
+     *  the ID of the user as written in the input file (from userNames). The file is in the directory that the layout
+     *  of userNames gives the user (next to index.html by default). If the layout has a page size, each list that is
+     *  longer than it continues on further pages (such as "userN_followers_2.html"), which are rendered into the same
+     *  buffer and written next to the page, one after the other.
      *
      *  Parameters:
-     *      string stream& inputLine:
-     *          Contains a json array containing a user's data.
+     *      PageBuffer& page:
+     *          A buffer to render the page into. Its previous contents are removed. Reusing the same buffer for many
+     *          pages avoids reallocating it.
+     *      const NameTable& userNames:
+     *          Holds all users names in the social network object that this user belongs to.
+     *          Used so that each user doesn't have access to every other user's information, on the name.
+     *      const vector<unsigned int>& followersIDs:
+     *          Holds all the user IDs for the users that follow the current user.
+     *      const vector<unsigned int>& mutualsIds:
+     *          Holds all the user IDs for the users that are mutuals with the current user.
+     *      PageWriter* writer:
+     *          The writer to create the file with, which keeps the directory of the previous page open. If it is
+     *          nullptr, the file is opened by its path.
+     *      const vector<unsigned int>* suggestedIds:
+     *          Holds the user IDs of the users suggested to the current user (best first), or nullptr to leave the
+     *          Suggested list off the page.
      *
      *  Returns:
-     *      string data:
-     *          Holds the string value of a user's attribute data
+     *      Returns nothing.
      *
      */
 
-    // Remove all leading characters between the attribute title and the start of the data string (including brackets or double quotes)
-    inputLine.ignore(numeric_limits<streamsize>::max(), ':');
-    inputLine.ignore();
-
-    // Remove the space after the colon and determine what the delimiter will be for the data string (will EITHER be " or ])
-    assert(inputLine.peek() == '"' || inputLine.peek() == '[');
-    char delimiter = static_cast<char>(inputLine.get());
-    if (delimiter == '[') delimiter = ']';
-
-    // Extract the data up until the delimiter
-    string data;
-    getline(inputLine, data, delimiter);
-
-    return data;
+    const OutputLayout& layout = userNames.getLayout();
+    const uint64_t externalID = userNames.getId(id - 1);
+    auto writePage = [&](const string& filename, const string& path) {
+        bool written = writer != nullptr ? writer->writePage(page, layout, externalID, filename)
+                                         : page.writeToFile(path);
+        if (!written) {
+            cerr << "COULD NOT WRITE THE USER PAGE " << path << endl;
+            exit(1);
+        }
+        Stats::add(Stats::PAGES_WRITTEN, 1);
+    };
+
+    // Render the page, and write it to its file
+    this->renderUserHTMLProfilePage(page, userNames, followersIDs, mutualIds, suggestedIds);
+    writePage(layout.getPageFilename(externalID), layout.getPagePath(externalID));
+
+    // Then the continuation pages of each list that does not fit on the page
+    const IdSpan lists[OutputLayout::NUM_USER_LISTS] = {this->follows, followersIDs, mutualIds,
+                                                        suggestedIds != nullptr ? IdSpan(*suggestedIds) : IdSpan()};
+    for (unsigned int list = 0; list < OutputLayout::NUM_USER_LISTS; list++) {
+        OutputLayout::UserList currList = static_cast<OutputLayout::UserList>(list);
+        size_t numPages = layout.getNumListPages(lists[list].size());
+        for (size_t pageNumber = 2; pageNumber <= numPages; pageNumber++) {
+            this->renderUserListPage(page, userNames, lists[list], currList, pageNumber);
+            writePage(layout.getListPageFilename(externalID, currList, pageNumber),
+                      layout.getListPagePath(externalID, currList, pageNumber));
+        }
+    }
 }
 
-void User::setAttribute(const std::string& title, std::string data) {
+void User::renderUserHTMLProfilePage(PageBuffer& page, const NameTable& userNames,
+                                     const vector<unsigned int> &followersIDs, const vector<unsigned int> &mutualIds,
+                                     const vector<unsigned int>* suggestedIds) const {
     /*
-     *  Sets the value of an attribute for the current user object, given the title of the attribute, and the string
-     *  data that it will be set to.
-     *
-     *  Even though not all attributes of a user are of type string, the necessary conversions will be automatically handled
+     *  Renders the HTML user page for the current user object into a page buffer (without writing any file).
      *
      *  Parameters:
-     *      const string& title:
-     *          the title of the attribute to be set
-     *      string data:
-     *          the data string to be set
+     *      PageBuffer& page:
+     *          The buffer to render the page into. Its previous contents are removed.
+     *      const NameTable& userNames:
+     *          Holds all users names in the social network object that this user belongs to.
+     *      const vector<unsigned int>& followersIDs:
+     *          Holds all the user IDs for the users that follow the current user.
+     *      const vector<unsigned int>& mutualsIds:
+     *          Holds all the user IDs for the users that are mutuals with the current user.
+     *      const vector<unsigned int>* suggestedIds:
+     *          Holds the user IDs of the users suggested to the current user (best first), or nullptr to leave the
+     *          Suggested list off the page.
      *
      *  Returns:
-     *      Returns nothing
+     *      Returns nothing.
      *
      */
 
-    // Make sure that there is a non-empty title
-    assert(!title.empty());
+    // Make sure that it is a valid user object
+    assert(this->isValid());
+    page.clear();
 
-    // This must come before the second assert statement as the follows data string can be empty
-    if (title == "follows") {
-        this->follows = stringArrayToUnsignedIntVector(data);
-        return;
-    }
+    // Create the HTML Page header
+    page.append("<!DOCTYPE html>\n<html>\n<head>\n");
+    page.append("<title>");
+    page.append(name);
+    page.append(" Profile</title>\n</head>\n");
 
-    // Make sure that the data string is not empty
-    assert(!data.empty());
+    // Start the HTML Body
+    page.append("<body>\n");
+    page.append(R"(<h2><a href=")");     // A button that links back to the index page for ease of testing
+    page.append(userNames.getLayout().getRootPrefix());
+    page.append(R"(index.html">Social Network</a></h2>)" "\n");
 
-    // Depending on the title, set the corresponding attribute
-    if (title == "id_str") {
-        this->id = stoi(data);
-        return;
-    }
-    if (title == "name") {
-        this->name = data;
-        return;
-    }
-    if (title == "pic_url") {
-        this->pic_url = data;
-        return;
+    // Insert the users name and location
+    page.append("<h1>");
+    page.append(name);
+    if (!this->location.empty()) {
+        page.append(" in ");
+        page.append(location);
     }
-    if (title == "location") {
-        this->location = data;
-        return;
+    page.append("</h1>\n");
+
+    // Insert the users profile picture (if it is specified)
+    if (!this->pic_url.empty()) {
+        page.append(R"(<img alt="Profile pic" src=")");
+        page.append(pic_url);
+        page.append(R"(" />)" "\n");
     }
 
-    // If title does not match any of the options above, the title is invalid
-    cerr << "COULD NOT SET ATTRIBUTE - " << title << " - IS NOT A RECOGNIZED USER ATTRIBUTE TYPE" << endl;
-    exit(1);
+
+    // Create the unordered lists for follows, followers, and mutual users.
+    // ---------------- FOLLOWS ---------------- //
+    addHTMLUnorderedUserList(page, userNames, this->follows, OutputLayout::FOLLOWS);
+
+    // ---------------- FOLLOWERS ---------------- //
+    addHTMLUnorderedUserList(page, userNames, followersIDs, OutputLayout::FOLLOWERS);
+
+    // ---------------- MUTUALS ---------------- //
+    addHTMLUnorderedUserList(page, userNames, mutualIds, OutputLayout::MUTUALS);
+
+    // ---------------- SUGGESTED ---------------- //
+    if (suggestedIds != nullptr) addHTMLUnorderedUserList(page, userNames, *suggestedIds, OutputLayout::SUGGESTED);
+
+
+    // Add the closing tags
+    page.append("</body>\n</html>");
 }
 
-vector<unsigned int> User::stringArrayToUnsignedIntVector(string &arrayString) {
+
+// -------------------------------------------- PRIVATE HELPER METHODS ---------------------------------------------- //
+
+void User::renderUserListPage(PageBuffer& page, const NameTable& userNames, IdSpan otherIDsList,
+                              OutputLayout::UserList list, size_t pageNumber) const {
     /*
-     *  Converts a string of unsigned integer strings into a vector or unsigned integers.
-     *
-     *  Makes the following assumptions:
-     *      1) Each sub string of integers are >= 0 and are less than the maximum value of an unsigned integer.
-     *         Though if a value is 0, it is an invalid user id.
-     *      2) Each sub string only contains digits.
-     *
-     *  NOTES:
-     *      1) The current implementation does not set the size of the vector before populating it, so a great deal of
-     *         resizing is occurring. It may be faster to preset the size of the vector to increase performance.
-     *      2) The current implementation uses the stoi method. This may cause a narrowing issue as all IDs (which are
-     *         being converted here) are unsigned ints.
+     *  Renders a continuation page of one of the lists of the current user into a page buffer (without writing any
+     *  file). The page holds the users of that page of the list, and links back to the page of the user, and to the
+     *  previous and next pages of the list.
+     *  ASSERTS that the list has a page with that number, after the first
      *
      *  Parameters:
-     *      string& arrayString:
-     *          A string containing non-escaped integers in the following form (not including the parenthesis):
-     *              ("1","2","3"...,"n")
+     *      PageBuffer& page:
+     *          The buffer to render the page into. Its previous contents are removed.
+     *      const NameTable& userNames:
+     *          Holds all users names in the social network object that this user belongs to.
+     *      IdSpan otherIDsList:
+     *          The whole list, of which only the users of this page are rendered.
+     *      OutputLayout::UserList list:
+     *          Which list of the user it is (the follows, followers or mutuals).
+     *      size_t pageNumber:
+     *          The 1-based number of the page of the list.
      *
      *  Returns:
-     *      vector<unsigned int> arr:
-     *          A vector of user IDs
+     *      Returns nothing.
      *
      */
 
-    vector<unsigned int> arr;
-
-    // Create a string stream to process to array string
-    stringstream arraySS;
-    arraySS.str(arrayString);
-
-    string val_str;
-    while (arraySS.peek() == ',' || arraySS.peek() == '"') {
-
-        arraySS.ignore(numeric_limits<streamsize>::max(), '"');
-        getline(arraySS, val_str, '"'); // Extract the number from the SS
-        arr.push_back(stoi(val_str)); // Push the integer into the array      NOTE: possible narrowing of conversion
-
+    const OutputLayout& layout = userNames.getLayout();
+    const uint64_t externalID = userNames.getId(id - 1);
+    const size_t numPages = layout.getNumListPages(otherIDsList.size());
+    assert(this->isValid() && pageNumber >= 2 && pageNumber <= numPages);
+    page.clear();
+
+    // Create the HTML Page header, naming the list and the page
+    page.append("<!DOCTYPE html>\n<html>\n<head>\n");
+    page.append("<title>");
+    page.append(name);
+    page.append(" ");
+    page.append(LIST_TITLES[list]);
+    page.append(" (page ");
+    page.append(pageNumber);
+    page.append(" of ");
+    page.append(numPages);
+    page.append(")</title>\n</head>\n");
+
+    // Start the HTML Body, with links back to the index page and to the page of the user
+    page.append("<body>\n");
+    page.append(R"(<h2><a href=")");
+    page.append(layout.getRootPrefix());
+    page.append(R"(index.html">Social Network</a></h2>)" "\n");
+    page.append(R"(<h1><a href=")");
+    page.append(layout.getPageFilename(externalID));
+    page.append(R"(">)");
+    page.append(name);
+    page.append("</a></h1>\n");
+
+    // Insert the users of this page of the list
+    page.append("<h2>");
+    page.append(LIST_TITLES[list]);
+    page.append(" (page ");
+    page.append(pageNumber);
+    page.append(" of ");
+    page.append(numPages);
+    page.append(")</h2>\n<ul>\n");
+    const size_t first = (pageNumber - 1) * layout.getListPageSize();
+    const size_t last = min(first + layout.getListPageSize(), otherIDsList.size());
+    for (size_t i = first; i < last; i++) {
+        userNames.appendLink(page, otherIDsList[i] - 1);
     }
+    page.append("</ul>\n");
+
+    // Link to the previous page (the page of the user, for the second page) and the next page of the list
+    page.append(R"(<p><a href=")");
+    page.append(pageNumber == 2 ? layout.getPageFilename(externalID)
+                                : layout.getListPageFilename(externalID, list, pageNumber - 1));
+    page.append(R"(">Previous</a>)");
+    if (pageNumber < numPages) {
+        page.append(R"( <a href=")");
+        page.append(layout.getListPageFilename(externalID, list, pageNumber + 1));
+        page.append(R"(">Next</a>)");
+    }
+    page.append("</p>\n");
 
-    return arr;
+    // Add the closing tags
+    page.append("</body>\n</html>");
 }
 
-void User::addHTMLUnorderedUserList(ofstream& out, const vector<string> &userNames, const vector<unsigned int> &otherIDsList, const string &listTitle) {
+void User::addHTMLUnorderedUserList(PageBuffer& page, const NameTable& userNames,
+                                    IdSpan otherIDsList, OutputLayout::UserList list) const {
     /*
-     *  Adds an unordered list of links to users specified by otherIDsList to the output file stream out.
+     *  Adds an unordered list of links to users specified by otherIDsList to the end of a page buffer.
      *
-     *  Makes the following assumptions:
-     *      1) The listTitle is valid (is "Follows", "Followers", or "Mutuals")
-     *         Since all uses of this method are hardcoded and this is a private method, this should not present any issues.
+     *  If the layout of userNames has a page size and the list is longer than it, only the first page of the list is
+     *  added, followed by a link to the continuation page with the rest of it (see renderUserListPage).
      *
      *  Parameters:
-     *      ofstream& out:
-     *          an output filestream for the User's HTML user page.
+     *      PageBuffer& page:
+     *          The buffer that the User's HTML user page is being rendered into.
      *
-     *      const vector<string>& userNames:
-     *          A vector containing all the names of all users in the Social Network object that the current user belongs to.
+     *      const NameTable& userNames:
+     *          A table containing all the names of all users in the Social Network object that the current user belongs to.
      *
-     *      const vector<unsigned int>& otherIDsList:
-     *          A vector containing users IDs, these are printed as links to that users HTML page.
+     *      IdSpan otherIDsList:
+     *          A list of users IDs, these are printed as links to that users HTML page (named by the ID of
+     *          the user in the input file, from userNames).
      *
-     *      const string& listTitle:
-     *          The title of the unordered list to be created.
+     *      OutputLayout::UserList list:
+     *          Which list it is (the follows, followers, mutuals or suggested), which gives its title.
      *
      *  Returns:
      *      Returns nothing.
      *
      */
 
-    // Make sure that the output file stream is still open
-    assert(out.is_open());
-
     // Insert the title of the unordered list
-    out << "<h2>" << listTitle  << "</h2>" << endl;
+    page.append("<h2>");
+    page.append(LIST_TITLES[list]);
+    page.append("</h2>\n");
 
     // If the list of IDs to use is NOT empty, create the unordered list
     if (!otherIDsList.empty()) {
-        out << "<ul>" << endl;
-
-        // For each user specified in otherIDsList, create a list element with a link to their profile page
-        for (const unsigned int& otherID : otherIDsList) {
-            const string& otherUserName = userNames.at(otherID - 1);
-            out << R"(<li><a href="user)" << otherID << R"(.html">)";
-            out << otherUserName << "</a></li>" << endl;
+        const OutputLayout& layout = userNames.getLayout();
+        const bool continues = layout.getNumListPages(otherIDsList.size()) > 1;
+        const size_t numShown = continues ? layout.getListPageSize() : otherIDsList.size();
+        page.append("<ul>\n");
+
+        // For each user specified in otherIDsList (on the first page), add the list element with a link to their
+        // profile page (which is copied from the link table of userNames, if it has one)
+        for (size_t i = 0; i < numShown; i++) {
+            userNames.appendLink(page, otherIDsList[i] - 1);
         }
 
-        out << "</ul>" << endl;
+        page.append("</ul>\n");
+
+        // Link to the rest of the list, if it does not fit on this page
+        if (continues) {
+            page.append(R"(<p><a href=")");
+            page.append(layout.getListPageFilename(userNames.getId(id - 1), list, 2));
+            page.append(R"(">More )");
+            page.append(LIST_TITLES[list]);
+            page.append(" (");
+            page.append(otherIDsList.size());
+            page.append(" in total)</a></p>\n");
+        }
     }
 
 
     // Otherwise, create a note that it is empty
     else {
-        out << "<p>None</p>" << endl;
+        page.append("<p>None</p>\n");
     }
 }
 
@@ -746,7 +773,8 @@ void User::setDefaultAttributesWhenEmpty() {
      *  Sets any private data members that have a specified default value to that default value if that data member is the
      *  not-specified.
      *
-     *  Currently, this only applies to a User's pic_url.
+     *  Currently, this only applies to a User's pic_url. The default picture url is a string literal, so every user
+     *  without a picture shares the same (static) copy of it.
      *
      *  Parameters:
      *      No parameters.
@@ -14,9 +14,15 @@
 #define CS315_PROJECT01_USER_H
 
 #include <string>
+#include <string_view>
 #include <vector>
-#include <sstream>
-#include <fstream>
+#include <cstddef>
+#include "PageBuffer.h"
+#include "NameTable.h"
+#include "PageWriter.h"
+#include "OutputLayout.h"
+#include "IdSpan.h"
+#include "IdArena.h"
 
 
 class User {
@@ -25,11 +31,10 @@ public:
     // Default Constructor, Sets all values to Empty or 0
     User();
 
-    // Sets all values to the parameter values
-    User(unsigned int id, std::string name, std::string location, std::string pic_url, std::vector<unsigned int> follows);
+    // Sets all values to the parameter values. The strings and follows are not copied, so they must outlive the user
+    // (they are normally views into the StringPool and IdArena of a SocialNetwork, or into a mapped snapshot).
+    User(unsigned int id, std::string_view name, std::string_view location, std::string_view pic_url, IdSpan follows);
 
-    // MAIN CONSTRUCTOR - Creates a user object given a pass-by-reference string stream of a JSON object array.
-    explicit User(std::stringstream& ss);
 
     // -------------------------------------------- Operator Overloading -------------------------------------------- //
     bool operator ==(const User& other) const;
@@ -48,55 +53,65 @@ public:
     unsigned int getId() const;
 
     // Returns the name of the user
-    std::string getName() const;
+    std::string_view getName() const;
 
     // Returns the location of the user
-    std::string getLocation() const;
+    std::string_view getLocation() const;
 
     // Returns the picture url of the user
-    std::string getPicUrl() const;
+    std::string_view getPicUrl() const;
 
-    // Returns a vector of unsigned ints which is a copy of the current user's follows vector
-    std::vector<unsigned int> getFollows() const;
+    // Returns a view of the current user's follows (nothing is copied). Loops over every follow should use this rather
+    // than getFollowsIdAt, which checks the user and the index on every call.
+    IdSpan getFollows() const;
 
-    // Returns the number of users that the current user follows (the size of the follows vector)
+    // Returns the number of users that the current user follows (the size of the follows list)
     unsigned int getFollowsSize() const;
 
     //Returns the ID number of the user that the current user follows at a certain ID INDEX
     unsigned int getFollowsIdAt(const int& i) const;
 
-    // Generates the HTML user page file for the current user object.
-    void generateUserHTMLProfilePage(const std::vector<std::string>& userNames = {},
-                                    const std::vector<unsigned int>& followersIDs = {},
-                                     const std::vector<unsigned int>& mutualIds = {});
+    // Changes the name of the user. The string is not copied, so it must outlive the user (as in the constructor).
+    void setName(std::string_view newName);
+
+    // Removes every occurrence of the users in removedIDs (sorted) from the follows list, and then adds addedIDs to its
+    // end. The new list is stored in arena once (the old one is not changed).
+    void changeFollows(const std::vector<unsigned int>& removedIDs, const std::vector<unsigned int>& addedIDs,
+                       IdArena& arena);
+
+    // Generates the HTML user page file for the current user object, using page as the buffer to render it into. The
+    // page has a Suggested list only if suggestedIds is not nullptr.
+    void generateUserHTMLProfilePage(PageBuffer& page, const NameTable& userNames = NameTable(),
+                                     const std::vector<unsigned int>& followersIDs = {},
+                                     const std::vector<unsigned int>& mutualIds = {},
+                                     PageWriter* writer = nullptr,
+                                     const std::vector<unsigned int>* suggestedIds = nullptr) const;
+
+    // Renders the HTML user page for the current user object into page, without writing it to a file. The page has a
+    // Suggested list only if suggestedIds is not nullptr.
+    void renderUserHTMLProfilePage(PageBuffer& page, const NameTable& userNames = NameTable(),
+                                   const std::vector<unsigned int>& followersIDs = {},
+                                   const std::vector<unsigned int>& mutualIds = {},
+                                   const std::vector<unsigned int>* suggestedIds = nullptr) const;
 
 
 private:
     // -------------------------------------------- Private Data Members -------------------------------------------- //
     unsigned int id;
-    std::string name;
-    std::string location;
-    std::string pic_url;
-    std::vector<unsigned int> follows;
+    std::string_view name;
+    std::string_view location;
+    std::string_view pic_url;
+    IdSpan follows;
 
     // -----------------------------------------  Private Helper Functions ------------------------------------------ //
-    // Returns a string of an attributes title in a string stream inputLine.
-    static std::string getAttributeTitle(std::stringstream& inputLine);
-
-    // Extracts and returns the data string for a certain attribute, given a reference to the string stream containing
-    // the json array object with a single user's information
-    static std::string getAttributeData(std::stringstream& inputLine);
-
-    // Sets the value of an attribute for the current user object, given the title of the attribute, and the string
-    // data that it will be set to.
-    void setAttribute(const std::string& title, std::string data);
-
-    // Converts a string of unsigned integer strings into a vector or unsigned integers.
-    static std::vector<unsigned int> stringArrayToUnsignedIntVector(std::string& stringArray);
-
-    // Adds an unordered list of links to users specified by otherIDsList to the output file stream out.
-    static void addHTMLUnorderedUserList(std::ofstream& out, const std::vector<std::string>& userNames,
-                                  const std::vector<unsigned int>& otherIDsList,const std::string& listTitle);
+    // Renders a continuation page (pageNumber 2 or more) of one of the lists of the current user into page
+    void renderUserListPage(PageBuffer& page, const NameTable& userNames, IdSpan otherIDsList,
+                            OutputLayout::UserList list, std::size_t pageNumber) const;
+
+    // Adds an unordered list of links to users specified by otherIDsList to the end of the page buffer (only its first
+    // page, and a link to the rest, if it is longer than a page of the layout of userNames).
+    void addHTMLUnorderedUserList(PageBuffer& page, const NameTable& userNames, IdSpan otherIDsList,
+                                  OutputLayout::UserList list) const;
 
     // Sets any private data members that have a specified default value to that default value if that data member is the
     // not-specified.
@@ -0,0 +1,178 @@
+/** ****************************************************************
+ *  Implementation of the UserOrdering class                       *
+ *  @author Brandon Dale                                           *
+ *                                                                 *
+ *  @file UserOrdering.cpp                                         *
+ *  @date October 14th, 2026                                       *
+ ******************************************************************/
+
+
+#include "UserOrdering.h"
+#include "AdjacencyIndex.h"
+#include <algorithm>
+#include <numeric>
+#include <cassert>
+
+using namespace std;
+
+
+// ------------------------------------------------ PUBLIC METHODS -------------------------------------------------- //
+
+vector<unsigned int> UserOrdering::findNewIndices(Method method, const AdjacencyIndex& followsIndex,
+                                                  const AdjacencyIndex& followersIndex) {
+    /*
+     *  Orders the users of a network by a method, and numbers them in that order
+     *  ASSERTS that both indices have the same number of users
+     *
+     *  Parameters:
+     *      Method method:
+     *          The way to order the users
+     *
+     *      const AdjacencyIndex& followsIndex:
+     *          The follows index of the network
+     *
+     *      const AdjacencyIndex& followersIndex:
+     *          The followers index of the network (the transpose of followsIndex)
+     *
+     *  Returns:
+     *      vector<unsigned int>:
+     *          The new 0-based index of the user with each current index
+     */
+
+    assert(followsIndex.getNumVertices() == followersIndex.getNumVertices());
+    const unsigned int numUsers = followsIndex.getNumVertices();
+    vector<unsigned int> order;
+    if (method == BFS || method == RCM) {
+        order = searchOrder(followsIndex, followersIndex, method == RCM);
+        if (method == RCM) reverse(order.begin(), order.end());
+    }
+    else {
+        order.resize(numUsers);
+        iota(order.begin(), order.end(), 0u);
+        if (method == DEGREE) {
+            auto degree = [&](unsigned int user) {
+                return size_t(followsIndex.getDegree(user)) + followersIndex.getDegree(user);
+            };
+            stable_sort(order.begin(), order.end(), [&](unsigned int a, unsigned int b) {
+                return degree(a) > degree(b);
+            });
+        }
+    }
+
+    vector<unsigned int> newIndices(numUsers);
+    for (unsigned int position = 0; position < numUsers; position++) newIndices[order[position]] = position;
+    return newIndices;
+}
+
+bool UserOrdering::parse(const string& name, Method& method) {
+    /*
+     *  Finds the method with a name
+     *
+     *  Parameters:
+     *      const string& name:
+     *          The name of the method, as returned by getName
+     *
+     *      Method& method:
+     *          Set to the method, if there is one with the name
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if there is a method with the name.
+     *          Otherwise, returns false.
+     */
+
+    for (Method candidate : {ID, BFS, RCM, DEGREE}) {
+        if (name == getName(candidate)) {
+            method = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* UserOrdering::getName(Method method) {
+    /*
+     *  Returns the name of a method
+     *
+     *  Parameters:
+     *      Method method:
+     *          The method
+     *
+     *  Returns:
+     *      const char*:
+     *          "id", "bfs", "rcm" or "degree"
+     */
+
+    switch (method) {
+        case BFS: return "bfs";
+        case RCM: return "rcm";
+        case DEGREE: return "degree";
+        default: return "id";
+    }
+}
+
+
+// -------------------------------------------- PRIVATE HELPER METHODS ---------------------------------------------- //
+
+vector<unsigned int> UserOrdering::searchOrder(const AdjacencyIndex& followsIndex,
+                                               const AdjacencyIndex& followersIndex, bool cuthillMcKee) {
+    /*
+     *  Orders the users by a breadth first search over the follows in both directions. The order holds every user
+     *  visited so far, so it is also the queue of the search. A plain search starts from each user that was not
+     *  reached yet in index order, and visits the users that a user follows and then their followers (each row in
+     *  index order). Cuthill-McKee starts each search from the unreached user with the fewest connections, and visits
+     *  the neighbors of a user from the fewest connections to the most.
+     *
+     *  Parameters:
+     *      const AdjacencyIndex& followsIndex:
+     *          The follows index of the network
+     *
+     *      const AdjacencyIndex& followersIndex:
+     *          The followers index of the network (the transpose of followsIndex)
+     *
+     *      bool cuthillMcKee:
+     *          Whether to order the starts and the neighbors by their number of connections
+     *
+     *  Returns:
+     *      vector<unsigned int>:
+     *          The index of every user, in the order they were visited
+     */
+
+    const unsigned int numUsers = followsIndex.getNumVertices();
+    auto degree = [&](unsigned int user) {
+        return size_t(followsIndex.getDegree(user)) + followersIndex.getDegree(user);
+    };
+    auto fewerConnections = [&](unsigned int a, unsigned int b) {
+        return degree(a) < degree(b) || (degree(a) == degree(b) && a < b);
+    };
+
+    // The users to start each search from, in the order that they are tried
+    vector<unsigned int> starts(numUsers);
+    iota(starts.begin(), starts.end(), 0u);
+    if (cuthillMcKee) sort(starts.begin(), starts.end(), fewerConnections);
+
+    vector<bool> visited(numUsers, false);
+    vector<unsigned int> order;
+    order.reserve(numUsers);
+    for (unsigned int start : starts) {
+        if (visited[start]) continue;
+        visited[start] = true;
+        order.push_back(start);
+
+        for (size_t next = order.size() - 1; next < order.size(); next++) {
+            const unsigned int user = order[next];
+            const size_t firstNeighbor = order.size();
+            for (const AdjacencyIndex* index : {&followsIndex, &followersIndex}) {
+                for (const unsigned int* it = index->rowBegin(user); it != index->rowEnd(user); it++) {
+                    if (visited[*it]) continue;
+                    visited[*it] = true;
+                    order.push_back(*it);
+                }
+            }
+            if (cuthillMcKee) sort(order.begin() + firstNeighbor, order.end(), fewerConnections);
+        }
+    }
+
+    assert(order.size() == numUsers);
+    return order;
+}
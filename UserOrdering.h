@@ -0,0 +1,64 @@
+/** *************************************************************
+ *  Declaration of the UserOrdering class                       *
+ *  @author Brandon Dale                                        *
+ *                                                              *
+ *  Finds a new order of the users of a network which puts      *
+ *  users that are connected near each other, so a traversal of *
+ *  the follows of a user touches fewer cache lines. The users  *
+ *  can be ordered by a breadth first search (BFS), by reverse  *
+ *  Cuthill-McKee (RCM, a BFS that visits the neighbors with    *
+ *  the fewest connections first, reversed), or by degree (the  *
+ *  users with the most follows and followers first). Follows   *
+ *  count in both directions.                                   *
+ *                                                              *
+ *  The order only relabels the 0-based indices of a copy of    *
+ *  the indices (see AdjacencyIndex::relabeled). The IDs in the *
+ *  input file, which pages are named by, do not change.        *
+ *                                                              *
+ *  @file UserOrdering.h                                        *
+ *  @date October 14th, 2026                                    *
+ ***************************************************************/
+
+
+#ifndef CS315_PROJECT01_USERORDERING_H
+#define CS315_PROJECT01_USERORDERING_H
+
+#include <string>
+#include <vector>
+
+class AdjacencyIndex;
+
+
+class UserOrdering {
+public:
+    // The ways to order the users
+    enum Method {
+        ID,         // the order of the IDs (nothing is relabeled)
+        BFS,        // breadth first search, starting from each user not reached yet in ID order
+        RCM,        // reverse Cuthill-McKee, starting each search from the user with the fewest connections
+        DEGREE      // the most follows and followers first, with ties in ID order
+    };
+
+    // ----------------------------------------------- Public Methods ----------------------------------------------- //
+    // Returns the new 0-based index of every user (by their current index) in the order of a method, given the follows
+    // index of a network and the transpose of it
+    static std::vector<unsigned int> findNewIndices(Method method, const AdjacencyIndex& followsIndex,
+                                                    const AdjacencyIndex& followersIndex);
+
+    // Sets method to the method with a name ("id", "bfs", "rcm" or "degree"). Returns false if there is no such method.
+    static bool parse(const std::string& name, Method& method);
+
+    // Returns the name of a method
+    static const char* getName(Method method);
+
+private:
+    // -----------------------------------------  Private Helper Functions ------------------------------------------ //
+    // Returns every user in the order that a breadth first search over the follows in both directions visits them.
+    // With cuthillMcKee, each search starts from the user with the fewest connections, and visits the neighbors of a
+    // user by their number of connections.
+    static std::vector<unsigned int> searchOrder(const AdjacencyIndex& followsIndex,
+                                                 const AdjacencyIndex& followersIndex, bool cuthillMcKee);
+};
+
+
+#endif //CS315_PROJECT01_USERORDERING_H
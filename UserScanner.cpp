@@ -0,0 +1,419 @@
+/** ****************************************************************
+ *  Implementation of the UserScanner class                        *
+ *  @author Brandon Dale                                           *
+ *                                                                 *
+ *  Scans the text of a "special" JSON users file exactly once,    *
+ *  extracting each user object's attributes as string_views and   *
+ *  parsing ids with from_chars.                                   *
+ *                                                                 *
+ *  Since this is not going to be widely used, the scanner makes   *
+ *  the same assumptions as the rest of the project:               *
+ *      1) It is a valid JSON file                                 *
+ *      2) Users will not have any attributes other than           *
+ *         id_str, name, location, pic_url and follows             *
+ *      3) There will not be any escaped characters within the     *
+ *         user data strings                                       *
+ *                                                                 *
+ *  @file UserScanner.cpp                                          *
+ *  @date October 14th, 2026                                       *
+ ******************************************************************/
+
+
+#include "UserScanner.h"
+#include <iostream>
+#include <cstring>
+#include <charconv>
+#include <algorithm>
+#include <numeric>
+
+using namespace std;
+
+
+// -------------------------------------------------- CONSTRUCTORS -------------------------------------------------- //
+
+UserScanner::UserScanner(string_view text) {
+    /*
+     *  Creates a scanner over the full text of a JSON users file. The text must stay alive for as long as the scanner,
+     *  and the fields that it extracts, are used.
+     *
+     *  Parameters:
+     *      string_view text:
+     *          The text of the whole JSON file (For example: the contents of a MappedFile)
+     *
+     *  Returns:
+     *      No return value, creates a UserScanner object
+     */
+
+    begin = text.data();
+    pos = text.data();
+    end = text.data() + text.size();
+    inUserArray = false;
+    finished = false;
+    isChunk = false;
+}
+
+UserScanner::UserScanner(string_view text, string_view chunk) {
+    /*
+     *  Creates a scanner over a single chunk of the users array, as returned by splitUserArray. It extracts the user
+     *  objects of that chunk only, and finishes at the end of the chunk. Byte offsets (such as in error messages) are
+     *  still counted from the start of the whole text.
+     *
+     *  Parameters:
+     *      string_view text:
+     *          The text of the whole JSON file
+     *
+     *      string_view chunk:
+     *          A chunk of text, as returned by splitUserArray(text, ...)
+     *
+     *  Returns:
+     *      No return value, creates a UserScanner object
+     */
+
+    begin = text.data();
+    pos = chunk.data();
+    end = chunk.data() + chunk.size();
+    inUserArray = true;
+    finished = false;
+    isChunk = true;
+}
+
+
+// ------------------------------------------------ PUBLIC METHODS -------------------------------------------------- //
+
+bool UserScanner::nextUser(UserFields& fields) {
+    /*
+     *  Extracts the next user object of the users array into fields.
+     *
+     *  The first call moves past everything before the start of the users array, marked by the first (and only) open
+     *  bracket '['. Each call then scans a single {...} object, setting the field of every attribute it finds. Any
+     *  attribute that is not given in the object is left empty (or 0 for the id).
+     *
+     *  Parameters:
+     *      UserFields& fields:
+     *          The fields to fill in. The follows vector is cleared, but keeps its capacity, so passing the same fields
+     *          object for every user avoids reallocating it.
+     *
+     *  Returns:
+     *      bool:
+     *          Returns true if a user was extracted.
+     *          Returns false once the end of the users array is reached.
+     */
+
+    if (finished) return false;
+
+    // Move to the first user object, or past the comma separating it from the previous one
+    if (!inUserArray) {
+        const char* arrayStart = static_cast<const char*>(memchr(pos, '[', end - pos));
+        if (arrayStart == nullptr) malformed("could not find the start of the users array");
+        pos = arrayStart + 1;
+        inUserArray = true;
+        skipWhitespace();
+    }
+    else {
+        skipWhitespace();
+        if (pos < end && *pos == ',') pos++;
+        skipWhitespace();
+    }
+
+    // Check if this is the end of the chunk, or of the users array
+    if (isChunk && pos == end) {
+        finished = true;
+        return false;
+    }
+    if (pos < end && *pos == ']') {
+        pos++;
+        finished = true;
+        return false;
+    }
+
+    // Reset the fields for the new user
+    fields.id = 0;
+    fields.name = string_view();
+    fields.location = string_view();
+    fields.pic_url = string_view();
+    fields.follows.clear();
+
+    expect('{');
+    skipWhitespace();
+    if (pos < end && *pos == '}') {
+        pos++;
+        return true;
+    }
+
+    // While there are still attributes in the user object
+    while (true) {
+        // Get the attribute's title and set its data
+        string_view title = readString();
+        expect(':');
+        skipWhitespace();
+
+        if (title == "follows") {
+            readUnsignedIntArray(fields.follows);
+        }
+        else if (title == "id_str") {
+            fields.id = readUnsignedInt();
+        }
+        else if (title == "name") {
+            fields.name = readString();
+        }
+        else if (title == "pic_url") {
+            fields.pic_url = readString();
+        }
+        else if (title == "location") {
+            fields.location = readString();
+        }
+        else {
+            // If title does not match any of the options above, the title is invalid
+            cerr << "COULD NOT SET ATTRIBUTE - " << title << " - IS NOT A RECOGNIZED USER ATTRIBUTE TYPE" << endl;
+            exit(1);
+        }
+
+        // Either there is another attribute (marked by a comma) or it is the end of the user object
+        skipWhitespace();
+        if (pos < end && *pos == ',') {
+            pos++;
+            continue;
+        }
+        expect('}');
+        break;
+    }
+
+    return true;
+}
+
+size_t UserScanner::getBytesScanned() const {
+    /*
+     *  Returns the number of bytes of the text that have been scanned so far
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      size_t:
+     *          The number of bytes between the start of the text and the current scanning position
+     */
+
+    return pos - begin;
+}
+
+
+vector<string_view> UserScanner::splitUserArray(string_view text, unsigned int numChunks, ThreadPool& pool) {
+    /*
+     *  Splits the users array of a JSON users file into chunks that can be scanned on their own, so that the users can
+     *  be extracted in parallel.
+     *
+     *  The text after the start of the users array is split into numChunks roughly equal parts. Each split point is
+     *  then moved forward to the start of the next user object, found as a '}' followed by a ',' and a '{' (with only
+     *  whitespace between them) that are not inside a string, since a name or location may well hold "}, {". The
+     *  strings have no escapes, so a position is inside a string exactly when an odd number of '"' come before it: the
+     *  quotes of each part are counted on the pool, and a prefix sum of the counts gives whether each split point
+     *  starts inside a string. Since the user objects do not nest, a boundary outside every string is the boundary
+     *  between two objects, so the chunks (and whether the file is accepted) do not depend on the number of chunks.
+     *  The first chunk starts just after the '[', each other chunk starts at the '{' of a user object, and every chunk
+     *  ends where the next one starts, so the last chunk holds the end of the array.
+     *
+     *  Parameters:
+     *      string_view text:
+     *          The text of the whole JSON file
+     *
+     *      unsigned int numChunks:
+     *          The maximum number of chunks to split the array into. Fewer are returned if the array has fewer objects.
+     *
+     *      ThreadPool& pool:
+     *          The pool to count the quotes of the parts on
+     *
+     *  Returns:
+     *      vector<string_view>:
+     *          The chunks, in order. Empty if the text has no users array (which scanning the whole text with a single
+     *          scanner reports as an error).
+     */
+
+    size_t arrayStart = text.find('[');
+    if (arrayStart == string_view::npos) return {};
+    numChunks = max(numChunks, 1u);
+
+    auto isWhitespace = [](char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; };
+
+    // Finds the '{' of the first user object that starts at or after from, or returns npos if there is none. inString
+    // is whether from is inside a string.
+    auto findObjectStart = [&](size_t from, bool inString) -> size_t {
+        size_t next = text.find_first_of("\"}", from);
+        while (next != string_view::npos) {
+            const size_t found = next;
+            if (text[found] == '"') inString = !inString;
+            else if (!inString) {
+                next = found + 1;
+                while (next < text.size() && isWhitespace(text[next])) next++;
+                if (next < text.size() && text[next] == ',') {
+                    next++;
+                    while (next < text.size() && isWhitespace(text[next])) next++;
+                    if (next < text.size() && text[next] == '{') return next;
+                }
+            }
+            next = text.find_first_of("\"}", found + 1);
+        }
+        return string_view::npos;
+    };
+
+    if (numChunks == 1) return {text.substr(arrayStart + 1)};
+
+    // Count the quotes before the start of each part
+    const size_t partSize = (text.size() - (arrayStart + 1)) / numChunks;
+    auto partStart = [&](size_t part) { return part == numChunks ? text.size() : arrayStart + 1 + part * partSize; };
+    vector<size_t> quotesBefore(numChunks + 1, 0);
+    quotesBefore[0] = count(text.begin(), text.begin() + partStart(0), '"');
+    pool.parallelFor(0, numChunks, 1, [&](unsigned int, size_t part) {
+        quotesBefore[part + 1] = count(text.begin() + partStart(part), text.begin() + partStart(part + 1), '"');
+    });
+    partial_sum(quotesBefore.begin(), quotesBefore.end(), quotesBefore.begin());
+
+    vector<string_view> chunks;
+    size_t chunkStart = arrayStart + 1;
+    for (unsigned int i = 1; i < numChunks; i++) {
+        // A split that passed the start of this part ended at the '{' of an object, just outside a string
+        const bool passedPart = chunkStart + 1 > partStart(i);
+        const size_t split = passedPart ? findObjectStart(chunkStart + 1, false)
+                                        : findObjectStart(partStart(i), quotesBefore[i] % 2 == 1);
+        if (split == string_view::npos) break;
+        chunks.push_back(text.substr(chunkStart, split - chunkStart));
+        chunkStart = split;
+    }
+    chunks.push_back(text.substr(chunkStart));
+    return chunks;
+}
+
+
+// -------------------------------------------- PRIVATE HELPER METHODS ---------------------------------------------- //
+
+void UserScanner::skipWhitespace() {
+    /*
+     *  Moves past any whitespace characters (spaces, tabs, newlines and carriage returns)
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    while (pos < end && (*pos == ' ' || *pos == '\t' || *pos == '\n' || *pos == '\r')) pos++;
+}
+
+void UserScanner::expect(char c) {
+    /*
+     *  Moves past the expected character. If the next non-whitespace character is not the expected one, the file is
+     *  reported as malformed.
+     *
+     *  Parameters:
+     *      char c:
+     *          The character that must come next
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    skipWhitespace();
+    if (pos >= end || *pos != c) {
+        char reason[] = "expected the character ' '";
+        reason[sizeof(reason) - 3] = c;
+        malformed(reason);
+    }
+    pos++;
+}
+
+string_view UserScanner::readString() {
+    /*
+     *  Reads a double quoted string and returns the characters between (but not including) the quotes.
+     *  Assumes that there are no escaped characters within the string.
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      string_view:
+     *          A view of the contents of the string within the scanned text
+     */
+
+    expect('"');
+    const char* closingQuote = static_cast<const char*>(memchr(pos, '"', end - pos));
+    if (closingQuote == nullptr) malformed("unterminated string");
+
+    string_view str(pos, closingQuote - pos);
+    pos = closingQuote + 1;
+    return str;
+}
+
+uint64_t UserScanner::readUnsignedInt() {
+    /*
+     *  Reads a 64-bit unsigned integer. The integer may be wrapped in double quotes (like "id_str" : "6") or not.
+     *
+     *  Parameters:
+     *      No parameters.
+     *
+     *  Returns:
+     *      uint64_t:
+     *          The value of the integer
+     */
+
+    skipWhitespace();
+    bool quoted = pos < end && *pos == '"';
+    if (quoted) pos++;
+
+    uint64_t value = 0;
+    from_chars_result result = from_chars(pos, end, value);
+    if (result.ec != errc()) malformed("expected an unsigned integer");
+    pos = result.ptr;
+
+    if (quoted) {
+        if (pos >= end || *pos != '"') malformed("expected the end of an unsigned integer string");
+        pos++;
+    }
+    return value;
+}
+
+void UserScanner::readUnsignedIntArray(vector<uint64_t>& ids) {
+    /*
+     *  Reads an array of 64-bit unsigned integers (such as ["1","2","3"]), adding each value to the end of ids.
+     *
+     *  Parameters:
+     *      vector<uint64_t>& ids:
+     *          The vector to add each value of the array to
+     *
+     *  Returns:
+     *      Returns nothing.
+     */
+
+    expect('[');
+    skipWhitespace();
+    if (pos < end && *pos == ']') {
+        pos++;
+        return;
+    }
+
+    while (true) {
+        ids.push_back(readUnsignedInt());
+        skipWhitespace();
+        if (pos < end && *pos == ',') {
+            pos++;
+            continue;
+        }
+        expect(']');
+        return;
+    }
+}
+
+void UserScanner::malformed(const char* reason) const {
+    /*
+     *  Reports that the file is not in the expected format and terminates the program.
+     *
+     *  Parameters:
+     *      const char* reason:
+     *          A short description of what was expected
+     *
+     *  Returns:
+     *      Does not return.
+     */
+
+    cerr << "MALFORMED USERS FILE - " << reason << " - AT BYTE " << (pos - begin) << endl;
+    exit(1);
+}
@@ -0,0 +1,88 @@
+/** *************************************************************
+ *  Declaration of the UserScanner class                        *
+ *  @author Brandon Dale                                        *
+ *                                                              *
+ *  A single-pass scanner over the text of a "special" JSON     *
+ *  users file. Each call to nextUser() extracts the fields of  *
+ *  the next user object as string_views into the original      *
+ *  text, so no intermediate strings or streams are created.    *
+ *                                                              *
+ *  @file UserScanner.h                                         *
+ *  @date October 14th, 2026                                    *
+ ***************************************************************/
+
+
+#ifndef CS315_PROJECT01_USERSCANNER_H
+#define CS315_PROJECT01_USERSCANNER_H
+
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "ThreadPool.h"
+
+
+// The fields of a single user object. The string_views point into the text being scanned. The id and follows are the
+// IDs as written in the file, which may be any 64-bit values (they are not required to be 1 to the number of users).
+struct UserFields {
+    uint64_t id = 0;
+    std::string_view name;
+    std::string_view location;
+    std::string_view pic_url;
+    std::vector<uint64_t> follows;
+};
+
+
+class UserScanner {
+public:
+    // ------------------------------------------------ Constructors ------------------------------------------------ //
+    // Creates a scanner over the full text of a JSON users file
+    explicit UserScanner(std::string_view text);
+
+    // Creates a scanner over one chunk of the users array of text (as split by splitUserArray)
+    UserScanner(std::string_view text, std::string_view chunk);
+
+
+    // ----------------------------------------------- Public Methods ----------------------------------------------- //
+    // Extracts the next user object into fields. Returns false once there are no users left.
+    bool nextUser(UserFields& fields);
+
+    // Returns the number of bytes of the text that have been scanned so far
+    std::size_t getBytesScanned() const;
+
+    // Splits the users array of text into at most numChunks chunks, each made of whole user objects, to be scanned on
+    // their own (and in parallel). The text is first read through once on the pool.
+    static std::vector<std::string_view> splitUserArray(std::string_view text, unsigned int numChunks,
+                                                        ThreadPool& pool);
+
+private:
+    // -------------------------------------------- Private Data Members -------------------------------------------- //
+    const char* begin;
+    const char* pos;
+    const char* end;
+    bool inUserArray;
+    bool finished;
+    bool isChunk;       // whether the scanner ends at the end of its chunk, rather than at the end of the users array
+
+    // -----------------------------------------  Private Helper Functions ------------------------------------------ //
+    // Moves past any whitespace characters
+    void skipWhitespace();
+
+    // Moves past the expected character, or reports a malformed file if it is not the next non-whitespace character
+    void expect(char c);
+
+    // Reads a double quoted string (without escapes) and returns the characters between the quotes
+    std::string_view readString();
+
+    // Reads a 64-bit unsigned integer, which may or may not be wrapped in double quotes
+    uint64_t readUnsignedInt();
+
+    // Reads an array of 64-bit unsigned integers into ids
+    void readUnsignedIntArray(std::vector<uint64_t>& ids);
+
+    // Reports that the file is not in the expected format and terminates the program
+    [[noreturn]] void malformed(const char* reason) const;
+};
+
+
+#endif //CS315_PROJECT01_USERSCANNER_H
@@ -0,0 +1,422 @@
+/** *************************************************
+ *  SSU - CS 315 - Project 01                       *
+ *  @author Brandon Dale                            *
+ *                                                  *
+ *  Microbenchmarks of each stage of the load and   *
+ *  render pipeline, on a generated network. Each   *
+ *  stage is run a number of times, and the fastest *
+ *  run is reported with its throughput, so that a  *
+ *  regression in any one stage is visible.         *
+ *                                                  *
+ * @file benchmark.cpp                              *
+ * @date October 14th, 2026                         *
+ ***************************************************/
+
+
+#include "NetworkGenerator.h"
+#include "SocialNetwork.h"
+#include "AdjacencyIndex.h"
+#include "CompressedIndex.h"
+#include "StringPool.h"
+#include "IdArena.h"
+#include "UserScanner.h"
+#include "PageBuffer.h"
+#include "User.h"
+#include "LinkTable.h"
+#include "SortedIntersection.h"
+#include "SuggestionFinder.h"
+#include "GraphAnalytics.h"
+#include "UserOrdering.h"
+#include "NetworkDelta.h"
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <random>
+#include <unordered_set>
+#include <dirent.h>
+#include <unistd.h>
+
+using namespace std;
+
+
+// Checks if a command-line argument is a positive integer that fits in an unsigned int
+static bool isPositiveInteger(const string& arg) {
+    if (arg.empty() || arg.size() > 9 || arg.find_first_not_of("0123456789") != string::npos) return false;
+    return stoul(arg) > 0;
+}
+
+// Runs a stage numRuns times, and returns the time of the fastest run in seconds
+static double timeStage(unsigned int numRuns, const function<void()>& stage) {
+    double fastest = 0;
+    for (unsigned int run = 0; run < numRuns; run++) {
+        auto start = chrono::steady_clock::now();
+        stage();
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        if (run == 0 || seconds < fastest) fastest = seconds;
+    }
+    return fastest;
+}
+
+// Prints the time and throughput of a stage, which processed numUsers users and numBytes bytes
+static void reportStage(const char* stage, double seconds, unsigned int numUsers, size_t numBytes) {
+    printf("%-18s %10.4f %14.0f %12.1f\n", stage, seconds, numUsers / seconds, numBytes / seconds / 1e6);
+}
+
+// Intersects the follows and followers rows of every user (with a plain merge, or with the kernel that intersect
+// picks for each user), and returns the total number of mutuals
+static size_t countMutuals(const AdjacencyIndex& followsIndex, const AdjacencyIndex& followersIndex, bool adaptive,
+                           vector<unsigned int>& intersection) {
+    size_t numMutuals = 0;
+    for (unsigned int i = 0; i < followsIndex.getNumVertices(); i++) {
+        const unsigned int* follows = followsIndex.rowBegin(i);
+        const unsigned int* followersOfUser = followersIndex.rowBegin(i);
+        const size_t numFollows = followsIndex.rowEnd(i) - follows;
+        const size_t numFollowers = followersIndex.rowEnd(i) - followersOfUser;
+        intersection.resize(min(numFollows, numFollowers));
+        numMutuals += adaptive
+            ? SortedIntersection::intersect(follows, numFollows, followersOfUser, numFollowers, intersection.data())
+            : SortedIntersection::merge(follows, numFollows, followersOfUser, numFollowers, intersection.data());
+    }
+    return numMutuals;
+}
+
+// Removes a directory and every file in it
+static void removeDirectory(const string& directoryName) {
+    DIR* directory = opendir(directoryName.c_str());
+    if (directory == nullptr) return;
+    while (dirent* entry = readdir(directory)) {
+        string filename = entry->d_name;
+        if (filename != "." && filename != "..") unlink((directoryName + "/" + filename).c_str());
+    }
+    closedir(directory);
+    rmdir(directoryName.c_str());
+}
+
+
+/** ****************************************************
+ *  MAIN DRIVER CODE - Handles reading in command-line *
+ *  arguments, generates a network, and then times     *
+ *  each stage of the pipeline on it.                  *
+ ******************************************************/
+int main(int argc, char* argv[]) {
+
+    // Validate and get the options from arguments
+    unsigned int numUsers = 100000;
+    unsigned int meanFollows = 20;
+    unsigned int seed = 1;
+    unsigned int numRuns = 3;
+    OutputOptions options;
+    NetworkGenerator::Distribution distribution = NetworkGenerator::Distribution::UNIFORM;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+
+        if (arg == "--users" || arg == "--follows" || arg == "--seed" || arg == "--runs" || arg == "--jobs") {
+            if (i + 1 >= argc || !isPositiveInteger(argv[i + 1])) {
+                cerr << "ERROR -- " << arg << " REQUIRES A POSITIVE NUMBER -- TERMINATING\n";
+                exit(1);
+            }
+            unsigned int value = stoul(argv[++i]);
+            if (arg == "--users") numUsers = value;
+            else if (arg == "--follows") meanFollows = value;
+            else if (arg == "--seed") seed = value;
+            else if (arg == "--runs") numRuns = value;
+            else options.numJobs = value;
+        }
+        else if (arg == "--distribution") {
+            if (i + 1 >= argc || !NetworkGenerator::parseDistribution(argv[i + 1], distribution)) {
+                cerr << "ERROR -- --distribution REQUIRES uniform OR power-law -- TERMINATING\n";
+                exit(1);
+            }
+            i++;
+        }
+        else {
+            cerr << "USAGE: benchmark [--users N] [--follows N] [--distribution uniform|power-law] [--seed N] "
+                    "[--runs N] [--jobs N]\n";
+            exit(1);
+        }
+    }
+
+    // Generate the network, and write it to a temporary directory that the pages are also written to
+    PageBuffer json;
+    NetworkGenerator(numUsers, meanFollows, distribution, seed).generateJSON(json);
+    char directoryTemplate[] = "/tmp/social_network_bench.XXXXXX";
+    if (mkdtemp(directoryTemplate) == nullptr) {
+        cerr << "ERROR -- COULD NOT CREATE A TEMPORARY DIRECTORY -- TERMINATING\n";
+        exit(1);
+    }
+    const string directory = directoryTemplate;
+    const string jsonFilename = directory + "/network.json";
+    if (!json.writeToFile(jsonFilename)) {
+        cerr << "ERROR -- COULD NOT WRITE " << jsonFilename << " -- TERMINATING\n";
+        exit(1);
+    }
+
+    printf("%u users, %u mean follows, %s, %.1f MB of JSON, best of %u runs\n", numUsers, meanFollows,
+           distribution == NetworkGenerator::Distribution::UNIFORM ? "uniform" : "power-law",
+           json.getSize() / 1e6, numRuns);
+    printf("intersect uses %s SIMD\n\n", SortedIntersection::getSimdName());
+    printf("%-18s %10s %14s %12s\n", "stage", "seconds", "users/s", "MB/s");
+
+    // ---------------- PARSE: scan the JSON into users ---------------- //
+    vector<User> users;
+    unique_ptr<StringPool> strings;
+    unique_ptr<IdArena> followsArena;
+    double seconds = timeStage(numRuns, [&]() {
+        users.clear();
+        strings = make_unique<StringPool>();
+        followsArena = make_unique<IdArena>();
+        UserScanner scanner(json.getContents());
+        UserFields fields;
+        while (scanner.nextUser(fields)) {
+            unsigned int* follows = followsArena->allocate(fields.follows.size());
+            copy(fields.follows.begin(), fields.follows.end(), follows);
+            users.emplace_back(fields.id, strings->store(fields.name), strings->intern(fields.location),
+                               strings->intern(fields.pic_url), IdSpan(follows, fields.follows.size()));
+        }
+    });
+    reportStage("parse", seconds, numUsers, json.getSize());
+    sort(users.begin(), users.end());
+
+    // ---------------- BUILD: create the follows and followers indices ---------------- //
+    size_t indexBytes = 0;
+    seconds = timeStage(numRuns, [&]() {
+        AdjacencyIndex followsIndex(users);
+        AdjacencyIndex followersIndex = followsIndex.transposed();
+        indexBytes = 2 * ((numUsers + 1) * sizeof(size_t) + followsIndex.getNumEdges() * sizeof(unsigned int));
+    });
+    reportStage("build", seconds, numUsers, indexBytes);
+
+    // ---------------- MERGE/INTERSECT: intersect the follows and followers rows of every user ---------------- //
+    // The mutuals of every user, found with a plain merge and with the kernel that intersect picks for each user
+    AdjacencyIndex followsIndex(users);
+    AdjacencyIndex followersIndex = followsIndex.transposed();
+    vector<unsigned int> intersection;
+    size_t numMutuals[2] = {0, 0};
+    for (int adaptive = 0; adaptive < 2; adaptive++) {
+        seconds = timeStage(numRuns, [&]() {
+            numMutuals[adaptive] = countMutuals(followsIndex, followersIndex, adaptive, intersection);
+        });
+        reportStage(adaptive ? "intersect" : "merge", seconds, numUsers, numMutuals[adaptive] * sizeof(unsigned int));
+    }
+    if (numMutuals[0] != numMutuals[1]) {
+        cerr << "ERROR -- intersect FOUND " << numMutuals[1] << " MUTUALS, BUT merge FOUND " << numMutuals[0]
+             << " -- TERMINATING\n";
+        exit(1);
+    }
+
+    // ---------------- FOLLOWERS: find the followers and mutuals of every user ---------------- //
+    SocialNetwork network(jsonFilename);
+    vector<unsigned int> followers;
+    vector<unsigned int> mutuals;
+    size_t relationBytes = 0;
+    seconds = timeStage(numRuns, [&]() {
+        relationBytes = 0;
+        for (unsigned int id = 1; id <= numUsers; id++) {
+            followers.clear();
+            mutuals.clear();
+            network.getFollowerAndMutualsFromId(followers, mutuals, id);
+            relationBytes += (followers.size() + mutuals.size()) * sizeof(unsigned int);
+        }
+    });
+    reportStage("followers", seconds, numUsers, relationBytes);
+
+    // ---------------- COMPRESS/DECODE: compress the indices, and read them compressed ---------------- //
+    // The followers and mutuals are found again from the compressed indices, and each lookup checks every edge of a
+    // user and the vertex after it, so each compressed stage can be compared with the same stage on the CSR arrays
+    CompressedIndex compressedFollows;
+    CompressedIndex compressedFollowers;
+    seconds = timeStage(numRuns, [&]() {
+        compressedFollows = CompressedIndex(followsIndex, options.numJobs);
+        compressedFollowers = CompressedIndex(followersIndex, options.numJobs);
+    });
+    reportStage("compress", seconds, numUsers, indexBytes);
+    const size_t compressedBytes = 2 * (numUsers + 1) * sizeof(size_t) + compressedFollows.getNumBytes() +
+                                   compressedFollowers.getNumBytes();
+    vector<unsigned int> row;
+    seconds = timeStage(numRuns, [&]() {
+        for (unsigned int i = 0; i < numUsers; i++) {
+            row.clear();
+            compressedFollows.decodeRow(i, row);
+            compressedFollowers.decodeRow(i, row);
+        }
+    });
+    reportStage("decode", seconds, numUsers, compressedBytes);
+
+    network.compressIndices(options.numJobs);
+    seconds = timeStage(numRuns, [&]() {
+        for (unsigned int id = 1; id <= numUsers; id++) {
+            followers.clear();
+            mutuals.clear();
+            network.getFollowerAndMutualsFromId(followers, mutuals, id);
+        }
+    });
+    reportStage("compressed:follow", seconds, numUsers, relationBytes);
+    network.decompressIndices(options.numJobs);
+
+    size_t numFound[2] = {0, 0};
+    for (int compressed = 0; compressed < 2; compressed++) {
+        auto hasEdge = [&](unsigned int from, unsigned int to) {
+            return compressed ? compressedFollows.hasEdge(from, to) : followsIndex.hasEdge(from, to);
+        };
+        seconds = timeStage(numRuns, [&]() {
+            numFound[compressed] = 0;
+            for (unsigned int i = 0; i < numUsers; i++) {
+                for (const unsigned int* it = followsIndex.rowBegin(i); it != followsIndex.rowEnd(i); it++) {
+                    numFound[compressed] += hasEdge(i, *it) + hasEdge(i, *it + 1 < numUsers ? *it + 1 : 0);
+                }
+            }
+        });
+        reportStage(compressed ? "compressed:lookup" : "lookup", seconds, numUsers,
+                    2 * followsIndex.getNumEdges() * sizeof(unsigned int));
+    }
+    if (numFound[0] != numFound[1]) {
+        cerr << "ERROR -- THE COMPRESSED INDEX FOUND " << numFound[1] << " EDGES, BUT THE INDEX FOUND " << numFound[0]
+             << " -- TERMINATING\n";
+        exit(1);
+    }
+
+    // ---------------- SUGGEST: find the friend of friend suggestions of every user ---------------- //
+    SuggestionFinder finder(followsIndex, 10);
+    vector<unsigned int> suggested;
+    size_t suggestionBytes = 0;
+    seconds = timeStage(numRuns, [&]() {
+        suggestionBytes = 0;
+        for (unsigned int i = 0; i < numUsers; i++) {
+            finder.findSuggestions(i, suggested);
+            suggestionBytes += suggested.size() * sizeof(unsigned int);
+        }
+    });
+    reportStage("suggest", seconds, numUsers, suggestionBytes);
+
+    // ---------------- PAGERANK/COMPONENTS: run the analytics of the network ---------------- //
+    // Each PageRank iteration reads the whole followers index, and the components read the follows index
+    GraphAnalytics analytics(followsIndex, followersIndex, options.numJobs);
+    const size_t rowBytes = (numUsers + 1) * sizeof(size_t) + followsIndex.getNumEdges() * sizeof(unsigned int);
+    seconds = timeStage(numRuns, [&]() {
+        analytics.pageRank();
+    });
+    reportStage("pagerank", seconds, numUsers, GraphAnalytics::DEFAULT_PAGERANK_ITERATIONS * rowBytes);
+    seconds = timeStage(numRuns, [&]() {
+        analytics.weakComponents();
+        analytics.strongComponents();
+    });
+    reportStage("components", seconds, numUsers, 2 * rowBytes);
+
+    // ---------------- REORDER: relabel the users for locality, and traverse the relabeled indices ---------------- //
+    // Each ordering is timed (finding it, and relabeling both indices), and then the stages above that traverse the
+    // indices are run again on the relabeled users, so the gain of each ordering can be compared with them
+    for (UserOrdering::Method ordering : {UserOrdering::BFS, UserOrdering::RCM, UserOrdering::DEGREE}) {
+        const string name = UserOrdering::getName(ordering);
+        AdjacencyIndex relabeledFollows;
+        AdjacencyIndex relabeledFollowers;
+        seconds = timeStage(numRuns, [&]() {
+            const vector<unsigned int> newIndices = UserOrdering::findNewIndices(ordering, followsIndex,
+                                                                                 followersIndex);
+            relabeledFollows = followsIndex.relabeled(newIndices);
+            relabeledFollowers = relabeledFollows.transposed();
+        });
+        reportStage((name + ":order").c_str(), seconds, numUsers, indexBytes);
+
+        size_t numRelabeledMutuals = 0;
+        seconds = timeStage(numRuns, [&]() {
+            numRelabeledMutuals = countMutuals(relabeledFollows, relabeledFollowers, true, intersection);
+        });
+        reportStage((name + ":intersect").c_str(), seconds, numUsers, numRelabeledMutuals * sizeof(unsigned int));
+
+        GraphAnalytics relabeledAnalytics(relabeledFollows, relabeledFollowers, options.numJobs);
+        seconds = timeStage(numRuns, [&]() {
+            relabeledAnalytics.pageRank();
+        });
+        reportStage((name + ":pagerank").c_str(), seconds, numUsers,
+                    GraphAnalytics::DEFAULT_PAGERANK_ITERATIONS * rowBytes);
+        seconds = timeStage(numRuns, [&]() {
+            relabeledAnalytics.weakComponents();
+            relabeledAnalytics.strongComponents();
+        });
+        reportStage((name + ":components").c_str(), seconds, numUsers, 2 * rowBytes);
+    }
+
+    // ---------------- RENDER: render every page into a buffer (without writing it) ---------------- //
+    // The link to every user is rendered once beforehand, as createAllHTMLFiles does
+    PageBuffer page;
+    NameTable names = network.getUserNames();
+    LinkTable links(names);
+    names.setLinks(links.getOffsets(), links.getData());
+    size_t pageBytes = 0;
+    seconds = timeStage(numRuns, [&]() {
+        pageBytes = 0;
+        for (unsigned int id = 1; id <= numUsers; id++) {
+            followers.clear();
+            mutuals.clear();
+            network.getFollowerAndMutualsFromId(followers, mutuals, id);
+            network.getUser(id).renderUserHTMLProfilePage(page, names, followers, mutuals);
+            pageBytes += page.getSize();
+        }
+    });
+    reportStage("render", seconds, numUsers, pageBytes);
+
+    // ---------------- WRITE: create every HTML file ---------------- //
+    char workingDirectory[4096];
+    if (getcwd(workingDirectory, sizeof(workingDirectory)) == nullptr || chdir(directory.c_str()) != 0) {
+        cerr << "ERROR -- COULD NOT CHANGE TO " << directory << " -- TERMINATING\n";
+        exit(1);
+    }
+    seconds = timeStage(numRuns, [&]() {
+        network.createAllHTMLFiles(options);
+    });
+    reportStage("write", seconds, numUsers, pageBytes);
+
+    if (chdir(workingDirectory) != 0) {
+        cerr << "ERROR -- COULD NOT CHANGE BACK TO " << workingDirectory << " -- TERMINATING\n";
+        exit(1);
+    }
+    removeDirectory(directory);
+
+    // ---------------- DELTA: apply batches of follow changes, spread out and to a single hub ---------------- //
+    // The spread batch follows random users (and unfollows them again on every other run), and the hub batch unfollows
+    // and follows again the follows of the user who follows the most, so every change of it rebuilds the same long
+    // list. The users/s column counts the changes of a batch.
+    network.decompressIndices(options.numJobs);
+    const unsigned int numChanges = min(10000u, numUsers);
+    NetworkDelta spreadDeltas[2];
+    unordered_set<uint64_t> spreadEdges;
+    mt19937 random(seed);
+    while (spreadEdges.size() < numChanges / 2) {
+        const unsigned int follower = random() % numUsers + 1;
+        const unsigned int followed = random() % numUsers + 1;
+        if (network.isFollowing(follower, followed)) continue;
+        if (!spreadEdges.insert(uint64_t(follower) << 32 | followed).second) continue;
+        spreadDeltas[0].follow(network.getExternalId(follower), network.getExternalId(followed));
+        spreadDeltas[1].unfollow(network.getExternalId(follower), network.getExternalId(followed));
+    }
+    unsigned int hub = 1;
+    for (unsigned int id = 2; id <= numUsers; id++) {
+        if (network.getUser(id).getFollowsSize() > network.getUser(hub).getFollowsSize()) hub = id;
+    }
+    NetworkDelta hubDelta;
+    const IdSpan hubFollows = network.getUser(hub).getFollows();
+    for (size_t i = 0; i < hubFollows.size() && 2 * i < numChanges; i++) {
+        hubDelta.unfollow(network.getExternalId(hub), network.getExternalId(hubFollows[i]));
+        hubDelta.follow(network.getExternalId(hub), network.getExternalId(hubFollows[i]));
+    }
+
+    vector<unsigned int> changedIDs;
+    string error;
+    unsigned int spreadRun = 0;
+    seconds = timeStage(numRuns, [&]() {
+        network.applyDelta(spreadDeltas[spreadRun++ % 2], changedIDs, error);
+    });
+    if (spreadRun % 2 == 1) network.applyDelta(spreadDeltas[1], changedIDs, error);
+    reportStage("delta:spread", seconds, spreadDeltas[0].getChanges().size(), 0);
+    seconds = timeStage(numRuns, [&]() {
+        network.applyDelta(hubDelta, changedIDs, error);
+    });
+    reportStage("delta:hub", seconds, hubDelta.getChanges().size(), 0);
+
+    return 0;
+}
@@ -0,0 +1,88 @@
+/** *************************************************
+ *  SSU - CS 315 - Project 01                       *
+ *  @author Brandon Dale                            *
+ *                                                  *
+ *  Driver code for the synthetic network           *
+ *  generator. Writes a generated network, in the   *
+ *  input format of project1, to a file.            *
+ *                                                  *
+ * @file generate_network.cpp                       *
+ * @date October 14th, 2026                         *
+ ***************************************************/
+
+
+#include "NetworkGenerator.h"
+#include "PageBuffer.h"
+#include <string>
+#include <iostream>
+
+using namespace std;
+
+
+// Checks if a command-line argument is a positive integer that fits in an unsigned int
+static bool isPositiveInteger(const string& arg) {
+    if (arg.empty() || arg.size() > 9 || arg.find_first_not_of("0123456789") != string::npos) return false;
+    return stoul(arg) > 0;
+}
+
+
+/** ****************************************************
+ *  MAIN DRIVER CODE - Handles reading in command-line *
+ *  arguments and then writes the generated network.   *
+ ******************************************************/
+int main(int argc, char* argv[]) {
+
+    // Validate and get the output filename and options from arguments
+    string output_filename;
+    unsigned int numUsers = 10000;
+    unsigned int meanFollows = 20;
+    unsigned int seed = 1;
+    NetworkGenerator::Distribution distribution = NetworkGenerator::Distribution::UNIFORM;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+
+        if (arg == "--users" || arg == "--follows" || arg == "--seed") {
+            if (i + 1 >= argc || !isPositiveInteger(argv[i + 1])) {
+                cerr << "ERROR -- " << arg << " REQUIRES A POSITIVE NUMBER -- TERMINATING\n";
+                exit(1);
+            }
+            unsigned int value = stoul(argv[++i]);
+            if (arg == "--users") numUsers = value;
+            else if (arg == "--follows") meanFollows = value;
+            else seed = value;
+        }
+        else if (arg == "--distribution") {
+            if (i + 1 >= argc || !NetworkGenerator::parseDistribution(argv[i + 1], distribution)) {
+                cerr << "ERROR -- --distribution REQUIRES uniform OR power-law -- TERMINATING\n";
+                exit(1);
+            }
+            i++;
+        }
+        else if (arg.rfind("--", 0) == 0) {
+            cerr << "ERROR -- UNKNOWN OPTION " << arg << " -- TERMINATING\n";
+            exit(1);
+        }
+        else if (output_filename.empty()) {
+            output_filename = arg;
+        }
+        else {
+            cerr << "ERROR -- INVALID NUMBER OF ARGUMENTS PROVIDED -- TERMINATING\n";
+            exit(1);
+        }
+    }
+    if (output_filename.empty()) {
+        cerr << "USAGE: generate_network <output_filename> [--users N] [--follows N] "
+                "[--distribution uniform|power-law] [--seed N]\n";
+        exit(1);
+    }
+
+    // Generate the network and write it with a single write
+    PageBuffer json;
+    NetworkGenerator(numUsers, meanFollows, distribution, seed).generateJSON(json);
+    if (!json.writeToFile(output_filename)) {
+        cerr << "ERROR -- COULD NOT WRITE " << output_filename << " -- TERMINATING\n";
+        exit(1);
+    }
+
+    return 0;
+}
@@ -12,13 +12,43 @@
 
 
 #include "SocialNetwork.h"
+#include "StreamingGenerator.h"
+#include "NetworkSnapshot.h"
+#include "OutputLayout.h"
+#include "Stats.h"
+#include "Profiler.h"
+#include "QueryServer.h"
+#include "NetworkDelta.h"
 #include <string>
+#include <vector>
 #include <cassert>
 #include <iostream>
 
 using namespace std;
 
 
+// Checks if a command-line argument is a positive integer that fits in an unsigned int
+static bool isPositiveInteger(const string& arg) {
+    if (arg.empty() || arg.size() > 9 || arg.find_first_not_of("0123456789") != string::npos) return false;
+    return stoul(arg) > 0;
+}
+
+// Prints the stats of the run to stderr (as a table, or as JSON), if they were asked for, and the report of the
+// profiler (writing its trace to traceFilename), if the run is profiled
+static void printStats(Stats::ScopedTimer& totalTimer, bool json, const string& traceFilename) {
+    if (!Stats::isEnabled()) return;
+    totalTimer.stop();
+    if (json) Stats::printJSON(cerr);
+    else Stats::printTable(cerr);
+    if (!Profiler::isEnabled()) return;
+    Profiler::printReport(cerr);
+    if (!Profiler::writeTrace(traceFilename)) {
+        cerr << "ERROR -- COULD NOT WRITE THE TRACE " << traceFilename << " -- TERMINATING\n";
+        exit(1);
+    }
+}
+
+
 /** ****************************************************
  *  MAIN DRIVER CODE - Handles reading in command-line *
  *  arguments and then uses the Social Network class   *
@@ -26,19 +56,325 @@ using namespace std;
  ******************************************************/
 int main(int argc, char* argv[]) {
 
-    // Validate and get filename from arguments
-    if (argc < 2) {
+    // Validate and get the filename and options from arguments
+    string input_filename;
+    string snapshot_filename;
+    OutputOptions options;
+    bool statsAsJSON = false;
+    bool serve = false;
+    bool compressIndex = false;
+    bool onlyCompressed = false;
+    string analytics_filename;
+    string trace_filename;
+    size_t numSlowestPages = Profiler::DEFAULT_SLOWEST_PAGES;
+    vector<string> deltaFilenames;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+
+        if (arg == "--jobs") {
+            // The number of threads to create the HTML files with, must be a positive integer
+            if (i + 1 >= argc || !isPositiveInteger(argv[i + 1])) {
+                cerr << "ERROR -- --jobs REQUIRES A POSITIVE NUMBER OF THREADS -- TERMINATING\n";
+                exit(1);
+            }
+            options.numJobs = stoul(argv[++i]);
+        }
+        else if (arg == "--save-snapshot") {
+            // Save a binary snapshot of the network instead of creating the HTML files
+            if (i + 1 >= argc) {
+                cerr << "ERROR -- --save-snapshot REQUIRES A FILENAME -- TERMINATING\n";
+                exit(1);
+            }
+            snapshot_filename = argv[++i];
+        }
+        else if (arg == "--memory-budget") {
+            // Stream the network through shard files on disk, using at most this many MB of memory
+            if (i + 1 >= argc || !isPositiveInteger(argv[i + 1])) {
+                cerr << "ERROR -- --memory-budget REQUIRES A POSITIVE NUMBER OF MB -- TERMINATING\n";
+                exit(1);
+            }
+            options.memoryBudget = stoul(argv[++i]) * size_t(1024 * 1024);
+        }
+        else if (arg == "--incremental") {
+            options.incremental = true;
+        }
+        else if (arg == "--shard-dirs") {
+            // Spread the user pages over this many levels of directories under users/
+            if (i + 1 >= argc || !isPositiveInteger(argv[i + 1]) ||
+                stoul(argv[i + 1]) > OutputLayout::MAX_SHARD_LEVELS) {
+                cerr << "ERROR -- --shard-dirs REQUIRES A NUMBER OF LEVELS FROM 1 TO " << OutputLayout::MAX_SHARD_LEVELS
+                     << " -- TERMINATING\n";
+                exit(1);
+            }
+            options.shardLevels = stoul(argv[++i]);
+        }
+        else if (arg == "--page-size") {
+            // Split the index, and the long lists of the user pages, over pages of at most this many users
+            if (i + 1 >= argc || !isPositiveInteger(argv[i + 1])) {
+                cerr << "ERROR -- --page-size REQUIRES A POSITIVE NUMBER OF USERS -- TERMINATING\n";
+                exit(1);
+            }
+            options.pageSize = stoul(argv[++i]);
+        }
+        else if (arg == "--suggestions") {
+            // List up to this many friend of friend suggestions on each user page
+            if (i + 1 >= argc || !isPositiveInteger(argv[i + 1])) {
+                cerr << "ERROR -- --suggestions REQUIRES A POSITIVE NUMBER OF USERS -- TERMINATING\n";
+                exit(1);
+            }
+            options.numSuggestions = stoul(argv[++i]);
+        }
+        else if (arg == "--analytics") {
+            // Write the PageRank, components and degrees of every user to a CSV file instead of creating the HTML files
+            if (i + 1 >= argc) {
+                cerr << "ERROR -- --analytics REQUIRES A FILENAME -- TERMINATING\n";
+                exit(1);
+            }
+            analytics_filename = argv[++i];
+        }
+        else if (arg == "--rank-index") {
+            options.rankIndex = true;
+        }
+        else if (arg == "--pagerank-iterations") {
+            // The number of PageRank iterations of --analytics and --rank-index
+            if (i + 1 >= argc || !isPositiveInteger(argv[i + 1])) {
+                cerr << "ERROR -- --pagerank-iterations REQUIRES A POSITIVE NUMBER OF ITERATIONS -- TERMINATING\n";
+                exit(1);
+            }
+            options.pageRankIterations = stoul(argv[++i]);
+        }
+        else if (arg == "--reorder") {
+            // Relabel the users for locality while the analytics of --analytics and --rank-index run
+            if (i + 1 >= argc || !UserOrdering::parse(argv[i + 1], options.userOrdering)) {
+                cerr << "ERROR -- --reorder REQUIRES AN ORDER OF id, bfs, rcm OR degree -- TERMINATING\n";
+                exit(1);
+            }
+            i++;
+        }
+        else if (arg == "--archive") {
+            // Write every page into a single tar archive instead of creating a file for each page
+            if (i + 1 >= argc) {
+                cerr << "ERROR -- --archive REQUIRES A FILENAME -- TERMINATING\n";
+                exit(1);
+            }
+            options.archiveFilename = argv[++i];
+        }
+        else if (arg == "--write-queue") {
+            // Write the user pages on a thread of their own, with up to this many batches of pages waiting for it
+            if (i + 1 >= argc || !isPositiveInteger(argv[i + 1])) {
+                cerr << "ERROR -- --write-queue REQUIRES A POSITIVE NUMBER OF BATCHES -- TERMINATING\n";
+                exit(1);
+            }
+            options.writeQueueBatches = stoul(argv[++i]);
+        }
+        else if (arg == "--compress-pages") {
+            // Also write every page compressed (page.html.gz, page.html.br), for a server to send as it is
+            unsigned int formats = 0;
+            if (i + 1 >= argc || !PageCompressor::parse(argv[i + 1], formats)) {
+                cerr << "ERROR -- --compress-pages REQUIRES gzip, br OR gzip,br -- TERMINATING\n";
+                exit(1);
+            }
+            options.pageFormats |= formats;
+            i++;
+        }
+        else if (arg == "--only-compressed") {
+            // Write only the compressed pages of --compress-pages
+            onlyCompressed = true;
+        }
+        else if (arg == "--apply-deltas") {
+            // Apply the changes in a delta file to the network after loading it (can be given more than once)
+            if (i + 1 >= argc) {
+                cerr << "ERROR -- --apply-deltas REQUIRES A FILENAME -- TERMINATING\n";
+                exit(1);
+            }
+            deltaFilenames.push_back(argv[++i]);
+        }
+        else if (arg == "--compress-index") {
+            // Keep the follows and followers indices compressed in memory (and in a saved snapshot)
+            compressIndex = true;
+        }
+        else if (arg == "--serve") {
+            // Answer queries read from stdin instead of creating the HTML files
+            serve = true;
+        }
+        else if (arg == "--profile") {
+            // Profile the run, writing a trace of its stages to a file (see Profiler)
+            if (i + 1 >= argc) {
+                cerr << "ERROR -- --profile REQUIRES A FILENAME -- TERMINATING\n";
+                exit(1);
+            }
+            trace_filename = argv[++i];
+        }
+        else if (arg == "--profile-pages") {
+            // The number of the slowest user pages that a profiled run reports
+            if (i + 1 >= argc || !isPositiveInteger(argv[i + 1])) {
+                cerr << "ERROR -- --profile-pages REQUIRES A POSITIVE NUMBER OF PAGES -- TERMINATING\n";
+                exit(1);
+            }
+            numSlowestPages = stoul(argv[++i]);
+        }
+        else if (arg == "--stats" || arg == "--stats=json") {
+            // Print the time of each stage and the counters of the run to stderr
+            Stats::enable();
+            statsAsJSON = (arg == "--stats=json");
+        }
+        else if (arg.rfind("--", 0) == 0) {
+            cerr << "ERROR -- UNKNOWN OPTION " << arg << " -- TERMINATING\n";
+            exit(1);
+        }
+        else if (input_filename.empty()) {
+            input_filename = arg;
+        }
+        else {
+            cerr << "ERROR -- INVALID NUMBER OF ARGUMENTS PROVIDED -- TERMINATING\n";
+            exit(1);
+        }
+    }
+    if (input_filename.empty()) {
        cerr << "ERROR -- INVALID NUMBER OF ARGUMENTS PROVIDED -- TERMINATING\n";
        exit(1);
     }
-    string input_filename = argv[1];
+
+    // An archive holds every page, so it can not be updated in place, and a snapshot does not create any pages
+    if (!options.archiveFilename.empty() && (options.incremental || !snapshot_filename.empty())) {
+        cerr << "ERROR -- --archive CAN NOT BE USED WITH --incremental OR --save-snapshot -- TERMINATING\n";
+        exit(1);
+    }
+
+    // The suggestions of a user change when any user two steps away does, which the incremental state does not track,
+    // and a shard of the streaming mode does not hold the follows of the users two steps away
+    if (options.numSuggestions > 0 && (options.incremental || options.memoryBudget > 0)) {
+        cerr << "ERROR -- --suggestions CAN NOT BE USED WITH --incremental OR --memory-budget -- TERMINATING\n";
+        exit(1);
+    }
+
+    // The PageRank of every user changes with any follow, which the incremental state does not track, and ranking the
+    // users needs the whole network in memory
+    if (options.rankIndex && (options.incremental || options.memoryBudget > 0)) {
+        cerr << "ERROR -- --rank-index CAN NOT BE USED WITH --incremental OR --memory-budget -- TERMINATING\n";
+        exit(1);
+    }
+
+    // The analytics need the whole network in memory, and are written instead of any other output
+    if (!analytics_filename.empty() && (options.memoryBudget > 0 || options.incremental || serve ||
+                                        !snapshot_filename.empty() || !options.archiveFilename.empty())) {
+        cerr << "ERROR -- --analytics CAN NOT BE USED WITH --memory-budget, --incremental, --serve, --save-snapshot OR"
+                " --archive -- TERMINATING\n";
+        exit(1);
+    }
+
+    // The order of the users only matters to the analytics
+    if (options.userOrdering != UserOrdering::ID && analytics_filename.empty() && !options.rankIndex) {
+        cerr << "ERROR -- --reorder CAN ONLY BE USED WITH --analytics OR --rank-index -- TERMINATING\n";
+        exit(1);
+    }
+
+    // A server answers queries on the network in memory, so it creates no files at all
+    if (serve && (options.memoryBudget > 0 || options.incremental || !snapshot_filename.empty() ||
+                  !options.archiveFilename.empty())) {
+        cerr << "ERROR -- --serve CAN NOT BE USED WITH --memory-budget, --incremental, --save-snapshot OR --archive"
+                " -- TERMINATING\n";
+        exit(1);
+    }
+
+    // The analytics, the suggestions and the incremental state traverse the uncompressed indices, and the streaming
+    // mode has no indices of the whole network
+    if (compressIndex && (options.memoryBudget > 0 || options.incremental || !analytics_filename.empty() ||
+                          options.rankIndex || options.numSuggestions > 0)) {
+        cerr << "ERROR -- --compress-index CAN NOT BE USED WITH --memory-budget, --incremental, --analytics,"
+                " --rank-index OR --suggestions -- TERMINATING\n";
+        exit(1);
+    }
+
+    // The incremental state only knows of the plain pages, so it could not tell that a compressed page is out of date
+    if (options.pageFormats != PageCompressor::PLAIN && options.incremental) {
+        cerr << "ERROR -- --compress-pages CAN NOT BE USED WITH --incremental -- TERMINATING\n";
+        exit(1);
+    }
+    if (onlyCompressed) {
+        if (options.pageFormats == PageCompressor::PLAIN) {
+            cerr << "ERROR -- --only-compressed REQUIRES --compress-pages -- TERMINATING\n";
+            exit(1);
+        }
+        options.pageFormats &= ~static_cast<unsigned int>(PageCompressor::PLAIN);
+    }
+
+    // The profiler is started before the total timer, so the trace covers the whole run
+    if (!trace_filename.empty()) Profiler::enable(numSlowestPages);
+
+    Stats::ScopedTimer totalTimer(Stats::TOTAL);
+
+    // A network that does not fit in memory is streamed through shard files, one shard at a time
+    if (options.memoryBudget > 0) {
+        if (options.incremental || !snapshot_filename.empty() || !deltaFilenames.empty() ||
+            NetworkSnapshot::isSnapshotFile(input_filename)) {
+            cerr << "ERROR -- --memory-budget CAN NOT BE USED WITH --incremental, --save-snapshot, --apply-deltas OR A"
+                    " SNAPSHOT -- TERMINATING\n";
+            exit(1);
+        }
+        StreamingGenerator generator(input_filename, options);
+        generator.createAllHTMLFiles();
+        printStats(totalTimer, statsAsJSON, trace_filename);
+        return 0;
+    }
 
     // Create the social network
-    SocialNetwork sn(input_filename);
+    SocialNetwork sn(input_filename, options.numJobs);
 
-    // Create all HTML Files for the network
-    sn.createAllHTMLFiles();
+    // A snapshot can hold compressed indices, which are kept compressed unless something needs the CSR arrays (the
+    // deltas patch them, so the indices are compressed again afterwards if asked to)
+    if (!deltaFilenames.empty() || !analytics_filename.empty() || options.incremental || options.rankIndex ||
+        options.numSuggestions > 0) {
+        sn.decompressIndices(options.numJobs);
+    }
+
+    // Apply the delta files in order, as a single batch, so the indices are only copied once. The pages that they
+    // change are re-created by --incremental (along with any others that its state shows changed).
+    vector<unsigned int> changedIDs;
+    if (!deltaFilenames.empty()) {
+        NetworkDelta delta;
+        string error;
+        for (const string& deltaFilename : deltaFilenames) {
+            if (!delta.load(deltaFilename, error)) {
+                cerr << "ERROR -- COULD NOT APPLY " << deltaFilename << ": " << error << " -- TERMINATING\n";
+                exit(1);
+            }
+        }
+        if (!sn.applyDelta(delta, changedIDs, error)) {
+            cerr << "ERROR -- COULD NOT APPLY THE DELTA FILES: " << error << " -- TERMINATING\n";
+            exit(1);
+        }
+    }
+    if (compressIndex) sn.compressIndices(options.numJobs);
+
+    // Either answer queries on the network, save a snapshot of it, write its analytics, or create all HTML Files for
+    // the network
+    if (serve) {
+        printStats(totalTimer, statsAsJSON, trace_filename);
+        if (!QueryServer(sn).serve(0, 1)) {
+            cerr << "ERROR -- COULD NOT WRITE THE ANSWERS TO THE QUERIES -- TERMINATING\n";
+            exit(1);
+        }
+        return 0;
+    }
+    if (!snapshot_filename.empty()) {
+        if (!sn.saveSnapshot(snapshot_filename)) {
+            cerr << "ERROR -- COULD NOT SAVE THE SNAPSHOT " << snapshot_filename << " -- TERMINATING\n";
+            exit(1);
+        }
+        printStats(totalTimer, statsAsJSON, trace_filename);
+        return 0;
+    }
+    if (!analytics_filename.empty()) {
+        if (!sn.writeAnalytics(analytics_filename, options.pageRankIterations, options.numJobs, options.userOrdering)) {
+            cerr << "ERROR -- COULD NOT WRITE THE ANALYTICS " << analytics_filename << " -- TERMINATING\n";
+            exit(1);
+        }
+        printStats(totalTimer, statsAsJSON, trace_filename);
+        return 0;
+    }
+    sn.createAllHTMLFiles(options, changedIDs);
+    printStats(totalTimer, statsAsJSON, trace_filename);
 
     return 0;
 }
-